@@ -54,20 +54,18 @@ extern "C"
 
 /*
  * "alt_alarm_s" is a structure type used to maintain lists of alarm callback
- * functions.
+ * functions. The list is kept sorted by "time", earliest first.
  */
 
 struct alt_alarm_s
 {
   alt_llist llist;       /* linked list */
-  alt_u32 time;          /* time in system ticks of the callback */
+  alt_u64 time;          /* time of the callback, in alt_nticks64() ticks */
   alt_u32 (*callback) (void* context); /* callback function. The return 
                           * value is the period for the next callback; where 
                           * zero indicates that the alarm should be removed 
                           * from the list. 
                           */
-  alt_u8 rollover;       /* set when desired alarm time + current time causes
-                            overflow, to prevent premature alarm */
   void* context;         /* Argument for the callback */
 };
 
@@ -84,16 +82,22 @@ extern alt_u32 _alt_tick_rate;
 
 /*
  * "_alt_nticks" is a global variable which records the elapsed number of 
- * system clock ticks since the last call to settimeofday() or since reset if
- * settimeofday() has not been called.
+ * system clock ticks since reset. It is 64 bits wide, so that it never wraps.
  */
 
-extern volatile alt_u32 _alt_nticks;
+extern volatile alt_u64 _alt_nticks;
 
 /* The list of registered alarms. */
 
 extern alt_llist alt_alarm_list;
 
+/*
+ * alt_alarm_insert() links "alarm" into alt_alarm_list after every alarm due
+ * at the same time or earlier. It is called with interrupts disabled.
+ */
+
+extern void alt_alarm_insert (struct alt_alarm_s* alarm);
+
 #ifdef __cplusplus
 }
 #endif
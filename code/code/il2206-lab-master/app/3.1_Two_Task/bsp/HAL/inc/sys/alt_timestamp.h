@@ -53,6 +53,16 @@ extern alt_timestamp_type alt_timestamp (void);
 
 extern alt_u32 alt_timestamp_freq (void);
 
+/*
+ * alt_timestamp64() returns the timestamp count since alt_timestamp_start()
+ * in 64 bits, and alt_timestamp_ns() the same in nanoseconds. Neither wraps
+ * when the timer has its interrupt connected, or is a 64-bit timer.
+ */
+
+extern alt_u64 alt_timestamp64 (void);
+
+extern alt_u64 alt_timestamp_ns (void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -87,7 +87,7 @@ INT16U  const  OSQSize             = sizeof(OS_Q);              /* Size in bytes
 INT16U  const  OSQSize             = 0;
 #endif
 
-INT16U  const  OSRdyTblSize        = OS_RDY_TBL_SIZE;           /* Number of bytes in the ready table  */
+INT16U  const  OSRdyTblSize        = sizeof(OSRdyTbl);          /* Number of bytes in the ready table  */
 
 INT16U  const  OSSemEn             = OS_SEM_EN;
 
@@ -114,15 +114,16 @@ INT16U  const  OSVersionNbr        = OS_VERSION;
 INT16U  const  OSTmrEn             = OS_TMR_EN;
 INT16U  const  OSTmrCfgMax         = OS_TMR_CFG_MAX;
 INT16U  const  OSTmrCfgNameSize    = OS_TMR_CFG_NAME_SIZE;
-INT16U  const  OSTmrCfgWheelSize   = OS_TMR_CFG_WHEEL_SIZE;
 INT16U  const  OSTmrCfgTicksPerSec = OS_TMR_CFG_TICKS_PER_SEC;
 
 #if (OS_TMR_EN > 0) && (OS_TMR_CFG_MAX > 0)
+INT16U  const  OSTmrCfgWheelSize   = OS_TMR_WHEEL_TBL_SIZE;     /* Spokes of all the wheel levels      */
 INT16U  const  OSTmrSize           = sizeof(OS_TMR);
 INT16U  const  OSTmrTblSize        = sizeof(OSTmrTbl);
 INT16U  const  OSTmrWheelSize      = sizeof(OS_TMR_WHEEL);
 INT16U  const  OSTmrWheelTblSize   = sizeof(OSTmrWheelTbl);
 #else
+INT16U  const  OSTmrCfgWheelSize   = 0;
 INT16U  const  OSTmrSize           = 0;
 INT16U  const  OSTmrTblSize        = 0;
 INT16U  const  OSTmrWheelSize      = 0;
@@ -59,8 +59,19 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     OS_TCB    *ptcb;
     INT8U      y_new;
     INT8U      x_new;
+#if OS_RR_EN > 0
+    BOOLEAN    rdy;
+#else
     INT8U      y_old;
-#if OS_LOWEST_PRIO <= 63
+#endif
+#if OS_SCHED_BITMAP_EN > 0
+    INT8U      bity_new;
+    INT32U     bitx_new;
+#if OS_RR_EN == 0
+    INT8U      bity_old;
+    INT32U     bitx_old;
+#endif
+#elif OS_LOWEST_PRIO <= 63
     INT8U      bity_new;
     INT8U      bitx_new;
     INT8U      bity_old;
@@ -96,6 +107,11 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
         oldprio = OSTCBCur->OSTCBPrio;                      /* Yes, get priority                       */
     }
     ptcb = OSTCBPrioTbl[oldprio];
+#if OS_RR_EN > 0
+    if ((OSRunning == OS_TRUE) && (oldprio == OSTCBCur->OSTCBPrio)) {
+        ptcb = OSTCBCur;                                    /* Shared priority: means the caller          */
+    }
+#endif
     if (ptcb == (OS_TCB *)0) {                              /* Does task to change exist?              */
         OS_EXIT_CRITICAL();                                 /* No, can't change its priority!          */
         return (OS_ERR_PRIO);
@@ -104,7 +120,12 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
         OS_EXIT_CRITICAL();                                 /* No, can't change its priority!          */
         return (OS_ERR_TASK_NOT_EXIST);
     }
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    y_new                 = (INT8U)(newprio >> 5);          /* Yes, compute new TCB fields             */
+    x_new                 = (INT8U)(newprio & 0x1F);
+    bity_new              = (INT8U)(1 << y_new);
+    bitx_new              = (INT32U)1 << x_new;
+#elif OS_LOWEST_PRIO <= 63
     y_new                 = (INT8U)(newprio >> 3);          /* Yes, compute new TCB fields             */
     x_new                 = (INT8U)(newprio & 0x07);
     bity_new              = (INT8U)(1 << y_new);
@@ -116,11 +137,64 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     bitx_new              = (INT16U)(1 << x_new);
 #endif
 
+#if OS_RR_EN > 0
+    rdy = (BOOLEAN)(ptcb->OSTCBRdyNext != (OS_TCB *)0);
+    OS_RdyListRemove(ptcb);                                 /* If task is ready make it not            */
+#if (OS_EVENT_EN)
+    pevent = ptcb->OSTCBEventPtr;
+    if (pevent != (OS_EVENT *)0) {
+        OS_EventTaskRemove(ptcb, pevent);                   /* Remove old task prio from wait list     */
+    }
+#if (OS_EVENT_MULTI_EN > 0)
+    if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {
+        OS_EventTaskRemoveMulti(ptcb, ptcb->OSTCBEventMultiPtr);
+    }
+#endif
+#endif
+    OS_PrioLeave(ptcb);                                     /* Remove TCB from old priority            */
+
+    ptcb->OSTCBPrio = newprio;                              /* Set new task priority                   */
+    ptcb->OSTCBY    = y_new;
+    ptcb->OSTCBX    = x_new;
+    ptcb->OSTCBBitY = bity_new;
+    ptcb->OSTCBBitX = bitx_new;
+    OS_PrioJoin(ptcb);                                      /* Place pointer to TCB @ new priority     */
+    if (rdy == OS_TRUE) {
+        OS_RdyListInsert(ptcb);                             /* Make new priority ready to run          */
+    }
+#if (OS_EVENT_EN)
+    if (pevent != (OS_EVENT *)0) {
+        pevent->OSEventGrp        |= bity_new;              /* Add    new task prio to   wait list     */
+        pevent->OSEventTbl[y_new] |= bitx_new;
+    }
+#if (OS_EVENT_MULTI_EN > 0)
+    if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {
+        pevents =  ptcb->OSTCBEventMultiPtr;
+        pevent  = *pevents;
+        while (pevent != (OS_EVENT *)0) {
+            pevent->OSEventGrp        |= bity_new;          /* Add    new task prio to   wait lists    */
+            pevent->OSEventTbl[y_new] |= bitx_new;
+            pevents++;
+            pevent                     = *pevents;
+        }
+    }
+#endif
+#endif
+#else
     OSTCBPrioTbl[oldprio] = (OS_TCB *)0;                    /* Remove TCB from old priority            */
     OSTCBPrioTbl[newprio] =  ptcb;                          /* Place pointer to TCB @ new priority     */
     y_old                 =  ptcb->OSTCBY;
     bity_old              =  ptcb->OSTCBBitY;
     bitx_old              =  ptcb->OSTCBBitX;
+#if OS_PREEMPT_THRESH_EN > 0
+    OSPreemptTbl[y_old]  &= ~bitx_old;                      /* Forget that it was preempted            */
+    if (OSPreemptTbl[y_old] == 0) {
+        OSPreemptGrp     &= ~bity_old;
+    }
+    if (ptcb->OSTCBThresh > newprio) {                      /* Threshold can't be below the task       */
+        ptcb->OSTCBThresh = newprio;
+    }
+#endif
     if ((OSRdyTbl[y_old] &   bitx_old) != 0) {              /* If task is ready make it not            */
          OSRdyTbl[y_old] &= ~bitx_old;
          if (OSRdyTbl[y_old] == 0) {
@@ -163,6 +237,7 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     ptcb->OSTCBX    = x_new;
     ptcb->OSTCBBitY = bity_new;
     ptcb->OSTCBBitX = bitx_new;
+#endif
     OS_EXIT_CRITICAL();
     if (OSRunning == OS_TRUE) {
         OS_Sched();                                         /* Find new highest priority task          */
@@ -232,9 +307,17 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_CREATE_ISR);
     }
+#if OS_RR_EN > 0
+    if ((OSTCBPrioTbl[prio] != OS_TCB_RESERVED) &&  /* Free, or shared with the tasks created there */
+        ((prio != OS_TASK_IDLE_PRIO) || (OSTCBPrioTbl[prio] == (OS_TCB *)0))) {
+        if (OSTCBPrioTbl[prio] == (OS_TCB *)0) {
+            OSTCBPrioTbl[prio] = OS_TCB_RESERVED;   /* Reserve a free priority until task is created  */
+        }
+#else
     if (OSTCBPrioTbl[prio] == (OS_TCB *)0) { /* Make sure task doesn't already exist at this priority  */
         OSTCBPrioTbl[prio] = OS_TCB_RESERVED;/* Reserve the priority to prevent others from doing ...  */
                                              /* ... the same thing until task is created.              */
+#endif
         OS_EXIT_CRITICAL();
         psp = OSTaskStkInit(task, p_arg, ptos, 0);              /* Initialize the task's stack         */
         err = OS_TCBInit(prio, psp, (OS_STK *)0, 0, 0, (void *)0, 0);
@@ -244,7 +327,13 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
             }
         } else {
             OS_ENTER_CRITICAL();
+#if OS_RR_EN > 0
+            if (OSTCBPrioTbl[prio] == OS_TCB_RESERVED) {
+                OSTCBPrioTbl[prio] = (OS_TCB *)0;   /* Make this priority available to others         */
+            }
+#else
             OSTCBPrioTbl[prio] = (OS_TCB *)0;/* Make this priority available to others                 */
+#endif
             OS_EXIT_CRITICAL();
         }
         return (err);
@@ -353,9 +442,17 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_CREATE_ISR);
     }
+#if OS_RR_EN > 0
+    if ((OSTCBPrioTbl[prio] != OS_TCB_RESERVED) &&  /* Free, or shared with the tasks created there */
+        ((prio != OS_TASK_IDLE_PRIO) || (OSTCBPrioTbl[prio] == (OS_TCB *)0))) {
+        if (OSTCBPrioTbl[prio] == (OS_TCB *)0) {
+            OSTCBPrioTbl[prio] = OS_TCB_RESERVED;   /* Reserve a free priority until task is created  */
+        }
+#else
     if (OSTCBPrioTbl[prio] == (OS_TCB *)0) { /* Make sure task doesn't already exist at this priority  */
         OSTCBPrioTbl[prio] = OS_TCB_RESERVED;/* Reserve the priority to prevent others from doing ...  */
                                              /* ... the same thing until task is created.              */
+#endif
         OS_EXIT_CRITICAL();
 
 #if (OS_TASK_STAT_STK_CHK_EN > 0)
@@ -370,7 +467,13 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
             }
         } else {
             OS_ENTER_CRITICAL();
+#if OS_RR_EN > 0
+            if (OSTCBPrioTbl[prio] == OS_TCB_RESERVED) {
+                OSTCBPrioTbl[prio] = (OS_TCB *)0;              /* Make this priority avail. to others  */
+            }
+#else
             OSTCBPrioTbl[prio] = (OS_TCB *)0;                  /* Make this priority avail. to others  */
+#endif
             OS_EXIT_CRITICAL();
         }
         return (err);
@@ -379,6 +482,269 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
     return (OS_ERR_PRIO_EXIST);
 }
 #endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     CREATE AN EDF (DEADLINE) TASK
+*
+* Description: This function creates a periodic task scheduled by earliest deadline first.  It takes the
+*              arguments of OSTaskCreateExt() plus the task's period and relative deadline.  The first job
+*              is released at creation; each call to OSTaskEDFWait() ends a job and waits for the next
+*              release, one period later.
+*
+*              Among the ready tasks of the EDF band (OS_EDF_PRIO_HI to OS_EDF_PRIO_LO) the job with the
+*              earliest absolute deadline runs; 'prio' only breaks ties.  Tasks at a higher priority than
+*              the band preempt EDF tasks, tasks at a lower priority run when no task of the band is
+*              ready, as before.
+*
+* Arguments  : task, p_arg, ptos, prio, id, pbos, stk_size, pext and opt
+*                        are as for OSTaskCreateExt().  'prio' must be within the EDF band.
+*
+*              period    is the time between two releases, in clock ticks.
+*
+*              deadline  is the time, from its release, by which each job must complete, in clock ticks.
+*                        It must not exceed 'period'.
+*
+* Returns    : OS_ERR_NONE             if the function was successful.
+*              OS_ERR_PRIO_INVALID     if 'prio' is outside of the EDF band
+*              OS_ERR_TASK_EDF         if 'period' or 'deadline' is 0, or 'deadline' exceeds 'period'
+*              OS_ERR_TASK_CREATE_ISR  if you tried to create a task from an ISR.
+*              any other error returned by OSTaskCreateExt().
+*********************************************************************************************************
+*/
+
+#if (OS_EDF_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+INT8U  OSTaskCreateEDF (void   (*task)(void *p_arg),
+                        void    *p_arg,
+                        OS_STK  *ptos,
+                        INT8U    prio,
+                        INT16U   id,
+                        OS_STK  *pbos,
+                        INT32U   stk_size,
+                        void    *pext,
+                        INT16U   opt,
+                        INT16U   period,
+                        INT16U   deadline)
+{
+    OS_TCB    *ptcb;
+    INT8U      err;
+#if OS_CRITICAL_METHOD == 3                  /* Allocate storage for CPU status register               */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if ((prio < OS_EDF_PRIO_HI) || (prio > OS_EDF_PRIO_LO)) {  /* Must be within the EDF band          */
+        return (OS_ERR_PRIO_INVALID);
+    }
+    if ((period == 0) || (deadline == 0) || (deadline > period)) {
+        return (OS_ERR_TASK_EDF);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSIntNesting > 0) {                  /* Make sure we don't create the task from within an ISR  */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_CREATE_ISR);
+    }
+    OSLockNesting++;                         /* Task must not run before its first deadline is set     */
+    OS_EXIT_CRITICAL();
+    err = OSTaskCreateExt(task, p_arg, ptos, prio, id, pbos, stk_size, pext, opt);
+    OS_ENTER_CRITICAL();
+    OSLockNesting--;
+    if (err == OS_ERR_NONE) {
+        ptcb                      = OSTCBList;          /* OS_TCBInit() put the new task first     */
+        ptcb->OSTCBEDFPeriod      = period;
+        ptcb->OSTCBEDFDeadline    = deadline;
+        ptcb->OSTCBEDFRelease     = (INT32U)OSTime;     /* First job is released now               */
+        ptcb->OSTCBEDFDeadlineAbs = (INT32U)OSTime + deadline;
+    }
+    OS_EXIT_CRITICAL();
+    if ((err == OS_ERR_NONE) && (OSRunning == OS_TRUE)) {
+        OS_Sched();                          /* Find HPT now that the deadline is known                */
+    }
+    return (err);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  END THE CURRENT JOB OF AN EDF TASK
+*
+* Description: This function is called by a task created with OSTaskCreateEDF() when its current job is
+*              done.  The next job is released one period after the current one, which keeps the task's
+*              release times free of drift; the task is delayed until then.  A job that completes after
+*              its absolute deadline is counted in the task's OSTCBEDFMissCtr.
+*
+*              If the next release is already due (the job overran its period), the next job starts right
+*              away and keeps its own, nominal, deadline.
+*
+* Arguments  : none
+*
+* Returns    : OS_ERR_NONE             if the job completed in time
+*              OS_ERR_TASK_EDF_MISS    if the job completed after its deadline
+*              OS_ERR_TASK_EDF         if the calling task is not an EDF task
+*              OS_ERR_TIME_DLY_ISR     if you called this function from an ISR
+*********************************************************************************************************
+*/
+
+#if OS_EDF_EN > 0
+INT8U  OSTaskEDFWait (void)
+{
+    OS_TCB    *ptcb;
+    INT32U     now;
+    INT32U     release;
+    INT8U      err;
+#if OS_CRITICAL_METHOD == 3                  /* Allocate storage for CPU status register               */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                  /* See if trying to call from an ISR                      */
+        return (OS_ERR_TIME_DLY_ISR);
+    }
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBCur;
+    if (ptcb->OSTCBEDFPeriod == 0) {         /* Only tasks created by OSTaskCreateEDF() have jobs      */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_EDF);
+    }
+    now = (INT32U)OSTime;
+    err = OS_ERR_NONE;
+    if ((INT32S)(now - ptcb->OSTCBEDFDeadlineAbs) > 0) {     /* Completed after the deadline?          */
+        ptcb->OSTCBEDFMissCtr++;
+        err = OS_ERR_TASK_EDF_MISS;
+    }
+    release                   = ptcb->OSTCBEDFRelease + ptcb->OSTCBEDFPeriod;
+    ptcb->OSTCBEDFRelease     = release;                     /* Next job                               */
+    ptcb->OSTCBEDFDeadlineAbs = release + ptcb->OSTCBEDFDeadline;
+    OS_EXIT_CRITICAL();
+    if ((INT32S)(release - now) > 0) {
+        OSTimeDly((INT16U)(release - now));                  /* Wait for the release (< one period)    */
+    } else {
+        OS_Sched();                                          /* Later deadline, another job may go     */
+    }
+    return (err);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        CREATE A PERIODIC TASK
+*
+* Description: This function creates a task that runs one job per period.  It takes the arguments of
+*              OSTaskCreateExt() plus the period.  The first job is released at creation; each call to
+*              OSTaskWaitNextPeriod() ends a job and delays the task until the next release.
+*
+*              The release times are kept in the TCB and the task is made ready by OSTimeTick(), like
+*              any delayed task, so no timer, semaphore or timer task is involved.
+*
+* Arguments  : task, p_arg, ptos, prio, id, pbos, stk_size, pext and opt
+*                        are as for OSTaskCreateExt().
+*
+*              period    is the time between two releases, in clock ticks.
+*
+* Returns    : OS_ERR_NONE             if the function was successful.
+*              OS_ERR_TASK_PERIODIC    if 'period' is 0
+*              OS_ERR_TASK_CREATE_ISR  if you tried to create a task from an ISR.
+*              any other error returned by OSTaskCreateExt().
+*********************************************************************************************************
+*/
+
+#if (OS_TASK_PERIODIC_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+INT8U  OSTaskCreatePeriodic (void   (*task)(void *p_arg),
+                             void    *p_arg,
+                             OS_STK  *ptos,
+                             INT8U    prio,
+                             INT16U   id,
+                             OS_STK  *pbos,
+                             INT32U   stk_size,
+                             void    *pext,
+                             INT16U   opt,
+                             INT16U   period)
+{
+    OS_TCB    *ptcb;
+    INT8U      err;
+#if OS_CRITICAL_METHOD == 3                  /* Allocate storage for CPU status register               */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (period == 0) {
+        return (OS_ERR_TASK_PERIODIC);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSIntNesting > 0) {                  /* Make sure we don't create the task from within an ISR  */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_CREATE_ISR);
+    }
+    OSLockNesting++;                         /* Task must not run before its period is set             */
+    OS_EXIT_CRITICAL();
+    err = OSTaskCreateExt(task, p_arg, ptos, prio, id, pbos, stk_size, pext, opt);
+    OS_ENTER_CRITICAL();
+    OSLockNesting--;
+    if (err == OS_ERR_NONE) {
+        ptcb               = OSTCBList;      /* OS_TCBInit() put the new task first                    */
+        ptcb->OSTCBPeriod  = period;
+        ptcb->OSTCBRelease = (INT32U)OSTime; /* First job is released now                              */
+    }
+    OS_EXIT_CRITICAL();
+    if ((err == OS_ERR_NONE) && (OSRunning == OS_TRUE)) {
+        OS_Sched();
+    }
+    return (err);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                WAIT FOR THE NEXT RELEASE OF A PERIODIC TASK
+*
+* Description: This function is called by a task created with OSTaskCreatePeriodic() when its current
+*              job is done.  The next release is computed from the previous one, not from the time of
+*              the call, so the task's releases do not drift however long its jobs take.  The task is
+*              delayed until that release.
+*
+*              A job that overran its period has made the task miss one or more releases.  These are
+*              skipped, so the task stays in phase, and added to the task's OSTCBOverrunCtr.  The wait
+*              itself is made by OSTimeDlyUntil() on the release time kept in the TCB.
+*
+* Arguments  : none
+*
+* Returns    : OS_ERR_NONE             if the job completed before the next release
+*              OS_ERR_TASK_OVERRUN     if releases were missed
+*              OS_ERR_TASK_PERIODIC    if the calling task is not a periodic task
+*              OS_ERR_TIME_DLY_ISR     if you called this function from an ISR
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0
+INT8U  OSTaskWaitNextPeriod (void)
+{
+    OS_TCB    *ptcb;
+    INT16U     missed;
+
+
+
+    if (OSIntNesting > 0) {                  /* See if trying to call from an ISR                      */
+        return (OS_ERR_TIME_DLY_ISR);
+    }
+    ptcb = OSTCBCur;                         /* Period and release are only changed by the task itself */
+    if (ptcb->OSTCBPeriod == 0) {            /* Only tasks created by OSTaskCreatePeriodic() ...       */
+        return (OS_ERR_TASK_PERIODIC);
+    }
+    missed = OSTimeDlyUntil(&ptcb->OSTCBRelease, ptcb->OSTCBPeriod);
+    if (missed > 0) {
+        ptcb->OSTCBOverrunCtr += missed;
+        return (OS_ERR_TASK_OVERRUN);
+    }
+    return (OS_ERR_NONE);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -449,6 +815,11 @@ INT8U  OSTaskDel (INT8U prio)
         prio = OSTCBCur->OSTCBPrio;                     /* Set priority to delete to current           */
     }
     ptcb = OSTCBPrioTbl[prio];
+#if OS_RR_EN > 0
+    if ((OSRunning == OS_TRUE) && (prio == OSTCBCur->OSTCBPrio)) {
+        ptcb = OSTCBCur;                                /* Shared priority: means the caller           */
+    }
+#endif
     if (ptcb == (OS_TCB *)0) {                          /* Task to delete must exist                   */
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);
@@ -458,10 +829,20 @@ INT8U  OSTaskDel (INT8U prio)
         return (OS_ERR_TASK_DEL);
     }
 
+#if OS_RR_EN > 0
+    OS_RdyListRemove(ptcb);                             /* Make task not ready                         */
+#else
     OSRdyTbl[ptcb->OSTCBY] &= ~ptcb->OSTCBBitX;
     if (OSRdyTbl[ptcb->OSTCBY] == 0) {                  /* Make task not ready                         */
         OSRdyGrp           &= ~ptcb->OSTCBBitY;
     }
+#endif
+#if OS_PREEMPT_THRESH_EN > 0
+    OSPreemptTbl[ptcb->OSTCBY] &= ~ptcb->OSTCBBitX;     /* Forget that it was preempted                */
+    if (OSPreemptTbl[ptcb->OSTCBY] == 0) {
+        OSPreemptGrp           &= ~ptcb->OSTCBBitY;
+    }
+#endif
     
 #if (OS_EVENT_EN)
     if (ptcb->OSTCBEventPtr != (OS_EVENT *)0) {
@@ -481,7 +862,11 @@ INT8U  OSTaskDel (INT8U prio)
     }
 #endif
 
+#if OS_TICK_LIST_EN > 0
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from updating          */
+#else
     ptcb->OSTCBDly      = 0;                            /* Prevent OSTimeTick() from updating          */
+#endif
     ptcb->OSTCBStat     = OS_STAT_RDY;                  /* Prevent task from being resumed             */
     ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
     if (OSLockNesting < 255u) {                         /* Make sure we don't context switch           */
@@ -495,7 +880,11 @@ INT8U  OSTaskDel (INT8U prio)
     }
     OSTaskDelHook(ptcb);                                /* Call user defined hook                      */
     OSTaskCtr--;                                        /* One less task being managed                 */
+#if OS_RR_EN > 0
+    OS_PrioLeave(ptcb);                                 /* Clear old priority entry                    */
+#else
     OSTCBPrioTbl[prio] = (OS_TCB *)0;                   /* Clear old priority entry                    */
+#endif
     if (ptcb->OSTCBPrev == (OS_TCB *)0) {               /* Remove from TCB chain                       */
         ptcb->OSTCBNext->OSTCBPrev = (OS_TCB *)0;
         OSTCBList                  = ptcb->OSTCBNext;
@@ -666,6 +1055,11 @@ INT8U  OSTaskNameGet (INT8U prio, INT8U *pname, INT8U *perr)
         prio = OSTCBCur->OSTCBPrio;
     }
     ptcb = OSTCBPrioTbl[prio];
+#if OS_RR_EN > 0
+    if ((OSRunning == OS_TRUE) && (prio == OSTCBCur->OSTCBPrio)) {
+        ptcb = OSTCBCur;                                 /* Shared priority: means the caller          */
+    }
+#endif
     if (ptcb == (OS_TCB *)0) {                           /* Does task exist?                           */
         OS_EXIT_CRITICAL();                              /* No                                         */
         *perr = OS_ERR_TASK_NOT_EXIST;
@@ -745,6 +1139,11 @@ void  OSTaskNameSet (INT8U prio, INT8U *pname, INT8U *perr)
         prio = OSTCBCur->OSTCBPrio;
     }
     ptcb = OSTCBPrioTbl[prio];
+#if OS_RR_EN > 0
+    if ((OSRunning == OS_TRUE) && (prio == OSTCBCur->OSTCBPrio)) {
+        ptcb = OSTCBCur;                             /* Shared priority: means the caller              */
+    }
+#endif
     if (ptcb == (OS_TCB *)0) {                       /* Does task exist?                               */
         OS_EXIT_CRITICAL();                          /* No                                             */
         *perr = OS_ERR_TASK_NOT_EXIST;
@@ -767,6 +1166,343 @@ void  OSTaskNameSet (INT8U prio, INT8U *pname, INT8U *perr)
 }
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          NOTIFY A TASK
+*
+* Description: This function posts a notification straight to a task.  Each task has a 32-bit notification
+*              value that can be used as a set of event flags, a counting semaphore or a mailbox holding
+*              one value, without an OS_EVENT.  If the task waits in OSTaskNotifyPend(), it is made ready.
+*
+* Arguments  : prio     is the priority of the task to notify.  If you specify OS_PRIO_SELF, the calling
+*                       task is notified.
+*
+*              val      is the value to post.  It is ignored with OS_NOTIFY_INC.
+*
+*              opt      determines how the notification value is updated:
+*
+*                       OS_NOTIFY_SET_BITS     'val' is OR'd into the notification value
+*                       OS_NOTIFY_INC          the notification value is incremented
+*                       OS_NOTIFY_OVERWRITE    the notification value is replaced by 'val'
+*
+* Returns    : OS_ERR_NONE             if the notification was posted
+*              OS_ERR_PRIO_INVALID     if the priority you specify is higher that the maximum allowed
+*                                      (i.e. >= OS_LOWEST_PRIO)
+*              OS_ERR_INVALID_OPT      if you specified an invalid option
+*              OS_ERR_TASK_NOT_EXIST   if the task does not exist or is assigned to a Mutex PIP
+*              OS_ERR_SEM_OVF          if OS_NOTIFY_INC would overflow the notification value
+*
+* Note(s)    : This function may be called from an ISR.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_NOTIFY_EN > 0
+INT8U  OSTaskNotify (INT8U prio, INT32U val, INT8U opt)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                                   /* Storage for CPU status register       */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio >= OS_LOWEST_PRIO) {                             /* Make sure task priority is valid      */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if (opt > OS_NOTIFY_OVERWRITE) {                          /* Validate 'opt'                        */
+        return (OS_ERR_INVALID_OPT);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                               /* See if notifying self                 */
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) { /* Task must exist                       */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    switch (opt) {
+        case OS_NOTIFY_SET_BITS:
+             ptcb->OSTCBNotifyVal |= val;
+             break;
+
+        case OS_NOTIFY_INC:
+             if (ptcb->OSTCBNotifyVal == 0xFFFFFFFFuL) {      /* Make sure value doesn't overflow      */
+                 OS_EXIT_CRITICAL();
+                 return (OS_ERR_SEM_OVF);
+             }
+             ptcb->OSTCBNotifyVal++;
+             break;
+
+        default:
+             ptcb->OSTCBNotifyVal  = val;
+             break;
+    }
+    ptcb->OSTCBNotifyRdy = OS_TRUE;
+    if ((ptcb->OSTCBStat & OS_STAT_NOTIFY) == OS_STAT_RDY) {  /* Is the task waiting for it?           */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NONE);
+    }
+#if OS_TICK_LIST_EN > 0
+    OS_TickListRemove(ptcb);                                  /* Cancel the timeout                    */
+#else
+    ptcb->OSTCBDly       = 0;
+#endif
+    ptcb->OSTCBStat     &= ~(INT8U)OS_STAT_NOTIFY;
+    ptcb->OSTCBStatPend  =  OS_STAT_PEND_OK;
+    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) { /* Make task ready unless suspended      */
+#if OS_RR_EN > 0
+        OS_RdyListInsert(ptcb);
+#else
+        OSRdyGrp               |= ptcb->OSTCBBitY;
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
+    }
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                               /* Find HPT ready to run                 */
+    return (OS_ERR_NONE);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      WAIT FOR A TASK NOTIFICATION
+*
+* Description: This function waits for a notification posted to the calling task by OSTaskNotify().  It
+*              returns at once if one was posted since the last call.
+*
+* Arguments  : timeout  is an optional timeout period (in clock ticks).  If non-zero, your task will wait
+*                       for the notification up to the amount of time specified by this argument.  If you
+*                       specify 0, however, your task will wait forever.
+*
+*              opt      determines what is taken from the notification value:
+*
+*                       OS_NOTIFY_TAKE_ALL     the value is returned and cleared
+*                       OS_NOTIFY_TAKE_ONE     the value is returned and decremented; the task stays
+*                                              notified while the value is not 0
+*
+*              perr     is a pointer to where an error message will be deposited.  Possible error
+*                       messages are:
+*
+*                       OS_ERR_NONE            The call was successful and your task received a
+*                                              notification.
+*                       OS_ERR_TIMEOUT         No notification was received within the specified
+*                                              'timeout'.
+*                       OS_ERR_INVALID_OPT     You specified an invalid option.
+*                       OS_ERR_PEND_ISR        If you called this function from an ISR.
+*                       OS_ERR_PEND_LOCKED     If you called this function when the scheduler is locked
+*
+* Returns    : The notification value before it was taken, or 0 on an error.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_NOTIFY_EN > 0
+INT32U  OSTaskNotifyPend (INT16U timeout, INT8U opt, INT8U *perr)
+{
+    INT32U     val;
+#if OS_RR_EN == 0
+    INT8U      y;
+#endif
+#if OS_CRITICAL_METHOD == 3                                   /* Storage for CPU status register       */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                                 /* Validate 'perr'                       */
+        return (0);
+    }
+    if (opt > OS_NOTIFY_TAKE_ONE) {                           /* Validate 'opt'                        */
+        *perr = OS_ERR_INVALID_OPT;
+        return (0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                   /* See if called from ISR ...            */
+        *perr = OS_ERR_PEND_ISR;                              /* ... can't PEND from an ISR            */
+        return (0);
+    }
+    if (OSLockNesting > 0) {                                  /* See if called with scheduler locked   */
+        *perr = OS_ERR_PEND_LOCKED;
+        return (0);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSTCBCur->OSTCBNotifyRdy == OS_FALSE) {               /* Nothing posted, must wait             */
+        OSTCBCur->OSTCBStat     |= OS_STAT_NOTIFY;
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+        OSTCBCur->OSTCBDly       = timeout;                   /* Store pend timeout in TCB             */
+#if OS_TICK_LIST_EN > 0
+        OS_TickListInsert(OSTCBCur);
+#endif
+#if OS_RR_EN > 0
+        OS_RdyListRemove(OSTCBCur);                           /* Suspend task until notified ...       */
+#else
+        y            =  OSTCBCur->OSTCBY;                     /* Suspend task until notified ...       */
+        OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
+        if (OSRdyTbl[y] == 0) {
+            OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
+        }
+#endif
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                           /* ... or timeout                        */
+        OS_ENTER_CRITICAL();
+        if (OSTCBCur->OSTCBStatPend != OS_STAT_PEND_OK) {     /* Timed out                             */
+            OSTCBCur->OSTCBStat     &= ~(INT8U)OS_STAT_NOTIFY;
+            OSTCBCur->OSTCBStatPend  =  OS_STAT_PEND_OK;
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_TIMEOUT;
+            return (0);
+        }
+    }
+    val = OSTCBCur->OSTCBNotifyVal;
+    if ((opt == OS_NOTIFY_TAKE_ONE) && (val > 1)) {           /* Keep the rest for the next calls      */
+        OSTCBCur->OSTCBNotifyVal = val - 1;
+    } else {
+        OSTCBCur->OSTCBNotifyVal = 0L;
+        OSTCBCur->OSTCBNotifyRdy = OS_FALSE;
+    }
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return (val);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     SET THE TIME SLICE OF A TASK
+*
+* Description: This function sets how many clock ticks a task may run before the next ready task at the
+*              same priority gets the CPU.  The new time slice applies from the next time the task is made
+*              ready or rotated.
+*
+* Arguments  : prio     is the priority of the task(s).  If you specify OS_PRIO_SELF, the calling task's
+*                       time slice is set.  Otherwise every task created at 'prio' gets the new time slice.
+*
+*              quanta   is the length of the time slice, in clock ticks (1 to 65535).
+*
+* Returns    : OS_ERR_NONE             if the time slice was set
+*              OS_ERR_PRIO_INVALID     if the priority you specify is higher that the maximum allowed
+*                                      (i.e. >= OS_LOWEST_PRIO)
+*              OS_ERR_TASK_QUANTA      if 'quanta' is 0
+*              OS_ERR_TASK_NOT_EXIST   if no task was created at 'prio' or it is assigned to a Mutex PIP
+*********************************************************************************************************
+*/
+
+#if OS_RR_EN > 0
+INT8U  OSTaskQuantaSet (INT8U prio, INT16U quanta)
+{
+    OS_TCB    *ptcb;
+    OS_TCB    *psib;
+#if OS_CRITICAL_METHOD == 3                                   /* Storage for CPU status register       */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio >= OS_LOWEST_PRIO) {                             /* Make sure task priority is valid      */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    if (quanta == 0) {                                        /* A task must get at least one tick     */
+        return (OS_ERR_TASK_QUANTA);
+    }
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                               /* Set the caller's time slice only      */
+        OSTCBCur->OSTCBQuanta = quanta;
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NONE);
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) { /* Task must exist                       */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    psib = ptcb;
+    do {                                                      /* Set all the tasks at this priority    */
+        if (psib->OSTCBPrio == prio) {                        /* ... but not one raised to a PIP       */
+            psib->OSTCBQuanta = quanta;
+        }
+        psib = psib->OSTCBSibNext;
+    } while (psib != ptcb);
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  SET THE PREEMPTION THRESHOLD OF A TASK
+*
+* Description: This function sets the priority a task must have to preempt the given task.  Once the task
+*              runs, tasks with a priority between its own and its threshold wait until it blocks, which
+*              saves the context switches of tasks that don't need to preempt each other.  Tasks above
+*              the threshold still preempt it, and it resumes ahead of the tasks under its threshold.
+*
+* Arguments  : prio     is the priority of the task.  If you specify OS_PRIO_SELF, the threshold of the
+*                       calling task is set.
+*
+*              thresh   is the threshold: only tasks with a priority higher than 'thresh' (i.e. a lower
+*                       number) preempt the task.  Specify the task's own priority to remove the threshold.
+*
+* Returns    : OS_ERR_NONE             if the threshold was set
+*              OS_ERR_PRIO_INVALID     if the priority you specify is higher that the maximum allowed
+*                                      (i.e. >= OS_LOWEST_PRIO)
+*              OS_ERR_TASK_THRESH      if 'thresh' is lower than the task's priority (i.e. a larger number)
+*              OS_ERR_TASK_NOT_EXIST   if the task does not exist or is assigned to a Mutex PIP
+*********************************************************************************************************
+*/
+
+#if OS_PREEMPT_THRESH_EN > 0
+INT8U  OSTaskThreshSet (INT8U prio, INT8U thresh)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                                   /* Storage for CPU status register       */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio >= OS_LOWEST_PRIO) {                             /* Make sure task priority is valid      */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                               /* See if setting self                   */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) { /* Task must exist                       */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (thresh > ptcb->OSTCBPrio) {                           /* Threshold can't be below the task     */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_THRESH);
+    }
+    ptcb->OSTCBThresh = thresh;
+    OS_EXIT_CRITICAL();
+    if (OSRunning == OS_TRUE) {
+        OS_Sched();                                           /* A lower threshold may let others run  */
+    }
+    return (OS_ERR_NONE);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -783,6 +1519,8 @@ void  OSTaskNameSet (INT8U prio, INT8U *pname, INT8U *perr)
 *              OS_ERR_TASK_RESUME_PRIO    if the task to resume does not exist
 *              OS_ERR_TASK_NOT_EXIST      if the task is assigned to a Mutex PIP
 *              OS_ERR_TASK_NOT_SUSPENDED  if the task to resume has not been suspended
+*
+* Note(s)    : With OS_RR_EN, the first suspended task found at 'prio' is resumed.
 *********************************************************************************************************
 */
 
@@ -790,6 +1528,9 @@ void  OSTaskNameSet (INT8U prio, INT8U *pname, INT8U *perr)
 INT8U  OSTaskResume (INT8U prio)
 {
     OS_TCB    *ptcb;
+#if OS_RR_EN > 0
+    OS_TCB    *psib;
+#endif
 #if OS_CRITICAL_METHOD == 3                                   /* Storage for CPU status register       */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -811,12 +1552,25 @@ INT8U  OSTaskResume (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);
     }
+#if OS_RR_EN > 0
+    psib = ptcb;
+    while ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Resume first suspended task ...   */
+        ptcb = ptcb->OSTCBSibNext;                            /* ... at this priority                  */
+        if (ptcb == psib) {
+            break;
+        }
+    }
+#endif
     if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) != OS_STAT_RDY) { /* Task must be suspended                */
         ptcb->OSTCBStat &= ~(INT8U)OS_STAT_SUSPEND;           /* Remove suspension                     */
         if (ptcb->OSTCBStat == OS_STAT_RDY) {                 /* See if task is now ready              */
             if (ptcb->OSTCBDly == 0) {
+#if OS_RR_EN > 0
+                OS_RdyListInsert(ptcb);                       /* Yes, Make task ready to run           */
+#else
                 OSRdyGrp               |= ptcb->OSTCBBitY;    /* Yes, Make task ready to run           */
                 OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
                 OS_EXIT_CRITICAL();
                 if (OSRunning == OS_TRUE) {
                     OS_Sched();                               /* Find new highest priority task        */
@@ -883,6 +1637,11 @@ INT8U  OSTaskStkChk (INT8U prio, OS_STK_DATA *p_stk_data)
         prio = OSTCBCur->OSTCBPrio;
     }
     ptcb = OSTCBPrioTbl[prio];
+#if OS_RR_EN > 0
+    if ((OSRunning == OS_TRUE) && (prio == OSTCBCur->OSTCBPrio)) {
+        ptcb = OSTCBCur;                               /* Shared priority: means the caller            */
+    }
+#endif
     if (ptcb == (OS_TCB *)0) {                         /* Make sure task exist                         */
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);
@@ -942,7 +1701,9 @@ INT8U  OSTaskSuspend (INT8U prio)
 {
     BOOLEAN    self;
     OS_TCB    *ptcb;
+#if OS_RR_EN == 0
     INT8U      y;
+#endif
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -977,11 +1738,18 @@ INT8U  OSTaskSuspend (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);
     }
+#if OS_RR_EN > 0
+    if (self == OS_TRUE) {                                      /* Priority may be shared with others  */
+        ptcb = OSTCBCur;
+    }
+    OS_RdyListRemove(ptcb);                                     /* Make task not ready                 */
+#else
     y            = ptcb->OSTCBY;
     OSRdyTbl[y] &= ~ptcb->OSTCBBitX;                            /* Make task not ready                 */
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~ptcb->OSTCBBitY;
     }
+#endif
     ptcb->OSTCBStat |= OS_STAT_SUSPEND;                         /* Status of task is 'SUSPENDED'       */
     OS_EXIT_CRITICAL();
     if (self == OS_TRUE) {                                      /* Context switch only if SELF         */
@@ -1035,6 +1803,11 @@ INT8U  OSTaskQuery (INT8U prio, OS_TCB *p_task_data)
         prio = OSTCBCur->OSTCBPrio;
     }
     ptcb = OSTCBPrioTbl[prio];
+#if OS_RR_EN > 0
+    if ((OSRunning == OS_TRUE) && (prio == OSTCBCur->OSTCBPrio)) {
+        ptcb = OSTCBCur;                         /* Shared priority: means the caller                  */
+    }
+#endif
     if (ptcb == (OS_TCB *)0) {                   /* Task to query must exist                           */
         OS_EXIT_CRITICAL();
         return (OS_ERR_PRIO);
@@ -1045,6 +1818,9 @@ INT8U  OSTaskQuery (INT8U prio, OS_TCB *p_task_data)
     }
                                                  /* Copy TCB into user storage area                    */
     OS_MemCopy((INT8U *)p_task_data, (INT8U *)ptcb, sizeof(OS_TCB));
+#if OS_TICK_LIST_EN > 0
+    p_task_data->OSTCBDly = OS_TickListLeft(ptcb);  /* Ticks left, not the delay the task started with */
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -24,6 +24,9 @@ OS_EVENT *Sem;
 #define TASK2_PRIORITY      7
 #define TASK_STAT_PRIORITY 12  // lowest priority 
 
+/* Period of task1 and task2, converted to ticks at compile time */
+#define TASK_PERIOD OS_TIME_HMSM_TICKS(0, 0, 0, 10)
+
 void printStackSize(char* name, INT8U prio) 
 {
   INT8U err;
@@ -46,6 +49,7 @@ void printStackSize(char* name, INT8U prio)
 void task1(void* pdata)
 {
   INT8U err;
+  INT32U last_wake = OSTimeGet();
   while (1)
     { 
       OSSemPend(Sem, 0 , &err);
@@ -57,7 +61,7 @@ void task1(void* pdata)
       }
 
 	    OSSemPost(Sem);
-      OSTimeDlyHMSM(0, 0, 0, 10); 
+      OSTimeDlyUntil(&last_wake, TASK_PERIOD); 
       /* Context Switch to next task
 				   * Task will go to the ready state
 				   * after the specified delay
@@ -70,6 +74,7 @@ void task1(void* pdata)
 void task2(void* pdata)
 {
   INT8U err;
+  INT32U last_wake = OSTimeGet();
   while (1)
     { 
       OSSemPend(Sem, 0 , &err);
@@ -81,7 +86,7 @@ void task2(void* pdata)
       }
 
 	    OSSemPost(Sem);
-      OSTimeDlyHMSM(0, 0, 0, 10);
+      OSTimeDlyUntil(&last_wake, TASK_PERIOD);
       
     }
 }
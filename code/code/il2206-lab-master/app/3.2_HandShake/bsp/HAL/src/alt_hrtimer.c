@@ -0,0 +1,289 @@
+/*
+ * High-resolution timers, see sys/alt_hrtimer.h.
+ *
+ * The timer runs continuously with a period of "alt_hrtimer_load" cycles
+ * and "alt_hrtimer_base" is the time at which its counter last started
+ * from the top, so the current time is the base plus the cycles counted
+ * down since. The ISR adds one period to the base at each time out. When
+ * the period is changed, the base is moved to the time of the reload.
+ */
+
+#ifdef ALT_HRTIMER
+
+#include <errno.h>
+#include <stddef.h>
+
+#include "system.h"
+#include "sys/alt_irq.h"
+#include "sys/alt_hrtimer.h"
+#include "altera_avalon_timer_regs.h"
+#include "alt_types.h"
+
+#ifdef __ucosii__
+#include "ucos_ii.h"
+#endif
+
+#if defined(__ucosii__) && OS_ISR_DEFER_EN > 0
+#define ALT_HRTIMER_DEFER_EN 1
+#else
+#define ALT_HRTIMER_DEFER_EN 0
+#endif
+
+/* alt_hrtimer.state */
+#define ALT_HRTIMER_IDLE    0           /* not armed */
+#define ALT_HRTIMER_QUEUED  1           /* in alt_hrtimer_list */
+#define ALT_HRTIMER_FIRING  2           /* taken off the list by the ISR */
+
+#define ALT_HRTIMER_MAX_LOAD 0xFFFFFFFF
+
+static alt_hrtimer* alt_hrtimer_list;   /* pending timers, earliest first */
+static alt_u64      alt_hrtimer_base;
+static alt_u32      alt_hrtimer_load;
+static alt_u8       alt_hrtimer_running;
+static alt_u8       alt_hrtimer_in_isr;
+
+static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_hrtimer_count (void)
+{
+  IOWR_ALTERA_AVALON_TIMER_SNAPL (ALT_HRTIMER_TIMER_BASE, 0);
+  return (IORD_ALTERA_AVALON_TIMER_SNAPH (ALT_HRTIMER_TIMER_BASE) << 16) |
+          IORD_ALTERA_AVALON_TIMER_SNAPL (ALT_HRTIMER_TIMER_BASE);
+}
+
+alt_u64 alt_hrtimer_time (void)
+{
+  alt_u32 count;
+
+  count = alt_hrtimer_count ();
+  if (IORD_ALTERA_AVALON_TIMER_STATUS (ALT_HRTIMER_TIMER_BASE) &
+      ALTERA_AVALON_TIMER_STATUS_TO_MSK)
+  {
+    /*
+     * Timed out, with the ISR still pending: the snapshot may be from
+     * before or after the time out, take one that is after.
+     */
+    count = alt_hrtimer_count ();
+    return alt_hrtimer_base + alt_hrtimer_load + (alt_hrtimer_load - 1 - count);
+  }
+  return alt_hrtimer_base + (alt_hrtimer_load - 1 - count);
+}
+
+alt_u64 alt_hrtimer_now (void)
+{
+  alt_irq_context context;
+  alt_u64 now;
+
+  context = alt_irq_disable_all ();
+  now = alt_hrtimer_time ();
+  alt_irq_enable_all (context);
+  return now;
+}
+
+/*
+ * alt_hrtimer_reload() loads the period that times out at the first
+ * deadline, or the longest period if there is none. Called with interrupts
+ * disabled.
+ */
+
+static void alt_hrtimer_reload (void)
+{
+  alt_u64 now;
+  alt_u32 cycles;
+
+  now = alt_hrtimer_time ();
+  if (alt_hrtimer_list == NULL)
+  {
+    cycles = ALT_HRTIMER_MAX_LOAD;
+  }
+  else if (alt_hrtimer_list->expires < now + ALT_HRTIMER_MIN_CYCLES)
+  {
+    cycles = ALT_HRTIMER_MIN_CYCLES;
+  }
+  else if (alt_hrtimer_list->expires - now > ALT_HRTIMER_MAX_LOAD)
+  {
+    cycles = ALT_HRTIMER_MAX_LOAD;
+  }
+  else
+  {
+    cycles = (alt_u32) (alt_hrtimer_list->expires - now);
+  }
+
+  /* Writing the period stops the counter, start it again at once */
+  IOWR_ALTERA_AVALON_TIMER_PERIODL (ALT_HRTIMER_TIMER_BASE, (cycles - 1) & 0xFFFF);
+  IOWR_ALTERA_AVALON_TIMER_PERIODH (ALT_HRTIMER_TIMER_BASE, (cycles - 1) >> 16);
+  IOWR_ALTERA_AVALON_TIMER_CONTROL (ALT_HRTIMER_TIMER_BASE,
+                                    ALTERA_AVALON_TIMER_CONTROL_ITO_MSK  |
+                                    ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+                                    ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+  IOWR_ALTERA_AVALON_TIMER_STATUS (ALT_HRTIMER_TIMER_BASE, 0);
+  alt_hrtimer_base = now;
+  alt_hrtimer_load = cycles;
+}
+
+/* Insert "timer" after the timers with the same or an earlier deadline */
+
+static void alt_hrtimer_link (alt_hrtimer* timer)
+{
+  alt_hrtimer** pp;
+
+  pp = &alt_hrtimer_list;
+  while (*pp != NULL && (*pp)->expires <= timer->expires)
+  {
+    pp = &(*pp)->next;
+  }
+  timer->next  = *pp;
+  timer->state = ALT_HRTIMER_QUEUED;
+  *pp = timer;
+}
+
+static void alt_hrtimer_unlink (alt_hrtimer* timer)
+{
+  alt_hrtimer** pp;
+
+  for (pp = &alt_hrtimer_list; *pp != NULL; pp = &(*pp)->next)
+  {
+    if (*pp == timer)
+    {
+      *pp = timer->next;
+      break;
+    }
+  }
+}
+
+/*
+ * The timer ISR: account for the time out, then call back every timer whose
+ * deadline has passed, reading the time again after each callback.
+ */
+
+static void alt_hrtimer_irq (void* context)
+{
+  alt_hrtimer* timer;
+
+  IOWR_ALTERA_AVALON_TIMER_STATUS (ALT_HRTIMER_TIMER_BASE, 0);
+  alt_hrtimer_base += alt_hrtimer_load;
+  alt_hrtimer_in_isr = 1;
+
+  while ((timer = alt_hrtimer_list) != NULL &&
+         timer->expires <= alt_hrtimer_time ())
+  {
+    alt_hrtimer_list = timer->next;
+    timer->state     = ALT_HRTIMER_FIRING;
+#if ALT_HRTIMER_DEFER_EN
+    if (timer->opt & ALT_HRTIMER_DEFERRED)
+    {
+      (void) OSIntDefer (OS_DEFER_CALL, (void*) timer->callback,
+                         (INT32U) timer->context);
+    }
+    else
+#endif
+    {
+      timer->callback (timer->context);
+    }
+
+    /* Unless the callback stopped or restarted it */
+    if (timer->state == ALT_HRTIMER_FIRING)
+    {
+      if (timer->period != 0)
+      {
+        timer->expires += timer->period;
+        alt_hrtimer_link (timer);
+      }
+      else
+      {
+        timer->state = ALT_HRTIMER_IDLE;
+      }
+    }
+  }
+
+  alt_hrtimer_in_isr = 0;
+  if (alt_hrtimer_list != NULL || alt_hrtimer_load != ALT_HRTIMER_MAX_LOAD)
+  {
+    alt_hrtimer_reload ();
+  }
+}
+
+void alt_hrtimer_init (void)
+{
+  alt_irq_context context;
+
+  context = alt_irq_disable_all ();
+  if (!alt_hrtimer_running)
+  {
+    alt_hrtimer_running = 1;
+    IOWR_ALTERA_AVALON_TIMER_CONTROL (ALT_HRTIMER_TIMER_BASE,
+                                      ALTERA_AVALON_TIMER_CONTROL_STOP_MSK);
+    alt_hrtimer_base = 0;
+    alt_hrtimer_load = ALT_HRTIMER_MAX_LOAD;
+    IOWR_ALTERA_AVALON_TIMER_PERIODL (ALT_HRTIMER_TIMER_BASE, 0xFFFF);
+    IOWR_ALTERA_AVALON_TIMER_PERIODH (ALT_HRTIMER_TIMER_BASE, 0xFFFF);
+    IOWR_ALTERA_AVALON_TIMER_STATUS (ALT_HRTIMER_TIMER_BASE, 0);
+    alt_ic_isr_register (ALT_HRTIMER_TIMER_IRQ_IC_ID, ALT_HRTIMER_TIMER_IRQ,
+                         alt_hrtimer_irq, NULL, NULL);
+    IOWR_ALTERA_AVALON_TIMER_CONTROL (ALT_HRTIMER_TIMER_BASE,
+                                      ALTERA_AVALON_TIMER_CONTROL_ITO_MSK  |
+                                      ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+                                      ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+  }
+  alt_irq_enable_all (context);
+}
+
+int alt_hrtimer_start (alt_hrtimer* timer,
+                       alt_u32      delay_us,
+                       alt_u32      period_us,
+                       void         (*callback) (void* context),
+                       void*        context,
+                       alt_u8       opt)
+{
+  alt_irq_context irq_context;
+  alt_u64 period;
+
+  period = (alt_u64) period_us * ALT_HRTIMER_CYCLES_PER_US;
+  if (period_us != 0 &&
+      (period < ALT_HRTIMER_MIN_CYCLES || period > ALT_HRTIMER_MAX_LOAD))
+  {
+    return -EINVAL;
+  }
+
+  alt_hrtimer_init ();
+
+  irq_context = alt_irq_disable_all ();
+  if (timer->state == ALT_HRTIMER_QUEUED)
+  {
+    alt_hrtimer_unlink (timer);
+  }
+  timer->expires  = alt_hrtimer_time () +
+                    (alt_u64) delay_us * ALT_HRTIMER_CYCLES_PER_US;
+  timer->period   = (alt_u32) period;
+  timer->callback = callback;
+  timer->context  = context;
+  timer->opt      = opt;
+  alt_hrtimer_link (timer);
+
+  /* A new first deadline; the ISR reloads the period on its way out */
+  if (alt_hrtimer_list == timer && !alt_hrtimer_in_isr)
+  {
+    alt_hrtimer_reload ();
+  }
+  alt_irq_enable_all (irq_context);
+
+  return 0;
+}
+
+void alt_hrtimer_stop (alt_hrtimer* timer)
+{
+  alt_irq_context context;
+
+  context = alt_irq_disable_all ();
+  if (timer->state == ALT_HRTIMER_QUEUED)
+  {
+    alt_hrtimer_unlink (timer);
+  }
+  timer->state = ALT_HRTIMER_IDLE;
+  alt_irq_enable_all (context);
+
+  /*
+   * The period is left as it is: the ISR finds nothing due if it was
+   * loaded for this timer, and reloads it for the next one.
+   */
+}
+
+#endif /* ALT_HRTIMER */
@@ -48,15 +48,40 @@ alt_u32 _alt_tick_rate = 0;
  * reset. 
  */
 
-volatile alt_u32 _alt_nticks = 0;
+volatile alt_u64 _alt_nticks = 0;
 
 /*
- * "alt_alarm_list" is the head of a linked list of registered alarms. This is
- * initialised to be an empty list.
+ * "alt_alarm_list" is the head of a linked list of registered alarms, sorted
+ * by expiry time. This is initialised to be an empty list.
  */
 
 ALT_LLIST_HEAD(alt_alarm_list);
 
+/*
+ * "alt_alarm_expiring" is the alarm whose callback is being made, if any. It
+ * is cleared by alt_alarm_stop(), so that an alarm stopped by its own
+ * callback is not put back on the list (see alt_alarm_expire()).
+ */
+
+static alt_alarm* alt_alarm_expiring = NULL;
+
+/*
+ * alt_nticks64() reads "_alt_nticks" with interrupts disabled, since the
+ * system clock ISR may update one half between the loads of the two.
+ */
+
+alt_u64 alt_nticks64 (void)
+{
+  alt_irq_context irq_context;
+  alt_u64         nticks;
+
+  irq_context = alt_irq_disable_all();
+  nticks = _alt_nticks;
+  alt_irq_enable_all (irq_context);
+
+  return nticks;
+}
+
 /*
  * alt_alarm_stop() is called to remove an alarm from the list of registered 
  * alarms. Alternatively an alarm can unregister itself by returning zero when 
@@ -68,10 +93,104 @@ void alt_alarm_stop (alt_alarm* alarm)
   alt_irq_context irq_context;
 
   irq_context = alt_irq_disable_all();
+  if (alt_alarm_expiring == alarm)
+  {
+    alt_alarm_expiring = NULL;
+  }
   alt_llist_remove (&alarm->llist);
   alt_irq_enable_all (irq_context);
 }
 
+/*
+ * alt_alarm_insert() adds an alarm to the sorted list. The search starts from
+ * the tail, since a periodic alarm being rearmed is usually due after most of
+ * the others.
+ */
+
+void alt_alarm_insert (alt_alarm* alarm)
+{
+  alt_llist* prev = alt_alarm_list.previous;
+
+  while ((prev != &alt_alarm_list) && (((alt_alarm*) prev)->time > alarm->time))
+  {
+    prev = prev->previous;
+  }
+
+  alarm->llist.previous = prev;
+  alarm->llist.next     = prev->next;
+  prev->next->previous  = &alarm->llist;
+  prev->next            = &alarm->llist;
+}
+
+/*
+ * alt_alarm_next() returns the number of ticks before the first registered
+ * alarm is due, or zero when there is none. The system clock driver uses it
+ * to decide for how long the periodic tick may be stopped. An alarm more than
+ * 2^32 - 1 ticks away is reported as that. It is expected to be called with
+ * interrupts disabled.
+ */
+
+alt_u32 alt_alarm_next (void)
+{
+  alt_u64    now;
+  alt_alarm* alarm = (alt_alarm*) alt_alarm_list.next;
+
+  if (alarm == (alt_alarm*) &alt_alarm_list)
+  {
+    return 0;
+  }
+
+  now = _alt_nticks;
+  if (alarm->time <= now)
+  {
+    return 1;                   /* due, or overdue, on the next tick */
+  }
+  if (alarm->time - now > 0xffffffff)
+  {
+    return 0xffffffff;
+  }
+  return (alt_u32) (alarm->time - now);
+}
+
+/*
+ * alt_alarm_expire() makes the callbacks of the alarms due at "now". Since
+ * the list is sorted, only the alarms that are due, and the first one that is
+ * not, are looked at.
+ *
+ * An alarm is taken off the list before its callback is made. Unless the
+ * callback returned zero, stopped the alarm or restarted it itself, it is put
+ * back at its new time.
+ */
+
+static void alt_alarm_expire (alt_u64 now)
+{
+  alt_alarm* alarm;
+  alt_u32    next_callback;
+
+  while (((alarm = (alt_alarm*) alt_alarm_list.next) !=
+          (alt_alarm*) &alt_alarm_list) && (alarm->time <= now))
+  {
+    alt_llist_remove (&alarm->llist);
+    alt_alarm_expiring = alarm;
+
+    next_callback = alarm->callback (alarm->context);
+
+    /* 
+     * alt_llist_remove() leaves the entry pointing at itself, whether the
+     * callback stopped the alarm or did nothing: a stop is told apart by
+     * alt_alarm_stop() clearing "alt_alarm_expiring".
+     */
+
+    if ((next_callback != 0) && (alt_alarm_expiring == alarm) &&
+        (alarm->llist.next == &alarm->llist))
+    {
+      alarm->time += next_callback;
+      alt_alarm_insert (alarm);
+    }
+    alt_alarm_expiring = NULL;
+  }
+}
+
 /*
  * alt_tick() is periodically called by the system clock driver in order to
  * process the registered list of alarms. Each alarm is registed with a
@@ -80,65 +199,23 @@ void alt_alarm_stop (alt_alarm* alarm)
  * The return value of the callback function indicates how many ticks are to
  * elapse until the next callback. A return value of zero indicates that the
  * alarm should be deactivated. 
+ *
+ * The tick count and the alarm times are 64 bits wide, so there is no wrap
+ * to handle. The cost of a tick with no alarm due is the same however
+ * many alarms are registered.
  * 
  * alt_tick() is expected to run at interrupt level.
  */
 
 void alt_tick (void)
 {
-  alt_alarm* next;
-  alt_alarm* alarm = (alt_alarm*) alt_alarm_list.next;
-
-  alt_u32    next_callback;
-
   /* update the tick counter */
 
   _alt_nticks++;
 
   /* process the registered callbacks */
 
-  while (alarm != (alt_alarm*) &alt_alarm_list)
-  {
-    next = (alt_alarm*) alarm->llist.next;
-
-    /* 
-     * Upon the tick-counter rolling over it is safe to clear the 
-     * roll-over flag; once the flag is cleared this (or subsequnt)
-     * tick events are enabled to generate an alarm event. 
-     */
-    if ((alarm->rollover) && (_alt_nticks == 0))
-    {
-      alarm->rollover = 0;
-    }
-    
-    /* if the alarm period has expired, make the callback */    
-    if ((alarm->time <= _alt_nticks) && (alarm->rollover == 0))
-    {
-      next_callback = alarm->callback (alarm->context);
-
-      /* deactivate the alarm if the return value is zero */
-
-      if (next_callback == 0)
-      {
-        alt_alarm_stop (alarm);
-      }
-      else
-      {
-        alarm->time += next_callback;
-        
-        /* 
-         * If the desired alarm time causes a roll-over, set the rollover
-         * flag. This will prevent the subsequent tick event from causing
-         * an alarm too early.
-         */
-        if(alarm->time < _alt_nticks)
-        {
-          alarm->rollover = 1;
-        }
-      }
-    }
-    alarm = next;
-  }
+  alt_alarm_expire (_alt_nticks);
 
   /* 
    * Update the operating system specific timer facilities.
@@ -147,3 +224,29 @@ void alt_tick (void)
   ALT_OS_TIME_TICK();
 }
 
+/*
+ * alt_tick_n() is called by the system clock driver in place of alt_tick()
+ * when the periodic interrupt has been held off for "nticks" ticks. The
+ * driver never sleeps past the first alarm (see alt_alarm_next()), so the
+ * alarms are processed exactly as alt_tick() would on the last of these
+ * ticks.
+ *
+ * alt_tick_n() is expected to run at interrupt level.
+ */
+
+#ifdef ALT_OS_TIME_TICK_N
+
+void alt_tick_n (alt_u32 nticks)
+{
+  /* update the tick counter */
+
+  _alt_nticks += nticks;
+
+  /* process the registered callbacks */
+
+  alt_alarm_expire (_alt_nticks);
+
+  ALT_OS_TIME_TICK_N(nticks);
+}
+
+#endif /* ALT_OS_TIME_TICK_N */
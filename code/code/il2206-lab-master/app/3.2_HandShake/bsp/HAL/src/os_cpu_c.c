@@ -26,6 +26,11 @@ extern void OSStartTsk;                 /* The entry point for all tasks. */
 static  INT16U  OSTmrCtr;
 #endif
 
+#if OS_TICKLESS_EN > 0
+#include "altera_avalon_timer.h"
+#include "sys/alt_alarm.h"
+#endif
+
 /***********************************************************************************************
  *                                        INITIALIZE A TASK'S STACK
  *
@@ -195,9 +200,13 @@ void OSTimeTickHook (void)
 {
 #if OS_TMR_EN > 0
     OSTmrCtr++;
-    if (OSTmrCtr >= (OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC)) {
+    if (OSTmrCtr >= OS_TMR_TICKS_PER_SIGNAL) {          /* Integer constant: no float compare per tick */
         OSTmrCtr = 0;
+#if OS_ISR_DEFER_EN > 0
+        (void)OSIntDefer(OS_DEFER_TMR_SIGNAL, (void *)0, 1);  /* Post from the defer task */
+#else
         OSTmrSignal();
+#endif
     }
 #endif  
     
@@ -207,6 +216,72 @@ void OSTimeTickHook (void)
 #endif
 }
 
+/*
+*********************************************************************************************************
+*                                         MULTIPLE TICK HOOK
+*
+* Description: This function is called by OSTimeTickN() in place of 'ticks' calls to OSTimeTickHook(),
+*              after the system clock slept through several ticks (see OS_TICKLESS_EN).  The timer task
+*              is signaled once for every timer period that was crossed.  With OS_ISR_DEFER_EN, a single
+*              deferred record carries all these signals, so a long sleep cannot fill the defer queue.
+*
+* Arguments  : ticks  is the number of ticks that elapsed.
+*
+* Note(s)    : 1) Interrupts may or may not be ENABLED during this call.
+*********************************************************************************************************
+*/
+#if OS_TICKLESS_EN > 0
+void OSTimeTickHookN (INT32U ticks)
+{
+#if OS_TMR_EN > 0
+    INT32U  ctr;
+    INT32U  signals;
+
+
+    ctr     = OSTmrCtr + ticks;
+    signals = 0;
+    while (ctr >= OS_TMR_TICKS_PER_SIGNAL) {
+        ctr -= OS_TMR_TICKS_PER_SIGNAL;
+        signals++;
+    }
+    OSTmrCtr = (INT16U)ctr;
+#if OS_ISR_DEFER_EN > 0
+    if (signals > 0) {
+        (void)OSIntDefer(OS_DEFER_TMR_SIGNAL, (void *)0, signals);   /* Post from the defer task */
+    }
+#else
+    while (signals > 0) {
+        signals--;
+        OSTmrSignal();
+    }
+#endif
+#endif
+
+#ifdef ALT_INICHE
+    while (ticks > 0) {
+        ticks--;
+        cticks_hook();
+    }
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                           TICKLESS WAKE HOOK
+*
+* Description: This function is called by OSIntExit() when an interrupt readies a task while the idle task
+*              holds off the system clock.  The ticks that elapsed so far are reported to the HAL and the
+*              kernel before the task runs.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*********************************************************************************************************
+*/
+void OSTicklessWakeHook (void)
+{
+    alt_avalon_timer_sc_wake();
+}
+#endif
+
 void OSInitHookBegin(void)
 {
 #if OS_TMR_EN > 0
@@ -218,8 +293,77 @@ void OSInitHookEnd(void)
 {
 }
 
+/*
+*********************************************************************************************************
+*                                             IDLE TASK HOOK
+*
+* Description: This function is called by the idle task.  With OS_TICKLESS_EN it computes the number of
+*              ticks before anything is due (a task delay or pend timeout, an OS_TMR timer or an alt_alarm)
+*              and lets the system clock skip the ticks in between.
+*
+* Note(s)    : 1) The idle task keeps running while the clock sleeps, so OSIdleCtr and hence the CPU usage
+*                 computed by the statistic task are not affected.
+*
+*              2) The sleep length is computed with interrupts enabled.  Only a tick or a task can move a
+*                 task delay or an OS_TMR expiry closer, so the result is used only if neither the tick count
+*                 nor OSCtxSwCtr changed meanwhile.  HAL alarms may also be started by an ISR and are checked
+*                 again with interrupts disabled, which takes constant time.
+*********************************************************************************************************
+*/
 void OSTaskIdleHook(void)
 {
+#if OS_TICKLESS_EN > 0
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+    INT32U     ticks;
+    INT32U     next;
+    INT32U     ctxsw;
+#if OS_TMR_EN > 0
+    INT32U     step;
+    INT32U     ticks_tmr;
+#endif
+    alt_u32    now;
+
+
+    ctxsw = OSCtxSwCtr;                                 /* See Note #2                                 */
+    now   = alt_nticks();
+    ticks = OS_TICKLESS_MAX_TICKS;
+    next  = OS_TickListNext();                          /* First task delay or pend timeout            */
+    if ((next != 0) && (next < ticks)) {
+        ticks = next;
+    }
+#if OS_TMR_EN > 0
+    next  = OSTmr_NextExpiry();                         /* First OS_TMR expiry, in timer ticks         */
+    if (next != 0) {
+        if (next > OS_TICKLESS_MAX_TICKS) {             /* Keeps the product below in range            */
+            next = OS_TICKLESS_MAX_TICKS;
+        }
+        next--;                                         /* Whole signal periods after the current one, */
+        step      = OS_TMR_TICKS_PER_SIGNAL;            /* ... converted to ticks by shift and add     */
+        ticks_tmr = OS_TMR_TICKS_PER_SIGNAL - OSTmrCtr; /* ... (no multiplier), one step per bit       */
+        while (next != 0) {
+            if ((next & 1) != 0) {
+                ticks_tmr += step;
+            }
+            step <<= 1;
+            next >>= 1;
+        }
+        if (ticks_tmr < ticks) {
+            ticks = ticks_tmr;
+        }
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    next  = alt_alarm_next();                           /* First HAL alarm                             */
+    if ((next != 0) && (next < ticks)) {
+        ticks = next;
+    }
+    if ((OSCtxSwCtr == ctxsw) && (alt_nticks() == now)) {
+        alt_avalon_timer_sc_sleep(ticks);
+    }
+    OS_EXIT_CRITICAL();
+#endif
 }
 
 void OSTCBInitHook(OS_TCB *ptcb)
@@ -69,8 +69,10 @@ extern "C" {
 
 #define  OS_PRIO_SELF              0xFFu                /* Indicate SELF priority                      */
 
-#if OS_TASK_STAT_EN > 0
-#define  OS_N_SYS_TASKS               2u                /* Number of system tasks                      */
+#if   (OS_TASK_STAT_EN > 0) && (OS_ISR_DEFER_EN > 0)
+#define  OS_N_SYS_TASKS               3u                /* Number of system tasks                      */
+#elif (OS_TASK_STAT_EN > 0) || (OS_ISR_DEFER_EN > 0)
+#define  OS_N_SYS_TASKS               2u
 #else
 #define  OS_N_SYS_TASKS               1u
 #endif
@@ -78,7 +80,10 @@ extern "C" {
 #define  OS_TASK_STAT_PRIO  (OS_LOWEST_PRIO - 1)        /* Statistic task priority                     */
 #define  OS_TASK_IDLE_PRIO  (OS_LOWEST_PRIO)            /* IDLE      task priority                     */
 
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 32 + 1)  /* Size of event table                         */
+#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 32 + 1)  /* Size of ready table                         */
+#elif OS_LOWEST_PRIO <= 63
 #define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of event table                         */
 #define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of ready table                         */
 #else
@@ -86,9 +91,18 @@ extern "C" {
 #define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 16 + 1)  /* Size of ready table                         */
 #endif
 
-#define  OS_TASK_IDLE_ID          65535u                /* ID numbers for Idle, Stat and Timer tasks   */
-#define  OS_TASK_STAT_ID          65534u
+                                                        /* Integer forms of OS_TICKS_PER_SEC, which is */
+                                                        /* ... a double in SYSTEM.H                    */
+#define  OS_TICK_RATE      ((INT32U)(OS_TICKS_PER_SEC)) /* Ticks per second                            */
+#define  OS_TICK_MS_Q16    (((OS_TICK_RATE << 16) + 500uL) / 1000uL)  /* Ticks per ms, 16.16 fixed    */
+#if OS_TMR_EN > 0                                       /* Ticks per OSTmrSignal()                     */
+#define  OS_TMR_TICKS_PER_SIGNAL  ((INT32U)((OS_TICKS_PER_SEC) / (OS_TMR_CFG_TICKS_PER_SEC)))
+#endif
+
+#define  OS_TASK_IDLE_ID          65535u                /* ID numbers for Idle, Stat, Timer and Defer  */
+#define  OS_TASK_STAT_ID          65534u                /* ... tasks                                   */
 #define  OS_TASK_TMR_ID           65533u
+#define  OS_TASK_DEFER_ID         65532u
 
 #define  OS_EVENT_EN           (((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SEM_EN > 0) || (OS_MUTEX_EN > 0))
 
@@ -107,9 +121,14 @@ extern "C" {
 #define  OS_STAT_SUSPEND           0x08u    /* Task is suspended                                       */
 #define  OS_STAT_MUTEX             0x10u    /* Pending on mutual exclusion semaphore                   */
 #define  OS_STAT_FLAG              0x20u    /* Pending on event flag group                             */
+#define  OS_STAT_NOTIFY            0x40u    /* Pending on a task notification                          */
 #define  OS_STAT_MULTI             0x80u    /* Pending on multiple events                              */
+#define  OS_STAT_PORT      OS_STAT_SEM      /* Pending on a state port (no bit left, see OSTCBEventPtr)*/
+#define  OS_STAT_TOPIC     OS_STAT_SEM      /* Pending on a topic      (no bit left, see OSTCBEventPtr)*/
+#define  OS_STAT_WAITSET   OS_STAT_SEM      /* Pending on a wait-set   (no bit left, see OSTCBEventPtr)*/
 
-#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG)
+#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG | \
+                                   OS_STAT_NOTIFY)
 
 /*
 *********************************************************************************************************
@@ -131,6 +150,9 @@ extern "C" {
 #define  OS_EVENT_TYPE_SEM            3u
 #define  OS_EVENT_TYPE_MUTEX          4u
 #define  OS_EVENT_TYPE_FLAG           5u
+#define  OS_EVENT_TYPE_PORT           6u
+#define  OS_EVENT_TYPE_TOPIC          7u
+#define  OS_EVENT_TYPE_WAITSET        8u
 
 #define  OS_TMR_TYPE                100u    /* Used to identify Timers ...                             */
                                             /* ... (Must be different value than OS_EVENT_TYPE_xxx)    */
@@ -203,6 +225,54 @@ extern "C" {
 #define  OS_POST_OPT_FRONT         0x02u    /* Post to highest priority task waiting                   */
 #define  OS_POST_OPT_NO_SCHED      0x04u    /* Do not call the scheduler if this option is selected    */
 
+/*
+*********************************************************************************************************
+*                                  OSTaskNotify() and OSTaskNotifyPend() OPTIONS
+*********************************************************************************************************
+*/
+#define  OS_NOTIFY_SET_BITS           0u    /* OR 'val' into the notification value                    */
+#define  OS_NOTIFY_INC                1u    /* Add one to the notification value (counting semaphore)  */
+#define  OS_NOTIFY_OVERWRITE          2u    /* Replace the notification value by 'val'                 */
+
+#define  OS_NOTIFY_TAKE_ALL           0u    /* Return the value and clear it                           */
+#define  OS_NOTIFY_TAKE_ONE           1u    /* Return the value and decrement it (counting semaphore)  */
+
+/*
+*********************************************************************************************************
+*                                   OSIntDefer() OPERATIONS
+*
+* The post that OS_TaskDefer() makes for each deferred record.  'pobj' and 'arg' are passed as shown.
+*********************************************************************************************************
+*/
+#define  OS_DEFER_SEM_POST            0u    /* OSSemPost(pobj)                                         */
+#define  OS_DEFER_MBOX_POST           1u    /* OSMboxPost(pobj, (void *)arg)                           */
+#define  OS_DEFER_Q_POST              2u    /* OSQPost(pobj, (void *)arg)                              */
+#define  OS_DEFER_FLAG_SET            3u    /* OSFlagPost(pobj, arg, OS_FLAG_SET, &err)                */
+#define  OS_DEFER_FLAG_CLR            4u    /* OSFlagPost(pobj, arg, OS_FLAG_CLR, &err)                */
+#define  OS_DEFER_NOTIFY_SET_BITS     5u    /* OSTaskNotify(prio, arg, OS_NOTIFY_SET_BITS)             */
+#define  OS_DEFER_NOTIFY_INC          6u    /* OSTaskNotify(prio, arg, OS_NOTIFY_INC)                  */
+#define  OS_DEFER_NOTIFY_OVERWRITE    7u    /* OSTaskNotify(prio, arg, OS_NOTIFY_OVERWRITE)            */
+#define  OS_DEFER_TMR_SIGNAL          8u    /* OSTmrSignal() 'arg' times, 'pobj' is ignored            */
+#define  OS_DEFER_CALL                9u    /* (*(void (*)(void *))pobj)((void *)arg)                  */
+
+#define  OS_DEFER_PRIO(prio)   ((void *)(INT32U)(prio))  /* 'pobj' of the OS_DEFER_NOTIFY_xxx operations */
+
+/*
+*********************************************************************************************************
+*                                   OSRingCreate() OPTIONS
+*********************************************************************************************************
+*/
+#define  OS_RING_OPT_NONE             0u    /* Consumer polls with OSRingAccept()                      */
+#define  OS_RING_OPT_PEND             1u    /* Consumer may also wait in OSRingPend() (uses OS_EVENT)  */
+
+/*
+*********************************************************************************************************
+*                                   OSPortCreate() OPTIONS
+*********************************************************************************************************
+*/
+#define  OS_PORT_OPT_NONE             0u    /* Readers sample with OSPortRead()                        */
+#define  OS_PORT_OPT_PEND             1u    /* Readers may also wait in OSPortPend() (uses OS_EVENT)   */
+
 /*
 *********************************************************************************************************
 *                                 TASK OPTIONS (see OSTaskCreateExt())
@@ -226,6 +296,8 @@ extern "C" {
 #define  OS_TMR_OPT_CALLBACK          3u    /* OSTmrStop() option to call 'callback' w/ timer arg.     */
 #define  OS_TMR_OPT_CALLBACK_ARG      4u    /* OSTmrStop() option to call 'callback' w/ new   arg.     */
 
+#define  OS_TMR_OPT_ISR_CALLBACK   0x80u    /* OSTmrCreate() flag, 'callback' called by OSTmrSignal()  */
+
 /*
 *********************************************************************************************************
 *                                            TIMER STATES
@@ -287,6 +359,12 @@ extern "C" {
 #define OS_ERR_TASK_SUSPEND_IDLE     71u
 #define OS_ERR_TASK_SUSPEND_PRIO     72u
 #define OS_ERR_TASK_WAITING          73u
+#define OS_ERR_TASK_QUANTA           74u
+#define OS_ERR_TASK_EDF              75u
+#define OS_ERR_TASK_EDF_MISS         76u
+#define OS_ERR_TASK_THRESH           77u
+#define OS_ERR_TASK_PERIODIC         78u
+#define OS_ERR_TASK_OVERRUN          79u
 
 #define OS_ERR_TIME_NOT_DLY          80u
 #define OS_ERR_TIME_INVALID_MINUTES  81u
@@ -331,6 +409,36 @@ extern "C" {
 #define OS_ERR_TMR_INVALID_STATE    141u
 #define OS_ERR_TMR_STOPPED          142u
 #define OS_ERR_TMR_NO_CALLBACK      143u
+#define OS_ERR_TMR_GRP_FULL         144u
+
+#define OS_ERR_DEFER_FULL           150u
+
+#define OS_ERR_IDLE_JOB_NULL        160u
+#define OS_ERR_IDLE_JOB_FULL        161u
+#define OS_ERR_IDLE_JOB_NOT_FOUND   162u
+
+#define OS_ERR_RING_INVALID         170u
+#define OS_ERR_RING_SIZE            171u
+#define OS_ERR_RING_FULL            172u
+#define OS_ERR_RING_EMPTY           173u
+#define OS_ERR_RING_DEPLETED        174u
+#define OS_ERR_RING_NO_PEND         175u
+
+#define OS_ERR_PORT_INVALID         180u
+#define OS_ERR_PORT_SIZE            181u
+#define OS_ERR_PORT_DEPLETED        182u
+#define OS_ERR_PORT_NO_PEND         183u
+
+#define OS_ERR_TOPIC_INVALID        190u
+#define OS_ERR_TOPIC_SIZE           191u
+#define OS_ERR_TOPIC_DEPLETED       192u
+#define OS_ERR_TOPIC_EMPTY          193u
+#define OS_ERR_TOPIC_SUBSCRIBED     194u
+
+#define OS_ERR_WAITSET_INVALID      200u
+#define OS_ERR_WAITSET_FULL         201u
+#define OS_ERR_WAITSET_DEPLETED     202u
+#define OS_ERR_WAITSET_MEMBER       203u
 
 /*
 *********************************************************************************************************
@@ -390,7 +498,10 @@ typedef struct os_event {
     INT8U    OSEventType;                    /* Type of event control block (see OS_EVENT_TYPE_xxxx)    */
     void    *OSEventPtr;                     /* Pointer to message or queue structure                   */
     INT16U   OSEventCnt;                     /* Semaphore Count (not used if other EVENT type)          */
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    INT8U    OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
+    INT32U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+#elif OS_LOWEST_PRIO <= 63
     INT8U    OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
     INT8U    OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
 #else
@@ -398,6 +509,11 @@ typedef struct os_event {
     INT16U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
 #endif
 
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+    struct os_waitset *OSEventWaitSet;       /* Wait-set the event is a member of, NULL if none         */
+    INT8U    OSEventWaitSetBit;              /* Slot of the event in that wait-set                      */
+#endif
+
 #if OS_EVENT_NAME_SIZE > 1
     INT8U    OSEventName[OS_EVENT_NAME_SIZE];
 #endif
@@ -461,7 +577,10 @@ typedef struct os_flag_node {               /* Event Flag Wait List Node
 #if OS_MBOX_EN > 0
 typedef struct os_mbox_data {
     void   *OSMsg;                         /* Pointer to message in mailbox                            */
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    INT32U  OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
+    INT8U   OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
+#elif OS_LOWEST_PRIO <= 63
     INT8U   OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
     INT8U   OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
 #else
@@ -509,7 +628,10 @@ typedef struct os_mem_data {
 
 #if OS_MUTEX_EN > 0
 typedef struct os_mutex_data {
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    INT32U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+    INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
+#elif OS_LOWEST_PRIO <= 63
     INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
     INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
 #else
@@ -544,7 +666,10 @@ typedef struct os_q_data {
     void          *OSMsg;               /* Pointer to next message to be extracted from queue          */
     INT16U         OSNMsgs;             /* Number of messages in message queue                         */
     INT16U         OSQSize;             /* Size of message queue                                       */
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    INT32U         OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
+    INT8U          OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
+#elif OS_LOWEST_PRIO <= 63
     INT8U          OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
     INT8U          OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
 #else
@@ -563,7 +688,10 @@ typedef struct os_q_data {
 #if OS_SEM_EN > 0
 typedef struct os_sem_data {
     INT16U  OSCnt;                          /* Semaphore count                                         */
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    INT32U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+    INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
+#elif OS_LOWEST_PRIO <= 63
     INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
     INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
 #else
@@ -626,14 +754,55 @@ typedef struct os_tcb {
     OS_FLAGS         OSTCBFlagsRdy;         /* Event flags that made task ready to run                 */
 #endif
 
+#if OS_TASK_NOTIFY_EN > 0
+    INT32U           OSTCBNotifyVal;        /* Notification value (see OSTaskNotify())                 */
+    BOOLEAN          OSTCBNotifyRdy;        /* A notification was posted and not taken yet             */
+#endif
+
     INT16U           OSTCBDly;              /* Nbr ticks to delay task or, timeout waiting for event   */
+                                            /* (with OS_TICK_LIST_EN: as started, not counted down;    */
+                                            /* OSTaskQuery() returns the ticks left in it)             */
+#if OS_TICK_LIST_EN > 0
+    INT16U           OSTCBDlyDelta;         /* Ticks remaining after the previous TCB in the tick list */
+    struct os_tcb   *OSTCBDlyNext;          /* Pointer to next     TCB in the tick (delta) list        */
+    struct os_tcb   *OSTCBDlyPrev;          /* Pointer to previous TCB in the tick (delta) list        */
+#endif
     INT8U            OSTCBStat;             /* Task      status                                        */
     INT8U            OSTCBStatPend;         /* Task PEND status                                        */
     INT8U            OSTCBPrio;             /* Task priority (0 == highest)                            */
+#if OS_PREEMPT_THRESH_EN > 0
+    INT8U            OSTCBThresh;           /* Only tasks above this priority may preempt the task     */
+#endif
+
+#if OS_RR_EN > 0
+    struct os_tcb   *OSTCBRdyNext;          /* Next     ready TCB at this priority (0 if not ready)    */
+    struct os_tcb   *OSTCBRdyPrev;          /* Previous ready TCB at this priority (0 if not ready)    */
+    struct os_tcb   *OSTCBSibNext;          /* Next     TCB created at this priority                   */
+    struct os_tcb   *OSTCBSibPrev;          /* Previous TCB created at this priority                   */
+    INT16U           OSTCBQuanta;           /* Time slice, in ticks                                    */
+    INT16U           OSTCBQuantaCtr;        /* Ticks left in the current time slice                    */
+#endif
+
+#if OS_EDF_EN > 0
+    INT16U           OSTCBEDFPeriod;        /* Period, in ticks (0 if not an EDF task)                 */
+    INT16U           OSTCBEDFDeadline;      /* Relative deadline, in ticks                             */
+    INT32U           OSTCBEDFRelease;       /* Release time of the current job (value of OSTime)       */
+    INT32U           OSTCBEDFDeadlineAbs;   /* Absolute deadline of the current job                    */
+    INT32U           OSTCBEDFMissCtr;       /* Number of jobs completed after their deadline           */
+#endif
+
+#if OS_TASK_PERIODIC_EN > 0
+    INT16U           OSTCBPeriod;           /* Period, in ticks (0 if not a periodic task)             */
+    INT32U           OSTCBRelease;          /* Release time of the current job (value of OSTime)       */
+    INT32U           OSTCBOverrunCtr;       /* Number of releases missed because a job overran         */
+#endif
 
     INT8U            OSTCBX;                /* Bit position in group  corresponding to task priority   */
     INT8U            OSTCBY;                /* Index into ready table corresponding to task priority   */
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    INT32U           OSTCBBitX;             /* Bit mask to access bit position in ready table          */
+    INT8U            OSTCBBitY;             /* Bit mask to access bit position in ready group          */
+#elif OS_LOWEST_PRIO <= 63
     INT8U            OSTCBBitX;             /* Bit mask to access bit position in ready table          */
     INT8U            OSTCBBitY;             /* Bit mask to access bit position in ready group          */
 #else
@@ -666,10 +835,44 @@ typedef struct os_tcb {
 */
 
 #if OS_TMR_EN > 0
+#if OS_TMR_HWHEEL_EN > 0
+#define  OS_TMR_WHEEL_SPOKES   (1u << OS_TMR_HWHEEL_BITS)   /* Spokes in each level of the wheel                  */
+#define  OS_TMR_WHEEL_MASK     (OS_TMR_WHEEL_SPOKES - 1u)
+#define  OS_TMR_WHEEL_TBL_SIZE (OS_TMR_HWHEEL_LEVELS * OS_TMR_WHEEL_SPOKES)
+#if (OS_TMR_HWHEEL_BITS * OS_TMR_HWHEEL_LEVELS) >= 32
+#define  OS_TMR_WHEEL_MAX_DLY  0xFFFFFFFFuL                 /* Longest delay held without being cascaded again    */
+#else
+#define  OS_TMR_WHEEL_MAX_DLY  ((1uL << (OS_TMR_HWHEEL_BITS * OS_TMR_HWHEEL_LEVELS)) - 1uL)
+#endif
+#else
+#define  OS_TMR_WHEEL_TBL_SIZE  OS_TMR_CFG_WHEEL_SIZE
+#if (OS_TMR_CFG_WHEEL_SIZE & (OS_TMR_CFG_WHEEL_SIZE - 1)) == 0
+#define  OS_TMR_WHEEL_SPOKE(t) ((INT16U)((t) & (OS_TMR_CFG_WHEEL_SIZE - 1u)))  /* Power of 2: a mask        */
+#else
+#define  OS_TMR_WHEEL_SPOKE(t) ((INT16U)((t) % OS_TMR_CFG_WHEEL_SIZE))         /* Else a software division  */
+#endif
+#endif
+#if OS_TICKLESS_EN > 0
+#define  OS_TMR_NEXT_NONE      0x80000000uL                 /* OSTmrNextMatch this far ahead: no timer to expire  */
+#endif
+
 typedef  void (*OS_TMR_CALLBACK)(void *ptmr, void *parg);
 
 
 
+#if OS_TMR_STATS_EN > 0
+typedef  struct  os_tmr_stats {
+    INT32U           OSTmrStatsExpiries;              /* Number of expiries, i.e. of callbacks made                    */
+    INT32U           OSTmrStatsCyclesMax;             /* Longest callback, in OS_TS_GET() cycles                       */
+    INT32U           OSTmrStatsCycles[OS_TMR_STATS_BINS]; /* Callback run times: bin 0 < 2^OS_TMR_STATS_BIN0_LOG2     */
+                                                      /*     cycles, each next bin doubles the limit, last one is open */
+    INT32U           OSTmrStatsLateMax;               /* Most timer ticks late                                         */
+    INT32U           OSTmrStatsLate[OS_TMR_STATS_BINS];   /* Ticks late: bin n is n ticks, last one is that or more    */
+} OS_TMR_STATS;
+#endif
+
+
+
 typedef  struct  os_tmr {
     INT8U            OSTmrType;                       /* Should be set to OS_TMR_TYPE                                  */
     OS_TMR_CALLBACK  OSTmrCallback;                   /* Function to call when timer expires                           */
@@ -679,6 +882,12 @@ typedef  struct  os_tmr {
     INT32U           OSTmrMatch;                      /* Timer expires when OSTmrTime == OSTmrMatch                    */
     INT32U           OSTmrDly;                        /* Delay time before periodic update starts                      */
     INT32U           OSTmrPeriod;                     /* Period to repeat timer                                        */
+#if OS_TMR_HWHEEL_EN > 0
+    INT16U           OSTmrSpoke;                      /* Index of the spoke in OSTmrWheelTbl[] holding the timer       */
+#endif
+#if OS_TMR_STATS_EN > 0
+    OS_TMR_STATS     OSTmrStats;                      /* Expiries, run time and lateness of the callbacks              */
+#endif
 #if OS_TMR_CFG_NAME_SIZE > 0
     INT8U            OSTmrName[OS_TMR_CFG_NAME_SIZE]; /* Name to give the timer                                        */
 #endif
@@ -695,6 +904,144 @@ typedef  struct  os_tmr_wheel {
     OS_TMR          *OSTmrFirst;                      /* Pointer to first timer in linked list                         */
     INT16U           OSTmrEntries;
 } OS_TMR_WHEEL;
+
+
+
+#if OS_TMR_GRP_EN > 0
+typedef  struct  os_tmr_grp_member {
+    OS_TMR_CALLBACK  OSTmrGrpCallback;                /* Function to call, or 0 to post OSTmrGrpArg as a semaphore     */
+    void            *OSTmrGrpArg;                     /* Argument to pass to the function                              */
+    INT32U           OSTmrGrpPhase;                   /* Release time in the period of the group, in timer ticks       */
+} OS_TMR_GRP_MEMBER;
+
+
+
+typedef  struct  os_tmr_grp {
+    OS_TMR          *OSTmrGrpTmr;                     /* Timer releasing the members, 0 if the group is free           */
+    INT32U           OSTmrGrpPeriod;                  /* Period of the group, in timer ticks                           */
+    INT8U            OSTmrGrpEntries;                 /* Number of members                                             */
+    INT8U            OSTmrGrpNext;                    /* Index of the first member of the next release                 */
+    OS_TMR_GRP_MEMBER OSTmrGrpMember[OS_TMR_CFG_GRP_MEMBERS];  /* Members, by phase, then in the order they were added */
+} OS_TMR_GRP;
+#endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                        DEFERRED POST DATA
+*********************************************************************************************************
+*/
+
+#if OS_ISR_DEFER_EN > 0
+typedef struct os_defer {
+    void            *OSDeferObj;            /* Object to post to (see OS_DEFER_xxx)                    */
+    INT32U           OSDeferArg;            /* Message, flags or notification value                    */
+    INT8U            OSDeferOp;             /* Operation, OS_DEFER_xxx                                 */
+} OS_DEFER;
+#endif
+
+/*
+*********************************************************************************************************
+*                                          RING CHANNEL DATA
+*
+* OSRingIn is only written by the producer and OSRingOut only by the consumer (see OS_RING.C).
+*********************************************************************************************************
+*/
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+typedef struct os_ring {
+    struct os_ring  *OSRingPtr;             /* Link to next ring in the list of free rings             */
+    INT8U           *OSRingBuf;             /* Storage of the entries, NULL if the ring is free        */
+    INT32U           OSRingMask;            /* Number of entries - 1, the number being a power of 2    */
+    INT16U           OSRingEntrySize;       /* Size of an entry, in bytes, a power of 2                */
+    INT8U            OSRingShift;           /* log2(OSRingEntrySize)                                   */
+    volatile BOOLEAN OSRingWait;            /* Consumer may sleep on OSRingSem, producer must post it  */
+    volatile INT32U  OSRingIn;              /* Number of entries posted since creation                 */
+    volatile INT32U  OSRingOut;             /* Number of entries taken  since creation                 */
+    OS_EVENT        *OSRingSem;             /* Semaphore of OSRingPend(), NULL without OS_RING_OPT_PEND */
+    INT32U           OSRingOvfCtr;          /* Number of entries dropped because the ring was full     */
+} OS_RING;
+#endif
+
+/*
+*********************************************************************************************************
+*                                           STATE PORT DATA
+*
+* Version N of the value is in OSPortBuf[N & 1] (see OS_PORT.C).
+*********************************************************************************************************
+*/
+
+#if (OS_PORT_EN > 0) && (OS_MAX_PORTS > 0)
+typedef struct os_port {
+    struct os_port  *OSPortPtr;             /* Link to next port in the list of free ports             */
+    OS_EVENT        *OSPortEvent;           /* Tasks in OSPortPend(), NULL without OS_PORT_OPT_PEND    */
+    volatile INT32U  OSPortVer;             /* Version of the value: number of writes completed        */
+    volatile INT32U  OSPortWr;              /* Number of writes started                                */
+    INT16U           OSPortSize;            /* Size of the value, in bytes, 0 if the port is free      */
+    INT32U           OSPortBuf[2][(OS_PORT_DATA_SIZE + 3) / 4];  /* Two copies of the value            */
+} OS_PORT;
+#endif
+
+/*
+*********************************************************************************************************
+*                                              TOPIC DATA
+*
+* Message N is in entry N & OSTopicMask of OSTopicBuf, at byte (N & OSTopicMask) << OSTopicShift (see
+* OS_TOPIC.C).
+*********************************************************************************************************
+*/
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+typedef struct os_topic {
+    struct os_topic *OSTopicPtr;            /* Link to next topic in the list of free topics           */
+    OS_EVENT        *OSTopicEvent;          /* Subscribers waiting in OSTopicPend()                    */
+    INT8U           *OSTopicBuf;            /* Storage of the messages                                 */
+    INT32U           OSTopicMask;           /* Number of entries - 1, the number being a power of 2    */
+    INT16U           OSTopicEntrySize;      /* Size of a message, in bytes, 0 if the topic is free     */
+    INT8U            OSTopicShift;          /* log2(OSTopicEntrySize), the size being a power of 2     */
+    INT16U           OSTopicSubs;           /* Number of subscribers                                   */
+    volatile INT32U  OSTopicSeq;            /* Number of messages published since creation            */
+    volatile INT32U  OSTopicWr;             /* Number of publications started                          */
+} OS_TOPIC;
+
+typedef struct os_topic_sub {               /* Owned by the subscribing task                           */
+    OS_TOPIC        *OSTopicSubTopic;       /* Topic subscribed to, NULL if not subscribed             */
+    INT32U           OSTopicSubSeq;         /* Sequence number of the next message to receive          */
+    INT32U           OSTopicSubLost;        /* Messages overwritten before they were received          */
+} OS_TOPIC_SUB;
+#endif
+
+/*
+*********************************************************************************************************
+*                                             WAIT-SET DATA
+*
+* Bit N of OSWaitSetUsed and OSWaitSetRdy stands for the member in OSWaitSetTbl[N] (see OS_WAITSET.C).
+*********************************************************************************************************
+*/
+
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+typedef struct os_waitset {
+    struct os_waitset *OSWaitSetPtr;        /* Link to next wait-set in the list of free wait-sets     */
+    OS_EVENT        *OSWaitSetEvent;        /* Tasks in OSWaitSetPend(), NULL if the wait-set is free  */
+    INT32U           OSWaitSetUsed;         /* Slots holding a member                                  */
+    INT32U           OSWaitSetRdy;          /* Members posted to since they were last found empty      */
+    OS_EVENT        *OSWaitSetTbl[OS_WAITSET_SIZE];  /* Members                                        */
+} OS_WAITSET;
+#endif
+
+/*
+*********************************************************************************************************
+*                                           IDLE JOB DATA
+*********************************************************************************************************
+*/
+
+#if OS_IDLE_JOB_EN > 0
+typedef  void (*OS_IDLE_JOB_FNCT)(void *p_arg);
+
+typedef struct os_idle_job {
+    OS_IDLE_JOB_FNCT  OSIdleJobFnct;        /* One bounded step of the job, NULL if the entry is free  */
+    void             *OSIdleJobArg;         /* Argument passed to OSIdleJobFnct, holds the job state   */
+} OS_IDLE_JOB;
 #endif
 
 /*$PAGE*/
@@ -705,6 +1052,9 @@ typedef  struct  os_tmr_wheel {
 */
 
 OS_EXT  INT32U            OSCtxSwCtr;               /* Counter of number of context switches           */
+#if OS_RR_EN > 0
+OS_EXT  INT32U            OSRRCtxSwCtr;             /* Context switches caused by time slicing         */
+#endif
 
 #if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
 OS_EXT  OS_EVENT         *OSEventFreeList;          /* Pointer to list of free EVENT control blocks    */
@@ -726,12 +1076,36 @@ OS_EXT  OS_STK            OSTaskStatStk[OS_TASK_STAT_STK_SIZE];      /* Statisti
 
 OS_EXT  INT8U             OSIntNesting;             /* Interrupt nesting level                         */
 
+#if OS_ISR_DEFER_EN > 0
+OS_EXT  OS_DEFER          OSDeferTbl[OS_ISR_DEFER_SIZE];  /* Ring of posts deferred by ISRs            */
+OS_EXT  INT16U            OSDeferIn;                /* Index of the next record to fill                */
+OS_EXT  INT16U            OSDeferOut;               /* Index of the next record to replay              */
+OS_EXT  INT16U            OSDeferEntries;           /* Number of records waiting to be replayed        */
+OS_EXT  INT16U            OSDeferEntriesMax;        /* Peak of OSDeferEntries, to size the ring        */
+OS_EXT  INT32U            OSDeferOvfCtr;            /* Number of posts lost because the ring was full  */
+OS_EXT  BOOLEAN           OSDeferWait;              /* OS_TaskDefer() is out of the ready list         */
+OS_EXT  OS_TCB           *OSDeferTCB;               /* TCB of OS_TaskDefer()                           */
+OS_EXT  OS_STK            OSTaskDeferStk[OS_TASK_DEFER_STK_SIZE];    /* Defer task stack               */
+#endif
+
+#if OS_IDLE_JOB_EN > 0
+OS_EXT  OS_IDLE_JOB       OSIdleJobTbl[OS_MAX_IDLE_JOBS];  /* Jobs run by the idle task                */
+OS_EXT  INT8U             OSIdleJobIx;              /* Index of the next job to run                    */
+OS_EXT  BOOLEAN           OSIdleJobHold;            /* Jobs held while OSStatInit() calibrates         */
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+OS_EXT  INT8U             OSIdleStkChkPrio;         /* Next stack to check, > OS_TASK_IDLE_PRIO if done */
+#endif
+#endif
+
 OS_EXT  INT8U             OSLockNesting;            /* Multitasking lock nesting level                 */
 
 OS_EXT  INT8U             OSPrioCur;                /* Priority of current task                        */
 OS_EXT  INT8U             OSPrioHighRdy;            /* Priority of highest priority task               */
 
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+OS_EXT  INT8U             OSRdyGrp;                        /* Ready list group                         */
+OS_EXT  INT32U            OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
+#elif OS_LOWEST_PRIO <= 63
 OS_EXT  INT8U             OSRdyGrp;                        /* Ready list group                         */
 OS_EXT  INT8U             OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
 #else
@@ -739,6 +1113,11 @@ OS_EXT  INT16U            OSRdyGrp;                        /* Ready list group
 OS_EXT  INT16U            OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
 #endif
 
+#if OS_PREEMPT_THRESH_EN > 0
+OS_EXT  INT8U             OSPreemptGrp;                    /* Tasks preempted while under a threshold  */
+OS_EXT  INT32U            OSPreemptTbl[OS_RDY_TBL_SIZE];
+#endif
+
 OS_EXT  BOOLEAN           OSRunning;                       /* Flag indicating that kernel is running   */
 
 OS_EXT  INT8U             OSTaskCtr;                       /* Number of tasks created                  */
@@ -755,6 +1134,14 @@ OS_EXT  OS_TCB           *OSTCBList;                       /* Pointer to doubly
 OS_EXT  OS_TCB           *OSTCBPrioTbl[OS_LOWEST_PRIO + 1];/* Table of pointers to created TCBs        */
 OS_EXT  OS_TCB            OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS];   /* Table of TCBs                  */
 
+#if OS_TICK_LIST_EN > 0
+OS_EXT  OS_TCB           *OSTickList;                      /* Delayed TCBs sorted by expiry, as deltas */
+#endif
+
+#if OS_RR_EN > 0
+OS_EXT  OS_TCB           *OSRdyHead[OS_LOWEST_PRIO + 1];   /* Next TCB to run at each priority         */
+#endif
+
 #if OS_TICK_STEP_EN > 0
 OS_EXT  INT8U             OSTickStepState;          /* Indicates the state of the tick step feature    */
 #endif
@@ -769,14 +1156,37 @@ OS_EXT  OS_Q             *OSQFreeList;              /* Pointer to list of free Q
 OS_EXT  OS_Q              OSQTbl[OS_MAX_QS];        /* Table of QUEUE control blocks                   */
 #endif
 
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+OS_EXT  OS_RING          *OSRingFreeList;           /* Pointer to list of free ring channels           */
+OS_EXT  OS_RING           OSRingTbl[OS_MAX_RINGS];  /* Table of ring channel control blocks            */
+#endif
+
+#if (OS_PORT_EN > 0) && (OS_MAX_PORTS > 0)
+OS_EXT  OS_PORT          *OSPortFreeList;           /* Pointer to list of free state ports             */
+OS_EXT  OS_PORT           OSPortTbl[OS_MAX_PORTS];  /* Table of state port control blocks              */
+#endif
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+OS_EXT  OS_TOPIC         *OSTopicFreeList;          /* Pointer to list of free topics                  */
+OS_EXT  OS_TOPIC          OSTopicTbl[OS_MAX_TOPICS];/* Table of topic control blocks                   */
+#endif
+
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+OS_EXT  OS_WAITSET       *OSWaitSetFreeList;        /* Pointer to list of free wait-sets               */
+OS_EXT  OS_WAITSET        OSWaitSetTbl[OS_MAX_WAITSETS];  /* Table of wait-set control blocks          */
+#endif
+
 #if OS_TIME_GET_SET_EN > 0
-OS_EXT  volatile  INT32U  OSTime;                   /* Current value of system time (in ticks)         */
+OS_EXT  volatile  INT64U  OSTime;                   /* Current value of system time (in ticks), no wrap */
 #endif
 
 #if OS_TMR_EN > 0
 OS_EXT  INT16U            OSTmrFree;                /* Number of free entries in the timer pool        */
 OS_EXT  INT16U            OSTmrUsed;                /* Number of timers used                           */
 OS_EXT  INT32U            OSTmrTime;                /* Current timer time                              */
+#if OS_TICKLESS_EN > 0
+OS_EXT  INT32U            OSTmrNextMatch;           /* No timer of the wheel expires before this time  */
+#endif
 
 OS_EXT  OS_EVENT         *OSTmrSem;                 /* Sem. used to gain exclusive access to timers    */
 OS_EXT  OS_EVENT         *OSTmrSemSignal;           /* Sem. used to signal the update of timers        */
@@ -785,7 +1195,17 @@ OS_EXT  OS_TMR            OSTmrTbl[OS_TMR_CFG_MAX]; /* Table containing pool of
 OS_EXT  OS_TMR           *OSTmrFreeList;            /* Pointer to free list of timers                  */
 OS_EXT  OS_STK            OSTmrTaskStk[OS_TASK_TMR_STK_SIZE];
 
-OS_EXT  OS_TMR_WHEEL      OSTmrWheelTbl[OS_TMR_CFG_WHEEL_SIZE];
+OS_EXT  OS_TMR_WHEEL      OSTmrWheelTbl[OS_TMR_WHEEL_TBL_SIZE];
+
+#if OS_TMR_ISR_CALLBACK_EN > 0
+OS_EXT  INT16U            OSTmrWheelEntries;        /* Number of timers in the timer wheel             */
+OS_EXT  INT32U            OSTmrIsrTime;             /* Time of the timers called back by OSTmrSignal() */
+OS_EXT  OS_TMR           *OSTmrIsrList;             /* These timers, sorted by expiry                  */
+#endif
+
+#if OS_TMR_GRP_EN > 0
+OS_EXT  OS_TMR_GRP        OSTmrGrpTbl[OS_TMR_CFG_GRP_MAX]; /* Table of timer groups                    */
+#endif
 #endif
 
 extern  INT8U   const     OSUnMapTbl[256];          /* Priority->Index    lookup table                 */
@@ -1031,6 +1451,14 @@ INT8U         OSQPendAbort            (OS_EVENT        *pevent,
                                        INT8U           *perr);
 #endif
 
+#if OS_Q_MULTI_EN > 0
+INT16U        OSQPendMulti            (OS_EVENT        *pevent,
+                                       void           **pmsgs,
+                                       INT16U           max,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+#endif
+
 #if OS_Q_POST_EN > 0
 INT8U         OSQPost                 (OS_EVENT        *pevent,
                                        void            *pmsg);
@@ -1041,6 +1469,13 @@ INT8U         OSQPostFront            (OS_EVENT        *pevent,
                                        void            *pmsg);
 #endif
 
+#if OS_Q_MULTI_EN > 0
+INT16U        OSQPostMulti            (OS_EVENT        *pevent,
+                                       void           **pmsgs,
+                                       INT16U           n,
+                                       INT8U           *perr);
+#endif
+
 #if OS_Q_POST_OPT_EN > 0
 INT8U         OSQPostOpt              (OS_EVENT        *pevent,
                                        void            *pmsg,
@@ -1054,6 +1489,142 @@ INT8U         OSQQuery                (OS_EVENT        *pevent,
 
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         RING CHANNEL MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+
+INT8U         OSRingAccept            (OS_RING         *pring,
+                                       void            *pmsg);
+
+OS_RING      *OSRingCreate            (void            *pstorage,
+                                       INT32U           entries,
+                                       INT16U           entry_size,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+
+#if (OS_SEM_EN == 0) || (OS_SEM_DEL_EN > 0)
+OS_RING      *OSRingDel               (OS_RING         *pring,
+                                       INT8U           *perr);
+#endif
+
+INT32U        OSRingEntries           (OS_RING         *pring);
+
+#if OS_SEM_EN > 0
+void          OSRingPend              (OS_RING         *pring,
+                                       void            *pmsg,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+#endif
+
+INT8U         OSRingPost              (OS_RING         *pring,
+                                       void            *pmsg);
+
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          STATE PORT MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if (OS_PORT_EN > 0) && (OS_MAX_PORTS > 0)
+
+OS_PORT      *OSPortCreate            (INT16U           size,
+                                       void            *pinit,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+
+OS_PORT      *OSPortDel               (OS_PORT         *pport,
+                                       INT8U           *perr);
+
+INT32U        OSPortPend              (OS_PORT         *pport,
+                                       void            *pval,
+                                       INT32U           ver,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+INT32U        OSPortRead              (OS_PORT         *pport,
+                                       void            *pval);
+
+INT8U         OSPortWrite             (OS_PORT         *pport,
+                                       void            *pval);
+
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            TOPIC MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+
+INT8U         OSTopicAccept           (OS_TOPIC_SUB    *psub,
+                                       void            *pmsg);
+
+OS_TOPIC     *OSTopicCreate           (void            *pstorage,
+                                       INT32U           entries,
+                                       INT16U           entry_size,
+                                       INT8U           *perr);
+
+OS_TOPIC     *OSTopicDel              (OS_TOPIC        *ptopic,
+                                       INT8U           *perr);
+
+void          OSTopicPend             (OS_TOPIC_SUB    *psub,
+                                       void            *pmsg,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+INT8U         OSTopicPublish          (OS_TOPIC        *ptopic,
+                                       void            *pmsg);
+
+void          OSTopicSubscribe        (OS_TOPIC        *ptopic,
+                                       OS_TOPIC_SUB    *psub,
+                                       INT8U           *perr);
+
+void          OSTopicUnsubscribe      (OS_TOPIC_SUB    *psub,
+                                       INT8U           *perr);
+
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          WAIT-SET MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+
+void          OSWaitSetAdd            (OS_WAITSET      *pset,
+                                       OS_EVENT        *pevent,
+                                       INT8U           *perr);
+
+OS_WAITSET   *OSWaitSetCreate         (INT8U           *perr);
+
+OS_WAITSET   *OSWaitSetDel            (OS_WAITSET      *pset,
+                                       INT8U           *perr);
+
+INT16U        OSWaitSetPend           (OS_WAITSET      *pset,
+                                       OS_EVENT       **pevents_rdy,
+                                       void           **pmsgs_rdy,
+                                       INT16U           max,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+void          OSWaitSetRemove         (OS_WAITSET      *pset,
+                                       OS_EVENT        *pevent,
+                                       INT8U           *perr);
+
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1129,6 +1700,41 @@ INT8U         OSTaskCreateExt         (void           (*task)(void *p_arg),
                                        INT16U           opt);
 #endif
 
+#if OS_EDF_EN > 0
+#if OS_TASK_CREATE_EXT_EN > 0
+INT8U         OSTaskCreateEDF         (void           (*task)(void *p_arg),
+                                       void            *p_arg,
+                                       OS_STK          *ptos,
+                                       INT8U            prio,
+                                       INT16U           id,
+                                       OS_STK          *pbos,
+                                       INT32U           stk_size,
+                                       void            *pext,
+                                       INT16U           opt,
+                                       INT16U           period,
+                                       INT16U           deadline);
+#endif
+
+INT8U         OSTaskEDFWait           (void);
+#endif
+
+#if OS_TASK_PERIODIC_EN > 0
+#if OS_TASK_CREATE_EXT_EN > 0
+INT8U         OSTaskCreatePeriodic    (void           (*task)(void *p_arg),
+                                       void            *p_arg,
+                                       OS_STK          *ptos,
+                                       INT8U            prio,
+                                       INT16U           id,
+                                       OS_STK          *pbos,
+                                       INT32U           stk_size,
+                                       void            *pext,
+                                       INT16U           opt,
+                                       INT16U           period);
+#endif
+
+INT8U         OSTaskWaitNextPeriod    (void);
+#endif
+
 #if OS_TASK_DEL_EN > 0
 INT8U         OSTaskDel               (INT8U            prio);
 INT8U         OSTaskDelReq            (INT8U            prio);
@@ -1144,6 +1750,26 @@ void          OSTaskNameSet           (INT8U            prio,
                                        INT8U           *perr);
 #endif
 
+#if OS_TASK_NOTIFY_EN > 0
+INT8U         OSTaskNotify            (INT8U            prio,
+                                       INT32U           val,
+                                       INT8U            opt);
+
+INT32U        OSTaskNotifyPend        (INT16U           timeout,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+#endif
+
+#if OS_RR_EN > 0
+INT8U         OSTaskQuantaSet         (INT8U            prio,
+                                       INT16U           quanta);
+#endif
+
+#if OS_PREEMPT_THRESH_EN > 0
+INT8U         OSTaskThreshSet         (INT8U            prio,
+                                       INT8U            thresh);
+#endif
+
 #if OS_TASK_SUSPEND_EN > 0
 INT8U         OSTaskResume            (INT8U            prio);
 INT8U         OSTaskSuspend           (INT8U            prio);
@@ -1175,17 +1801,33 @@ INT8U         OSTimeDlyHMSM           (INT8U            hours,
                                        INT16U           milli);
 #endif
 
+                                                 /* Ticks in h:m:s.ms, rounded as by OSTimeDlyHMSM().  */
+                                                 /* Folded by the compiler for constant arguments.     */
+#define  OS_TIME_HMSM_TICKS(h, m, s, ms)                                                              \
+         ((INT32U)(((((INT32U)(h) * 3600uL + (INT32U)(m) * 60uL + (INT32U)(s)) * 1000uL + (INT32U)(ms)) \
+                    * (OS_TICKS_PER_SEC)) / 1000uL + 0.5))
+
+#if OS_TIME_DLY_UNTIL_EN > 0
+INT16U        OSTimeDlyUntil          (INT32U          *plast,
+                                       INT16U           period);
+#endif
+
 #if OS_TIME_DLY_RESUME_EN > 0
 INT8U         OSTimeDlyResume         (INT8U            prio);
 #endif
 
 #if OS_TIME_GET_SET_EN > 0
 INT32U        OSTimeGet               (void);
+INT64U        OSTimeGet64             (void);
 void          OSTimeSet               (INT32U           ticks);
 #endif
 
 void          OSTimeTick              (void);
 
+#if OS_TICKLESS_EN > 0
+void          OSTimeTickN             (INT32U           ticks);
+#endif
+
 /*
 *********************************************************************************************************
 *                                            TIMER MANAGEMENT
@@ -1224,6 +1866,37 @@ BOOLEAN      OSTmrStop                (OS_TMR          *ptmr,
                                        INT8U           *perr);
 
 INT8U        OSTmrSignal              (void);
+
+#if OS_TMR_STATS_EN > 0
+BOOLEAN      OSTmrStatsGet            (OS_TMR          *ptmr,
+                                       OS_TMR_STATS    *p_stats,
+                                       INT8U           *perr);
+
+BOOLEAN      OSTmrStatsClr            (OS_TMR          *ptmr,
+                                       INT8U           *perr);
+#endif
+
+#if OS_TMR_GRP_EN > 0
+OS_TMR_GRP  *OSTmrGrpCreate           (INT32U           period,
+                                       INT8U            opt,
+                                       INT8U           *pname,
+                                       INT8U           *perr);
+
+BOOLEAN      OSTmrGrpAdd              (OS_TMR_GRP      *pgrp,
+                                       INT32U           phase,
+                                       OS_TMR_CALLBACK  callback,
+                                       void            *callback_arg,
+                                       INT8U           *perr);
+
+BOOLEAN      OSTmrGrpStart            (OS_TMR_GRP      *pgrp,
+                                       INT8U           *perr);
+
+BOOLEAN      OSTmrGrpStop             (OS_TMR_GRP      *pgrp,
+                                       INT8U           *perr);
+
+BOOLEAN      OSTmrGrpDel              (OS_TMR_GRP      *pgrp,
+                                       INT8U           *perr);
+#endif
 #endif
 
 /*
@@ -1237,11 +1910,25 @@ void          OSInit                  (void);
 void          OSIntEnter              (void);
 void          OSIntExit               (void);
 
+#if OS_ISR_DEFER_EN > 0
+INT8U         OSIntDefer              (INT8U            op,
+                                       void            *pobj,
+                                       INT32U           arg);
+#endif
+
 #if OS_SCHED_LOCK_EN > 0
 void          OSSchedLock             (void);
 void          OSSchedUnlock           (void);
 #endif
 
+#if OS_IDLE_JOB_EN > 0
+INT8U         OSIdleJobAdd            (OS_IDLE_JOB_FNCT  fnct,
+                                       void             *p_arg);
+
+INT8U         OSIdleJobDel            (OS_IDLE_JOB_FNCT  fnct,
+                                       void             *p_arg);
+#endif
+
 void          OSStart                 (void);
 
 void          OSStatInit              (void);
@@ -1256,6 +1943,10 @@ INT16U        OSVersion               (void);
 *********************************************************************************************************
 */
 
+#if OS_SCHED_BITMAP_EN > 0
+INT8U         OS_BitScan              (INT32U           bits);
+#endif
+
 #if OS_TASK_DEL_EN > 0
 void          OS_Dummy                (void);
 #endif
@@ -1301,8 +1992,51 @@ void          OS_MemInit              (void);
 void          OS_QInit                (void);
 #endif
 
+#if (OS_PORT_EN > 0) && (OS_MAX_PORTS > 0)
+void          OS_PortInit             (void);
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+void          OS_RingInit             (void);
+#endif
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+void          OS_TopicInit            (void);
+#endif
+
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+void          OS_WaitSetInit          (void);
+BOOLEAN       OS_WaitSetSignal        (OS_EVENT        *pevent);
+void          OS_WaitSetUnlink        (OS_EVENT        *pevent);
+#endif
+
+#if OS_RR_EN > 0
+OS_TCB       *OS_EventTaskFind        (OS_EVENT        *pevent);
+
+BOOLEAN       OS_EventTaskShared      (OS_TCB          *ptcb,
+                                       OS_EVENT        *pevent);
+
+void          OS_PrioJoin             (OS_TCB          *ptcb);
+
+void          OS_PrioLeave            (OS_TCB          *ptcb);
+
+void          OS_RdyListInsert        (OS_TCB          *ptcb);
+
+void          OS_RdyListRemove        (OS_TCB          *ptcb);
+#endif
+
 void          OS_Sched                (void);
 
+#if OS_TICK_LIST_EN > 0
+void          OS_TickListInsert       (OS_TCB          *ptcb);
+
+INT16U        OS_TickListNext         (void);
+
+INT16U        OS_TickListLeft         (OS_TCB          *ptcb);
+
+void          OS_TickListRemove       (OS_TCB          *ptcb);
+#endif
+
 #if (OS_EVENT_NAME_SIZE > 1) || (OS_FLAG_NAME_SIZE > 1) || (OS_MEM_NAME_SIZE > 1) || (OS_TASK_NAME_SIZE > 1)
 INT8U         OS_StrCopy              (INT8U           *pdest,
                                        INT8U           *psrc);
@@ -1312,6 +2046,10 @@ INT8U         OS_StrLen               (INT8U           *psrc);
 
 void          OS_TaskIdle             (void            *p_arg);
 
+#if OS_ISR_DEFER_EN > 0
+void          OS_TaskDefer            (void            *p_arg);
+#endif
+
 #if OS_TASK_STAT_EN > 0
 void          OS_TaskStat             (void            *p_arg);
 #endif
@@ -1336,6 +2074,10 @@ INT8U         OS_TCBInit              (INT8U            prio,
 
 #if OS_TMR_EN > 0
 void          OSTmr_Init              (void);
+
+#if OS_TICKLESS_EN > 0
+INT32U        OSTmr_NextExpiry        (void);
+#endif
 #endif
 
 /*$PAGE*/
@@ -1372,6 +2114,14 @@ void          OSTCBInitHook           (OS_TCB          *ptcb);
 
 #if OS_TIME_TICK_HOOK_EN > 0
 void          OSTimeTickHook          (void);
+
+#if OS_TICKLESS_EN > 0
+void          OSTimeTickHookN         (INT32U           ticks);
+#endif
+#endif
+
+#if OS_TICKLESS_EN > 0
+void          OSTicklessWakeHook      (void);
 #endif
 
 /*$PAGE*/
@@ -1584,6 +2334,10 @@ void          OSCtxSw                 (void);
     #error  "OS_CFG.H, Missing OS_Q_PEND_ABORT_EN: Include code for OSQPendAbort()"
     #endif
 
+    #ifndef OS_Q_MULTI_EN
+    #error  "OS_CFG.H, Missing OS_Q_MULTI_EN: Include code for OSQPostMulti() and OSQPendMulti()"
+    #endif
+
     #ifndef OS_Q_POST_EN
     #error  "OS_CFG.H, Missing OS_Q_POST_EN: Include code for OSQPost()"
     #endif
@@ -1601,6 +2355,89 @@ void          OSCtxSw                 (void);
     #endif
 #endif
 
+/*
+*********************************************************************************************************
+*                                             RING CHANNELS
+*********************************************************************************************************
+*/
+
+#ifndef OS_RING_EN
+#error  "OS_CFG.H, Missing OS_RING_EN: Enable (1) or Disable (0) code generation for RING CHANNELS"
+#elif   OS_RING_EN > 0
+    #ifndef OS_MAX_RINGS
+    #error  "OS_CFG.H, Missing OS_MAX_RINGS: Max. number of ring channels"
+    #elif   OS_MAX_RINGS > 65500u
+    #error  "OS_CFG.H, OS_MAX_RINGS must be <= 65500"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                              STATE PORTS
+*********************************************************************************************************
+*/
+
+#ifndef OS_PORT_EN
+#error  "OS_CFG.H, Missing OS_PORT_EN: Enable (1) or Disable (0) code generation for STATE PORTS"
+#elif   OS_PORT_EN > 0
+    #ifndef OS_MAX_PORTS
+    #error  "OS_CFG.H, Missing OS_MAX_PORTS: Max. number of state ports"
+    #elif   OS_MAX_PORTS > 65500u
+    #error  "OS_CFG.H, OS_MAX_PORTS must be <= 65500"
+    #endif
+    #ifndef OS_PORT_DATA_SIZE
+    #error  "OS_CFG.H, Missing OS_PORT_DATA_SIZE: Largest value held by a state port, in bytes"
+    #elif   OS_PORT_DATA_SIZE == 0
+    #error  "OS_CFG.H, OS_PORT_DATA_SIZE must be > 0"
+    #endif
+    #if     !(OS_EVENT_EN)
+    #error  "OS_CFG.H, State ports need the event code: enable semaphores, mailboxes, queues or mutexes"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                                 TOPICS
+*********************************************************************************************************
+*/
+
+#ifndef OS_TOPIC_EN
+#error  "OS_CFG.H, Missing OS_TOPIC_EN: Enable (1) or Disable (0) code generation for TOPICS"
+#elif   OS_TOPIC_EN > 0
+    #ifndef OS_MAX_TOPICS
+    #error  "OS_CFG.H, Missing OS_MAX_TOPICS: Max. number of topics"
+    #elif   OS_MAX_TOPICS > 65500u
+    #error  "OS_CFG.H, OS_MAX_TOPICS must be <= 65500"
+    #endif
+    #if     !(OS_EVENT_EN)
+    #error  "OS_CFG.H, Topics need the event code: enable semaphores, mailboxes, queues or mutexes"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                               WAIT-SETS
+*********************************************************************************************************
+*/
+
+#ifndef OS_WAITSET_EN
+#error  "OS_CFG.H, Missing OS_WAITSET_EN: Enable (1) or Disable (0) code generation for WAIT-SETS"
+#elif   OS_WAITSET_EN > 0
+    #ifndef OS_MAX_WAITSETS
+    #error  "OS_CFG.H, Missing OS_MAX_WAITSETS: Max. number of wait-sets"
+    #elif   OS_MAX_WAITSETS > 65500u
+    #error  "OS_CFG.H, OS_MAX_WAITSETS must be <= 65500"
+    #endif
+    #ifndef OS_WAITSET_SIZE
+    #error  "OS_CFG.H, Missing OS_WAITSET_SIZE: Max. number of members of a wait-set"
+    #elif   (OS_WAITSET_SIZE == 0) || (OS_WAITSET_SIZE > 32)
+    #error  "OS_CFG.H, OS_WAITSET_SIZE must be between 1 and 32"
+    #endif
+    #if     !(OS_EVENT_EN)
+    #error  "OS_CFG.H, Wait-sets need the event code: enable semaphores, mailboxes or queues"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                              SEMAPHORES
@@ -1720,6 +2557,14 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TIME_GET_SET_EN: Include code for OSTimeGet() and OSTimeSet()"
 #endif
 
+#ifndef OS_TIME_DLY_UNTIL_EN
+#error  "OS_CFG.H, Missing OS_TIME_DLY_UNTIL_EN: Include code for OSTimeDlyUntil()"
+#else
+    #if     (OS_TIME_DLY_UNTIL_EN > 0) && (OS_TIME_GET_SET_EN == 0)
+    #error  "OS_CFG.H, OS_TIME_DLY_UNTIL_EN requires OS_TIME_GET_SET_EN (wake times are values of OSTime)"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                             TIMER MANAGEMENT
@@ -1769,6 +2614,55 @@ void          OSCtxSw                 (void);
     #ifndef OS_TASK_TMR_STK_SIZE
     #error  "OS_CFG.H, Missing OS_TASK_TMR_STK_SIZE: Determines the size of the Timer Task's stack"
     #endif
+
+    #ifndef OS_TMR_ISR_CALLBACK_EN
+    #error  "OS_CFG.H, Missing OS_TMR_ISR_CALLBACK_EN: When (1) allows timers called back from OSTmrSignal()"
+    #endif
+
+    #ifndef OS_TMR_GRP_EN
+    #error  "OS_CFG.H, Missing OS_TMR_GRP_EN: When (1) includes code for timer groups"
+    #elif   OS_TMR_GRP_EN > 0
+        #ifndef OS_TMR_CFG_GRP_MAX
+        #error  "OS_CFG.H, Missing OS_TMR_CFG_GRP_MAX: Maximum number of timer groups"
+        #elif   OS_TMR_CFG_GRP_MAX == 0
+        #error  "OS_CFG.H, OS_TMR_CFG_GRP_MAX must be > 0"
+        #endif
+        #ifndef OS_TMR_CFG_GRP_MEMBERS
+        #error  "OS_CFG.H, Missing OS_TMR_CFG_GRP_MEMBERS: Maximum number of members of a timer group"
+        #elif   (OS_TMR_CFG_GRP_MEMBERS == 0) || (OS_TMR_CFG_GRP_MEMBERS > 255)
+        #error  "OS_CFG.H, OS_TMR_CFG_GRP_MEMBERS must be between 1 and 255"
+        #endif
+    #endif
+
+    #ifndef OS_TMR_STATS_EN
+    #error  "OS_CFG.H, Missing OS_TMR_STATS_EN: When (1) keeps statistics on the timer callbacks"
+    #elif   OS_TMR_STATS_EN > 0
+        #ifndef OS_TMR_STATS_BINS
+        #error  "OS_CFG.H, Missing OS_TMR_STATS_BINS: Number of bins of the timer histograms"
+        #elif   OS_TMR_STATS_BINS < 2
+        #error  "OS_CFG.H, OS_TMR_STATS_BINS must be >= 2"
+        #endif
+        #ifndef OS_TMR_STATS_BIN0_LOG2
+        #error  "OS_CFG.H, Missing OS_TMR_STATS_BIN0_LOG2: Limit of the first run time bin, as a power of 2"
+        #endif
+    #endif
+
+    #ifndef OS_TMR_HWHEEL_EN
+    #error  "OS_CFG.H, Missing OS_TMR_HWHEEL_EN: When (1) uses a hierarchical timer wheel"
+    #elif   OS_TMR_HWHEEL_EN > 0
+        #ifndef OS_TMR_HWHEEL_BITS
+        #error  "OS_CFG.H, Missing OS_TMR_HWHEEL_BITS: Number of spokes per level, as a power of 2"
+        #endif
+        #ifndef OS_TMR_HWHEEL_LEVELS
+        #error  "OS_CFG.H, Missing OS_TMR_HWHEEL_LEVELS: Number of levels of the timer wheel"
+        #endif
+        #if     (OS_TMR_HWHEEL_BITS < 1) || (OS_TMR_HWHEEL_BITS > 8)
+        #error  "OS_CFG.H, OS_TMR_HWHEEL_BITS should be between 1 and 8"
+        #endif
+        #if     (OS_TMR_HWHEEL_LEVELS < 2) || ((OS_TMR_HWHEEL_BITS * (OS_TMR_HWHEEL_LEVELS - 1)) >= 32)
+        #error  "OS_CFG.H, OS_TMR_HWHEEL_LEVELS should be at least 2 and the levels must fit in 32 bits"
+        #endif
+    #endif
 #endif
 
 
@@ -1841,6 +2735,132 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TIME_TICK_HOOK_EN: Allows you to include the code for OSTimeTickHook() or not"
 #endif
 
+
+#ifndef OS_SCHED_BITMAP_EN
+#error  "OS_CFG.H, Missing OS_SCHED_BITMAP_EN: Find the highest priority task with a bit scan"
+#endif
+
+
+#ifndef OS_RR_EN
+#error  "OS_CFG.H, Missing OS_RR_EN: Allow several tasks per priority, time sliced"
+#else
+    #if     OS_RR_EN > 0
+        #ifndef OS_RR_QUANTA
+        #error  "OS_CFG.H, Missing OS_RR_QUANTA: Default time slice, in ticks"
+        #endif
+        #if     OS_RR_QUANTA == 0
+        #error  "OS_CFG.H, OS_RR_QUANTA must be > 0"
+        #endif
+        #if     OS_SCHED_BITMAP_EN == 0
+        #error  "OS_CFG.H, OS_RR_EN requires OS_SCHED_BITMAP_EN"
+        #endif
+    #endif
+#endif
+
+
+#ifndef OS_EDF_EN
+#error  "OS_CFG.H, Missing OS_EDF_EN: Earliest-deadline-first among the tasks in a priority band"
+#else
+    #if     OS_EDF_EN > 0
+        #if     !defined(OS_EDF_PRIO_HI) || !defined(OS_EDF_PRIO_LO)
+        #error  "OS_CFG.H, Missing OS_EDF_PRIO_HI or OS_EDF_PRIO_LO: Priority band of the EDF tasks"
+        #endif
+        #if     OS_EDF_PRIO_HI > OS_EDF_PRIO_LO
+        #error  "OS_CFG.H, OS_EDF_PRIO_HI must be <= OS_EDF_PRIO_LO"
+        #endif
+        #if     OS_EDF_PRIO_LO >= OS_LOWEST_PRIO
+        #error  "OS_CFG.H, OS_EDF_PRIO_LO must be < OS_LOWEST_PRIO"
+        #endif
+        #if     OS_SCHED_BITMAP_EN == 0
+        #error  "OS_CFG.H, OS_EDF_EN requires OS_SCHED_BITMAP_EN"
+        #endif
+    #endif
+#endif
+
+
+#ifndef OS_ISR_DEFER_EN
+#error  "OS_CFG.H, Missing OS_ISR_DEFER_EN: Include code for OSIntDefer() and the defer task"
+#else
+    #if     OS_ISR_DEFER_EN > 0
+        #if     !defined(OS_ISR_DEFER_SIZE) || (OS_ISR_DEFER_SIZE == 0)
+        #error  "OS_CFG.H, Missing OS_ISR_DEFER_SIZE: Number of deferred posts, must be > 0"
+        #endif
+        #ifndef OS_TASK_DEFER_PRIO
+        #error  "OS_CFG.H, Missing OS_TASK_DEFER_PRIO: Priority of the defer task"
+        #endif
+        #if     OS_TASK_DEFER_PRIO >= (OS_LOWEST_PRIO - 1)
+        #error  "OS_CFG.H, OS_TASK_DEFER_PRIO must be < OS_LOWEST_PRIO - 1"
+        #endif
+        #if     (OS_TMR_EN > 0) && (OS_TASK_DEFER_PRIO == OS_TASK_TMR_PRIO)
+        #error  "OS_CFG.H, OS_TASK_DEFER_PRIO must differ from OS_TASK_TMR_PRIO"
+        #endif
+        #if     !defined(OS_TASK_DEFER_STK_SIZE) || (OS_TASK_DEFER_STK_SIZE == 0)
+        #error  "OS_CFG.H, Missing OS_TASK_DEFER_STK_SIZE: Stack size of the defer task"
+        #endif
+    #endif
+#endif
+
+
+#ifndef OS_IDLE_JOB_EN
+#error  "OS_CFG.H, Missing OS_IDLE_JOB_EN: Include code for the idle task jobs"
+#else
+    #if     OS_IDLE_JOB_EN > 0
+        #if     !defined(OS_MAX_IDLE_JOBS) || (OS_MAX_IDLE_JOBS == 0) || (OS_MAX_IDLE_JOBS > 255)
+        #error  "OS_CFG.H, OS_MAX_IDLE_JOBS must be between 1 and 255"
+        #endif
+    #endif
+#endif
+
+
+#ifndef OS_TASK_NOTIFY_EN
+#error  "OS_CFG.H, Missing OS_TASK_NOTIFY_EN: Include code for OSTaskNotify() and OSTaskNotifyPend()"
+#endif
+
+
+#ifndef OS_TASK_PERIODIC_EN
+#error  "OS_CFG.H, Missing OS_TASK_PERIODIC_EN: Include code for OSTaskCreatePeriodic()"
+#else
+    #if     (OS_TASK_PERIODIC_EN > 0) && (OS_TIME_DLY_UNTIL_EN == 0)
+    #error  "OS_CFG.H, OS_TASK_PERIODIC_EN requires OS_TIME_DLY_UNTIL_EN"
+    #endif
+#endif
+
+
+#ifndef OS_PREEMPT_THRESH_EN
+#error  "OS_CFG.H, Missing OS_PREEMPT_THRESH_EN: Per-task preemption threshold"
+#else
+    #if     OS_PREEMPT_THRESH_EN > 0
+        #if     OS_SCHED_BITMAP_EN == 0
+        #error  "OS_CFG.H, OS_PREEMPT_THRESH_EN requires OS_SCHED_BITMAP_EN"
+        #endif
+        #if     (OS_RR_EN > 0) || (OS_EDF_EN > 0)
+        #error  "OS_CFG.H, OS_PREEMPT_THRESH_EN cannot be used with OS_RR_EN or OS_EDF_EN"
+        #endif
+    #endif
+#endif
+
+
+#ifndef OS_TICK_LIST_EN
+#error  "OS_CFG.H, Missing OS_TICK_LIST_EN: Keep task delays and timeouts in a delta list"
+#endif
+
+
+#ifndef OS_TICKLESS_EN
+#error  "OS_CFG.H, Missing OS_TICKLESS_EN: Stop the periodic tick while the CPU is idle"
+#else
+    #if     OS_TICKLESS_EN > 0
+        #if     OS_TICK_LIST_EN == 0
+        #error  "OS_CFG.H, OS_TICKLESS_EN requires OS_TICK_LIST_EN"
+        #endif
+        #ifndef OS_TICKLESS_MAX_TICKS
+        #error  "OS_CFG.H, Missing OS_TICKLESS_MAX_TICKS: Longest idle period, in ticks"
+        #endif
+        #if     OS_TICKLESS_MAX_TICKS > 65535u
+        #error  "OS_CFG.H, OS_TICKLESS_MAX_TICKS must be <= 65535"
+        #endif
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                         SAFETY CRITICAL USE
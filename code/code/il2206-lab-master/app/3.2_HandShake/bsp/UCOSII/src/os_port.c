@@ -0,0 +1,427 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                          STATE PORT MANAGEMENT
+*
+* File    : OS_PORT.C
+* Version : V2.86
+*
+* A state port holds the latest value of a piece of state (a sensor reading, a switch, a set point) that
+* ONE writer updates and any number of readers sample.  A write replaces the value, there is no queue, so
+* a reader never has to drain old values and never waits for a value to be consumed.  Each write adds one
+* to the version of the port; readers get the version with the value and can wait, in OSPortPend(), for
+* a version other than the one they last saw.
+*
+* The value is copied in and out of the port, so that the writer may reuse its variable at once.  The port
+* keeps two copies: write number N goes to OSPortBuf[N & 1], the copy that readers are NOT directed to
+* until OSPortVer becomes N.  OSPortWr tells readers when a write has started on the copy they are
+* reading, which only happens if the writer ran twice during one read.  The reader then copies the value
+* again with interrupts disabled, so that a read is never retried more than once.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_PORT_EN > 0) && (OS_MAX_PORTS > 0)
+/*
+*********************************************************************************************************
+*                                          CREATE A STATE PORT
+*
+* Description: This function creates a state port.
+*
+* Arguments  : size    is the size of the value, in bytes, up to OS_PORT_DATA_SIZE.
+*
+*              pinit   is a pointer to the initial value, version 0 of the port, or a NULL pointer for a
+*                      value of all zeros.
+*
+*              opt     OS_PORT_OPT_NONE  readers sample the port with OSPortRead()
+*                      OS_PORT_OPT_PEND  readers may also wait for a new version in OSPortPend(), which takes
+*                                        an OS_EVENT for the list of waiting tasks
+*
+*              perr    is a pointer to an error code and can be:
+*                      OS_ERR_NONE           the port was created
+*                      OS_ERR_CREATE_ISR     if called from an ISR
+*                      OS_ERR_PORT_SIZE      if 'size' is 0 or larger than OS_PORT_DATA_SIZE
+*                      OS_ERR_INVALID_OPT    if 'opt' is invalid
+*                      OS_ERR_PORT_DEPLETED  if there is no free port, or no OS_EVENT for OS_PORT_OPT_PEND
+*
+* Returns    : A pointer to the port, or NULL on error.
+*********************************************************************************************************
+*/
+
+OS_PORT  *OSPortCreate (INT16U size, void *pinit, INT8U opt, INT8U *perr)
+{
+    OS_PORT   *pport;
+    OS_EVENT  *pevent;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((OS_PORT *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE from an ISR             */
+        return ((OS_PORT *)0);
+    }
+    if ((size == 0) || (size > OS_PORT_DATA_SIZE)) {
+        *perr = OS_ERR_PORT_SIZE;
+        return ((OS_PORT *)0);
+    }
+    if ((opt != OS_PORT_OPT_NONE) && (opt != OS_PORT_OPT_PEND)) {
+        *perr = OS_ERR_INVALID_OPT;
+        return ((OS_PORT *)0);
+    }
+    pevent = (OS_EVENT *)0;
+    OS_ENTER_CRITICAL();
+    pport  = OSPortFreeList;                               /* Get next free port                       */
+    if ((pport != (OS_PORT *)0) && (opt == OS_PORT_OPT_PEND)) {
+        pevent = OSEventFreeList;                          /* ... and an ECB for its waiting tasks     */
+        if (pevent == (OS_EVENT *)0) {
+            pport = (OS_PORT *)0;
+        } else {
+            OSEventFreeList = (OS_EVENT *)pevent->OSEventPtr;
+        }
+    }
+    if (pport != (OS_PORT *)0) {
+        OSPortFreeList = pport->OSPortPtr;
+    }
+    OS_EXIT_CRITICAL();
+    if (pport == (OS_PORT *)0) {
+        *perr = OS_ERR_PORT_DEPLETED;
+        return ((OS_PORT *)0);
+    }
+    if (pevent != (OS_EVENT *)0) {
+        pevent->OSEventType    = OS_EVENT_TYPE_PORT;
+        pevent->OSEventCnt     = 0;
+        pevent->OSEventPtr     = (void *)pport;            /* Back link to the port                    */
+#if OS_EVENT_NAME_SIZE > 1
+        pevent->OSEventName[0] = '?';                      /* Unknown name                             */
+        pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+        OS_EventWaitListInit(pevent);                      /* Nobody waiting for a new version         */
+    }
+    OS_MemClr((INT8U *)&pport->OSPortBuf[0][0], sizeof(pport->OSPortBuf));
+    if (pinit != (void *)0) {
+        OS_MemCopy((INT8U *)&pport->OSPortBuf[0][0], (INT8U *)pinit, size);
+    }
+    pport->OSPortPtr   = (OS_PORT *)0;
+    pport->OSPortEvent = pevent;
+    pport->OSPortVer   = 0;
+    pport->OSPortWr    = 0;
+    pport->OSPortSize  = size;
+    *perr              = OS_ERR_NONE;
+    return (pport);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          DELETE A STATE PORT
+*
+* Description: This function deletes a state port.  Neither its writer nor its readers may use it any more.
+*
+* Arguments  : pport  is a pointer to the port.
+*
+*              perr   is a pointer to an error code and can be:
+*                     OS_ERR_NONE            the port was deleted
+*                     OS_ERR_DEL_ISR         if called from an ISR
+*                     OS_ERR_PORT_INVALID    if 'pport' is not a port in use
+*                     OS_ERR_TASK_WAITING    if tasks wait in OSPortPend()
+*
+* Returns    : NULL if the port was deleted, else 'pport'.
+*********************************************************************************************************
+*/
+
+OS_PORT  *OSPortDel (OS_PORT *pport, INT8U *perr)
+{
+    OS_EVENT  *pevent;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (pport);
+    }
+    if (pport == (OS_PORT *)0) {                           /* Validate 'pport'                         */
+        *perr = OS_ERR_PORT_INVALID;
+        return (pport);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (pport);
+    }
+    OS_ENTER_CRITICAL();
+    if (pport->OSPortSize == 0) {                          /* Port already deleted or never created    */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PORT_INVALID;
+        return (pport);
+    }
+    pevent = pport->OSPortEvent;
+    if (pevent != (OS_EVENT *)0) {
+        if (pevent->OSEventGrp != 0) {                     /* See if any task waits for a new version  */
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_TASK_WAITING;
+            return (pport);
+        }
+#if OS_EVENT_NAME_SIZE > 1
+        pevent->OSEventName[0] = '?';                      /* Unknown name                             */
+        pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+        pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+        pevent->OSEventPtr     = OSEventFreeList;          /* Return Event Control Block to free list  */
+        OSEventFreeList        = pevent;
+    }
+    pport->OSPortSize  = 0;                                /* Return the port to the free list         */
+    pport->OSPortEvent = (OS_EVENT *)0;
+    pport->OSPortPtr   = OSPortFreeList;
+    OSPortFreeList     = pport;
+    OS_EXIT_CRITICAL();
+    *perr              = OS_ERR_NONE;
+    return ((OS_PORT *)0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          WRITE TO A STATE PORT
+*
+* Description: This function replaces the value of the port and makes it the next version.  It does not
+*              disable interrupts unless tasks wait in OSPortPend(), in which case all of them are made
+*              ready.  It can be called from an ISR.
+*
+* Arguments  : pport  is a pointer to the port.
+*
+*              pval   is a pointer to the new value, 'size' bytes.
+*
+* Returns    : OS_ERR_NONE           the value was written
+*              OS_ERR_PORT_INVALID   if 'pport' is a NULL pointer
+*              OS_ERR_POST_NULL_PTR  if 'pval' is a NULL pointer
+*
+* Note(s)    : 1) A port has a single writer.  Several writers, such as a task and an ISR, must serialize
+*                 among themselves.
+*********************************************************************************************************
+*/
+
+INT8U  OSPortWrite (OS_PORT *pport, void *pval)
+{
+    OS_EVENT  *pevent;
+    INT32U     ver;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pport == (OS_PORT *)0) {                           /* Validate 'pport'                         */
+        return (OS_ERR_PORT_INVALID);
+    }
+    if (pval == (void *)0) {                               /* Validate 'pval'                          */
+        return (OS_ERR_POST_NULL_PTR);
+    }
+#endif
+    ver             = pport->OSPortVer + 1;
+    pport->OSPortWr = ver;                                 /* Readers of OSPortBuf[ver & 1] must retry */
+    OS_CPU_BARRIER();
+    OS_MemCopy((INT8U *)&pport->OSPortBuf[ver & 1][0], (INT8U *)pval, pport->OSPortSize);
+    OS_CPU_BARRIER();                                      /* Value written before it is published     */
+    pport->OSPortVer = ver;
+    OS_CPU_BARRIER();                                      /* Published before the wait list is read   */
+    pevent = pport->OSPortEvent;
+    if ((pevent != (OS_EVENT *)0) && (pevent->OSEventGrp != 0)) {
+        OS_ENTER_CRITICAL();
+        while (pevent->OSEventGrp != 0) {                  /* Ready ALL tasks waiting for a new version */
+            (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_PORT, OS_STAT_PEND_OK);
+        }
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                        /* Find highest priority task ready to run  */
+    }
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          READ A STATE PORT
+*
+* Description: This function copies the latest value of the port.  It never waits: it disables interrupts
+*              only in the rare case described at the top of this file.  It can be called from an ISR.
+*
+* Arguments  : pport  is a pointer to the port.
+*
+*              pval   is a pointer to where the value is copied, 'size' bytes.
+*
+* Returns    : The version of the value, 0 for the initial value.  0 also if 'pport' or 'pval' is a NULL
+*              pointer.
+*********************************************************************************************************
+*/
+
+INT32U  OSPortRead (OS_PORT *pport, void *pval)
+{
+    INT32U     ver;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if ((pport == (OS_PORT *)0) || (pval == (void *)0)) {  /* Validate 'pport' and 'pval'              */
+        return (0);
+    }
+#endif
+    ver = pport->OSPortVer;
+    OS_CPU_BARRIER();                                      /* Value read after its version             */
+    OS_MemCopy((INT8U *)pval, (INT8U *)&pport->OSPortBuf[ver & 1][0], pport->OSPortSize);
+    OS_CPU_BARRIER();
+    if ((pport->OSPortWr - ver) >= 2) {                    /* Copy overwritten by write 'ver + 2'      */
+        OS_ENTER_CRITICAL();                               /* The writer cannot run, and its current   */
+        ver = pport->OSPortVer;                            /* ... write, if any, is to the other copy  */
+        OS_MemCopy((INT8U *)pval, (INT8U *)&pport->OSPortBuf[ver & 1][0], pport->OSPortSize);
+        OS_EXIT_CRITICAL();
+    }
+    return (ver);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   WAIT FOR A NEW VERSION OF A STATE PORT
+*
+* Description: This function waits until the version of the port is other than 'ver', then copies the
+*              value.  It returns at once if the port was written since the caller saw version 'ver'.  The
+*              port must have been created with OS_PORT_OPT_PEND.
+*
+* Arguments  : pport    is a pointer to the port.
+*
+*              pval     is a pointer to where the value is copied, 'size' bytes.
+*
+*              ver      is the version the caller has, as returned by a previous OSPortRead() or OSPortPend().
+*
+*              timeout  is an optional timeout period (in clock ticks).  If non-zero, your task will wait
+*                       for a new version up to the amount of time specified by this argument.  If you
+*                       specify 0, however, your task will wait forever.
+*
+*              perr     is a pointer to an error code and can be:
+*                       OS_ERR_NONE          a new version was copied
+*                       OS_ERR_TIMEOUT       no new version within 'timeout'; the value is still copied
+*                       OS_ERR_PEND_ISR      if called from an ISR
+*                       OS_ERR_PEND_LOCKED   if called with the scheduler locked and no new version
+*                       OS_ERR_PORT_INVALID  if 'pport' is a NULL pointer
+*                       OS_ERR_PORT_NO_PEND  if the port was created without OS_PORT_OPT_PEND
+*                       OS_ERR_PDATA_NULL    if 'pval' is a NULL pointer
+*
+* Returns    : The version of the value copied, else 'ver'.
+*********************************************************************************************************
+*/
+
+INT32U  OSPortPend (OS_PORT *pport, void *pval, INT32U ver, INT16U timeout, INT8U *perr)
+{
+    OS_EVENT  *pevent;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (ver);
+    }
+    if (pport == (OS_PORT *)0) {                           /* Validate 'pport'                         */
+        *perr = OS_ERR_PORT_INVALID;
+        return (ver);
+    }
+    if (pval == (void *)0) {                               /* Validate 'pval'                          */
+        *perr = OS_ERR_PDATA_NULL;
+        return (ver);
+    }
+#endif
+    pevent = pport->OSPortEvent;
+    if (pevent == (OS_EVENT *)0) {
+        *perr = OS_ERR_PORT_NO_PEND;
+        return (ver);
+    }
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_PEND_ISR;                           /* ... can't PEND from an ISR               */
+        return (ver);
+    }
+    *perr = OS_ERR_NONE;
+    OS_ENTER_CRITICAL();
+    if (pport->OSPortVer == ver) {                         /* Nothing new, must wait                   */
+        if (OSLockNesting > 0) {                           /* See if called with scheduler locked ...  */
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_PEND_LOCKED;                    /* ... can't PEND when locked               */
+            return (ver);
+        }
+        OSTCBCur->OSTCBStat     |= OS_STAT_PORT;           /* Pend on the port                         */
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+        OSTCBCur->OSTCBDly       = timeout;                /* Store pend timeout in TCB                */
+#if OS_TICK_LIST_EN > 0
+        OS_TickListInsert(OSTCBCur);                       /* Link TCB into the tick list              */
+#endif
+        OS_EventTaskWait(pevent);                          /* Suspend task until written or timeout    */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                        /* Find next highest priority task ready    */
+        OS_ENTER_CRITICAL();
+        switch (OSTCBCur->OSTCBStatPend) {                 /* See if we timed-out or aborted           */
+            case OS_STAT_PEND_OK:
+                 break;
+
+            case OS_STAT_PEND_TO:
+            default:
+                 OS_EventTaskRemove(OSTCBCur, pevent);
+                 *perr = OS_ERR_TIMEOUT;                   /* Indicate that no version came within TO  */
+                 break;
+        }
+        OSTCBCur->OSTCBStat          =  OS_STAT_RDY;       /* Set   task  status to ready              */
+        OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;   /* Clear pend  status                       */
+        OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;     /* Clear event pointers                     */
+#if (OS_EVENT_MULTI_EN > 0)
+        OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    }
+    OS_EXIT_CRITICAL();
+    return (OSPortRead(pport, pval));
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      INITIALIZE THE STATE PORTS
+*
+* Description: This function is called by OSInit() to chain the port control blocks into the free list.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_PortInit (void)
+{
+    INT16U  i;
+
+
+    OS_MemClr((INT8U *)&OSPortTbl[0], sizeof(OSPortTbl));  /* Clear the port table                     */
+    for (i = 0; i < (OS_MAX_PORTS - 1); i++) {             /* Init. list of free ports                 */
+        OSPortTbl[i].OSPortPtr = &OSPortTbl[i + 1];
+    }
+    OSPortTbl[OS_MAX_PORTS - 1].OSPortPtr = (OS_PORT *)0;
+    OSPortFreeList = &OSPortTbl[0];
+}
+#endif                                                     /* OS_PORT_EN                               */
@@ -249,6 +249,11 @@ OS_EVENT  *OSQDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 #if OS_EVENT_NAME_SIZE > 1
                  pevent->OSEventName[0] = '?';             /* Unknown name                             */
                  pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+                 if (pevent->OSEventWaitSet != (OS_WAITSET *)0) {
+                     OS_WaitSetUnlink(pevent);             /* Leave the wait-set first                 */
+                 }
 #endif
                  pq                     = (OS_Q *)pevent->OSEventPtr;  /* Return OS_Q to free list     */
                  pq->OSQPtr             = OSQFreeList;
@@ -274,6 +279,11 @@ OS_EVENT  *OSQDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 #if OS_EVENT_NAME_SIZE > 1
              pevent->OSEventName[0] = '?';                 /* Unknown name                             */
              pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+             if (pevent->OSEventWaitSet != (OS_WAITSET *)0) {
+                 OS_WaitSetUnlink(pevent);                 /* Leave the wait-set first                 */
+             }
 #endif
              pq                     = (OS_Q *)pevent->OSEventPtr;   /* Return OS_Q to free list        */
              pq->OSQPtr             = OSQFreeList;
@@ -431,6 +441,9 @@ void  *OSQPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     OSTCBCur->OSTCBStat     |= OS_STAT_Q;        /* Task will have to pend for a message to be posted  */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly       = timeout;          /* Load timeout into TCB                              */
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur);                 /* Link TCB into the tick list                        */
+#endif
     OS_EventTaskWait(pevent);                    /* Suspend task until event or timeout occurs         */
     OS_EXIT_CRITICAL();
     OS_Sched();                                  /* Find next highest priority task ready to run       */
@@ -547,6 +560,147 @@ INT8U  OSQPendAbort (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 }
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 PEND ON A QUEUE FOR SEVERAL MESSAGES
+*
+* Description: This function takes up to 'max' messages from a queue in one call.  If the queue is empty,
+*              the calling task waits for a message.  Once woken, it also takes the messages that were
+*              queued behind the one handed to it, so that a burst sent with OSQPostMulti() is received
+*              with a single wake-up.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsgs         is a pointer to an array of at least 'max' entries, where the messages are
+*                            returned, oldest first.
+*
+*              max           is the largest number of messages to take.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a message to arrive at the queue up to the amount of time
+*                            specified by this argument.  If you specify 0, however, your task will wait
+*                            forever at the specified queue or, until a message arrives.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and messages were received
+*                            OS_ERR_TIMEOUT      No message was received within the specified timeout.
+*                            OS_ERR_PEND_ABORT   The wait on the queue was aborted.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a queue
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_PDATA_NULL   If 'pmsgs' is a NULL pointer
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR
+*                            OS_ERR_PEND_LOCKED  If you called this function with the scheduler is locked
+*
+* Returns    : The number of messages placed in 'pmsgs', 0 if none.
+*
+* Note(s)    : Interrupts stay disabled while the messages are copied, for a time proportional to their
+*              number.
+*********************************************************************************************************
+*/
+
+#if OS_Q_MULTI_EN > 0
+INT16U  OSQPendMulti (OS_EVENT *pevent, void **pmsgs, INT16U max, INT16U timeout, INT8U *perr)
+{
+    OS_Q      *pq;
+    INT16U     n;
+    INT16U     cnt;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                    /* Validate 'perr'                                    */
+        return (0);
+    }
+    if (pevent == (OS_EVENT *)0) {               /* Validate 'pevent'                                  */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pmsgs == (void **)0) {                   /* Validate 'pmsgs'                                   */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {/* Validate event block type                          */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
+        *perr = OS_ERR_PEND_ISR;                 /* ... can't PEND from an ISR                         */
+        return (0);
+    }
+    if (OSLockNesting > 0) {                     /* See if called with scheduler locked ...            */
+        *perr = OS_ERR_PEND_LOCKED;              /* ... can't PEND when locked                         */
+        return (0);
+    }
+    *perr = OS_ERR_NONE;
+    if (max == 0) {
+        return (0);
+    }
+    n = 0;
+    OS_ENTER_CRITICAL();
+    pq = (OS_Q *)pevent->OSEventPtr;             /* Point at queue control block                       */
+    if (pq->OSQEntries == 0) {                   /* Task will have to pend for a message to be posted  */
+        OSTCBCur->OSTCBStat     |= OS_STAT_Q;
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+        OSTCBCur->OSTCBDly       = timeout;      /* Load timeout into TCB                              */
+#if OS_TICK_LIST_EN > 0
+        OS_TickListInsert(OSTCBCur);             /* Link TCB into the tick list                        */
+#endif
+        OS_EventTaskWait(pevent);                /* Suspend task until event or timeout occurs         */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                              /* Find next highest priority task ready to run       */
+        OS_ENTER_CRITICAL();
+        switch (OSTCBCur->OSTCBStatPend) {            /* See if we timed-out or aborted                */
+            case OS_STAT_PEND_OK:                     /* First message was handed over in the TCB      */
+                 pmsgs[0] = OSTCBCur->OSTCBMsg;
+                 n        = 1;
+                 break;
+
+            case OS_STAT_PEND_ABORT:
+                *perr     = OS_ERR_PEND_ABORT;        /* Indicate that we aborted                      */
+                 break;
+
+            case OS_STAT_PEND_TO:
+            default:
+                 OS_EventTaskRemove(OSTCBCur, pevent);
+                *perr     = OS_ERR_TIMEOUT;           /* Indicate that we didn't get event within TO   */
+                 break;
+        }
+        OSTCBCur->OSTCBStat          =  OS_STAT_RDY;  /* Set   task  status to ready                   */
+        OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                        */
+        OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                      */
+#if (OS_EVENT_MULTI_EN > 0)
+        OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+        OSTCBCur->OSTCBMsg           = (void      *)0;    /* Clear  received message                   */
+        if (n == 0) {
+            OS_EXIT_CRITICAL();
+            return (0);
+        }
+    }
+    cnt = max - n;                               /* Take what is queued, up to 'max' messages          */
+    if (cnt > pq->OSQEntries) {
+        cnt = pq->OSQEntries;
+    }
+    pq->OSQEntries -= cnt;
+    while (cnt > 0) {
+        pmsgs[n++] = *pq->OSQOut++;              /* Extract oldest message from the queue              */
+        if (pq->OSQOut == pq->OSQEnd) {          /* Wrap OUT pointer if we are at the end of the queue */
+            pq->OSQOut = pq->OSQStart;
+        }
+        cnt--;
+    }
+    OS_EXIT_CRITICAL();
+    return (n);                                  /* Return number of messages received                 */
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -603,6 +757,13 @@ INT8U  OSQPost (OS_EVENT *pevent, void *pmsg)
     if (pq->OSQIn == pq->OSQEnd) {                     /* Wrap IN ptr if we are at end of queue        */
         pq->OSQIn = pq->OSQStart;
     }
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+    if ((pevent->OSEventWaitSet != (OS_WAITSET *)0) && (OS_WaitSetSignal(pevent) == OS_TRUE)) {
+        OS_EXIT_CRITICAL();                           /* Task waiting on the wait-set made ready       */
+        OS_Sched();
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -666,6 +827,13 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
     pq->OSQOut--;
     *pq->OSQOut = pmsg;                               /* Insert message into queue                     */
     pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+    if ((pevent->OSEventWaitSet != (OS_WAITSET *)0) && (OS_WaitSetSignal(pevent) == OS_TRUE)) {
+        OS_EXIT_CRITICAL();                           /* Task waiting on the wait-set made ready       */
+        OS_Sched();
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -673,6 +841,108 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                     POST SEVERAL MESSAGES TO A QUEUE
+*
+* Description: This function sends up to 'n' messages to a queue in one call, in order.  Each task waiting
+*              on the queue is handed one message, the HPT first; the rest are queued.  The scheduler is
+*              called at most once, so a single consumer is woken once for the whole burst and takes the
+*              queued messages with OSQPendMulti().
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsgs         is a pointer to an array of 'n' messages to send.
+*
+*              n             is the number of messages to send.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE           The call was successful and all the messages were sent
+*                            OS_ERR_Q_FULL         If the queue filled up before all the messages were sent
+*                            OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
+*                            OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*                            OS_ERR_POST_NULL_PTR  If 'pmsgs' is a NULL pointer
+*
+* Returns    : The number of messages sent: the first ones of 'pmsgs'.
+*
+* Note(s)    : 1) The messages themselves may be NULL pointers, as with OSQPost().
+*
+*              2) Interrupts stay disabled while the messages are copied, for a time proportional to their
+*                 number.
+*********************************************************************************************************
+*/
+
+#if OS_Q_MULTI_EN > 0
+INT16U  OSQPostMulti (OS_EVENT *pevent, void **pmsgs, INT16U n, INT8U *perr)
+{
+    OS_Q      *pq;
+    INT16U     i;
+    INT16U     cnt;
+    BOOLEAN    sched;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return (0);
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pmsgs == (void **)0) {                        /* Validate 'pmsgs'                              */
+        *perr = OS_ERR_POST_NULL_PTR;
+        return (0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {     /* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    i     = 0;
+    sched = OS_FALSE;
+    OS_ENTER_CRITICAL();
+    while ((i < n) && (pevent->OSEventGrp != 0)) {    /* Hand one message to each task waiting         */
+        (void)OS_EventTaskRdy(pevent, pmsgs[i], OS_STAT_Q, OS_STAT_PEND_OK);
+        i++;
+        sched = OS_TRUE;
+    }
+    pq  = (OS_Q *)pevent->OSEventPtr;                 /* Point to queue control block                  */
+    cnt = n - i;                                      /* Queue the rest, as much as fits               */
+    if (cnt > (pq->OSQSize - pq->OSQEntries)) {
+        cnt = pq->OSQSize - pq->OSQEntries;
+    }
+    pq->OSQEntries += cnt;                            /* Update the nbr of entries in the queue        */
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+    if ((cnt > 0) && (pevent->OSEventWaitSet != (OS_WAITSET *)0) && (OS_WaitSetSignal(pevent) == OS_TRUE)) {
+        sched = OS_TRUE;                              /* Task waiting on the wait-set made ready       */
+    }
+#endif
+    while (cnt > 0) {
+        *pq->OSQIn++ = pmsgs[i++];                    /* Insert message into queue                     */
+        if (pq->OSQIn == pq->OSQEnd) {                /* Wrap IN ptr if we are at end of queue         */
+            pq->OSQIn = pq->OSQStart;
+        }
+        cnt--;
+    }
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+    if (i < n) {
+        *perr = OS_ERR_Q_FULL;
+    } else {
+        *perr = OS_ERR_NONE;
+    }
+    return (i);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                        POST MESSAGE TO A QUEUE
 *
 * Description: This function sends a message to a queue.  This call has been added to reduce code size
@@ -751,6 +1021,15 @@ INT8U  OSQPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
         }
     }
     pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+    if ((pevent->OSEventWaitSet != (OS_WAITSET *)0) && (OS_WaitSetSignal(pevent) == OS_TRUE)) {
+        OS_EXIT_CRITICAL();                           /* Task waiting on the wait-set made ready       */
+        if ((opt & OS_POST_OPT_NO_SCHED) == 0) {
+            OS_Sched();
+        }
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -779,7 +1058,10 @@ INT8U  OSQQuery (OS_EVENT *pevent, OS_Q_DATA *p_q_data)
 {
     OS_Q      *pq;
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    INT32U    *psrc;
+    INT32U    *pdest;
+#elif OS_LOWEST_PRIO <= 63
     INT8U     *psrc;
     INT8U     *pdest;
 #else
@@ -200,6 +200,11 @@ OS_EVENT  *OSSemDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 #if OS_EVENT_NAME_SIZE > 1
                  pevent->OSEventName[0] = '?';             /* Unknown name                             */
                  pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+                 if (pevent->OSEventWaitSet != (OS_WAITSET *)0) {
+                     OS_WaitSetUnlink(pevent);             /* Leave the wait-set first                 */
+                 }
 #endif
                  pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
                  pevent->OSEventPtr     = OSEventFreeList; /* Return Event Control Block to free list  */
@@ -222,6 +227,11 @@ OS_EVENT  *OSSemDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 #if OS_EVENT_NAME_SIZE > 1
              pevent->OSEventName[0] = '?';                 /* Unknown name                             */
              pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+             if (pevent->OSEventWaitSet != (OS_WAITSET *)0) {
+                 OS_WaitSetUnlink(pevent);                 /* Leave the wait-set first                 */
+             }
 #endif
              pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
              pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
@@ -318,6 +328,9 @@ void  OSSemPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     OSTCBCur->OSTCBStat     |= OS_STAT_SEM;           /* Resource not available, pend on semaphore     */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly       = timeout;               /* Store pend timeout in TCB                     */
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur);                      /* Link TCB into the tick list                   */
+#endif
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
@@ -476,6 +489,13 @@ INT8U  OSSemPost (OS_EVENT *pevent)
     }
     if (pevent->OSEventCnt < 65535u) {                /* Make sure semaphore will not overflow         */
         pevent->OSEventCnt++;                         /* Increment semaphore count to register event   */
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+        if ((pevent->OSEventWaitSet != (OS_WAITSET *)0) && (OS_WaitSetSignal(pevent) == OS_TRUE)) {
+            OS_EXIT_CRITICAL();                       /* Task waiting on the wait-set made ready       */
+            OS_Sched();
+            return (OS_ERR_NONE);
+        }
+#endif
         OS_EXIT_CRITICAL();
         return (OS_ERR_NONE);
     }
@@ -506,7 +526,10 @@ INT8U  OSSemPost (OS_EVENT *pevent)
 #if OS_SEM_QUERY_EN > 0
 INT8U  OSSemQuery (OS_EVENT *pevent, OS_SEM_DATA *p_sem_data)
 {
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    INT32U    *psrc;
+    INT32U    *pdest;
+#elif OS_LOWEST_PRIO <= 63
     INT8U     *psrc;
     INT8U     *pdest;
 #else
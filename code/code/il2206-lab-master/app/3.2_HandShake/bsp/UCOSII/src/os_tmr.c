@@ -45,6 +45,7 @@
 
 #define  OS_TMR_LINK_DLY       0
 #define  OS_TMR_LINK_PERIODIC  1
+#define  OS_TMR_LINK_CASCADE   2
 
 /*
 ************************************************************************************************************************
@@ -58,6 +59,23 @@ static  void     OSTmr_Free          (OS_TMR *ptmr);
 static  void     OSTmr_InitTask      (void);
 static  void     OSTmr_Link          (OS_TMR *ptmr, INT8U type);
 static  void     OSTmr_Unlink        (OS_TMR *ptmr);
+#if OS_TMR_HWHEEL_EN > 0
+static  void     OSTmr_Cascade       (void);
+#endif
+#if OS_TICKLESS_EN > 0
+static  void     OSTmr_NextUpdate    (void);
+#endif
+#if OS_TMR_ISR_CALLBACK_EN > 0
+static  void     OSTmr_IsrLink       (OS_TMR *ptmr, INT8U type);
+static  void     OSTmr_IsrUnlink     (OS_TMR *ptmr);
+static  void     OSTmr_IsrSignal     (void);
+#endif
+#if OS_TMR_GRP_EN > 0
+static  void     OSTmr_GrpCallback   (void *ptmr, void *parg);
+#endif
+#if OS_TMR_STATS_EN > 0
+static  void     OSTmr_StatsUpdate   (OS_TMR *ptmr, INT32U late, INT32U start);
+#endif
 static  void     OSTmr_Lock          (void);
 static  void     OSTmr_Unlock        (void);
 static  void     OSTmr_Task          (void   *p_arg);
@@ -83,6 +101,9 @@ static  void     OSTmr_Task          (void   *p_arg);
 *                               OS_TMR_OPT_ONE_SHOT       The timer counts down only once
 *                               OS_TMR_OPT_PERIODIC       The timer counts down and then reloads itself
 *
+*                            and, with OS_TMR_ISR_CALLBACK_EN, may add:
+*                               OS_TMR_OPT_ISR_CALLBACK   The callback is called by OSTmrSignal() (see Note #1)
+*
 *              callback      Is a pointer to a callback function that will be called when the timer expires.  The
 *                               callback function must be declared as follows:
 *
@@ -106,6 +127,11 @@ static  void     OSTmr_Task          (void   *p_arg);
 *
 * Returns    : A pointer to an OS_TMR data structure.  
 *              This is the 'handle' that your application will use to reference the timer created.
+*
+* Note(s)    : 1) OSTmrSignal() is normally called from the tick ISR, so an OS_TMR_OPT_ISR_CALLBACK callback runs in
+*                 interrupt context and may only use the services allowed in an ISR (OSSemPost(), OSMboxPost(), ...).
+*                 A task it readies runs at the end of the ISR, without going through OSTmr_Task().  The callback must
+*                 not call the other OSTmr...() services.
 ************************************************************************************************************************
 */
 
@@ -128,7 +154,11 @@ OS_TMR  *OSTmrCreate (INT32U           dly,
     if (perr == (INT8U *)0) {                               /* Validate arguments                                     */
         return ((OS_TMR *)0);
     }
+#if OS_TMR_ISR_CALLBACK_EN > 0
+    switch (opt & (INT8U)~OS_TMR_OPT_ISR_CALLBACK) {
+#else
     switch (opt) {
+#endif
         case OS_TMR_OPT_PERIODIC:
              if (period == 0) {
                  *perr = OS_ERR_TMR_INVALID_PERIOD;
@@ -165,6 +195,9 @@ OS_TMR  *OSTmrCreate (INT32U           dly,
     ptmr->OSTmrOpt         = opt;
     ptmr->OSTmrCallback    = callback;
     ptmr->OSTmrCallbackArg = callback_arg;
+#if OS_TMR_STATS_EN > 0
+    OS_MemClr((INT8U *)&ptmr->OSTmrStats, sizeof(OS_TMR_STATS));
+#endif
 #if OS_TMR_CFG_NAME_SIZE > 0
     if (pname !=(INT8U *)0) {
         len = OS_StrLen(pname);                             /* Copy timer name                                        */
@@ -387,12 +420,21 @@ INT32U  OSTmrRemainGet (OS_TMR  *ptmr,
     switch (ptmr->OSTmrState) {
         case OS_TMR_STATE_RUNNING:
              remain = ptmr->OSTmrMatch - OSTmrTime;    /* Determine how much time is left to timeout                  */
+#if OS_TMR_ISR_CALLBACK_EN > 0
+             if ((ptmr->OSTmrOpt & OS_TMR_OPT_ISR_CALLBACK) != 0) {
+                 remain = ptmr->OSTmrMatch - OSTmrIsrTime;
+             }
+#endif
              OSTmr_Unlock();
              *perr  = OS_ERR_NONE;
              return (remain);
 
         case OS_TMR_STATE_STOPPED:                     /* It's assumed that the timer has not started yet             */
+#if OS_TMR_ISR_CALLBACK_EN > 0
+             switch (ptmr->OSTmrOpt & (INT8U)~OS_TMR_OPT_ISR_CALLBACK) {
+#else
              switch (ptmr->OSTmrOpt) {
+#endif
                  case OS_TMR_OPT_PERIODIC:
                       if (ptmr->OSTmrDly == 0) {
                           remain = ptmr->OSTmrPeriod;
@@ -695,6 +737,9 @@ BOOLEAN  OSTmrStop (OS_TMR  *ptmr,
 * Description: This function is typically called by the ISR that occurs at the timer tick rate and is used to signal to
 *              OSTmr_Task() that it's time to update the timers.
 *
+*              With OS_TMR_ISR_CALLBACK_EN, the OS_TMR_OPT_ISR_CALLBACK timers are updated here and their callbacks
+*              called directly.  OSTmr_Task() is then only signaled when other timers are running.
+*
 * Arguments  : none
 *
 * Returns    : OS_ERR_NONE         The call was successful and the timer task was signaled.
@@ -713,6 +758,12 @@ INT8U  OSTmrSignal (void)
     INT8U  err;
 
 
+#if OS_TMR_ISR_CALLBACK_EN > 0
+    OSTmr_IsrSignal();
+    if (OSTmrWheelEntries == 0) {                           /* Nothing for the timer task to do, don't wake it up      */
+        return (OS_ERR_NONE);
+    }
+#endif
     err = OSSemPost(OSTmrSemSignal);
     return (err);
 }
@@ -721,171 +772,642 @@ INT8U  OSTmrSignal (void)
 /*$PAGE*/
 /*
 ************************************************************************************************************************
-*                                               ALLOCATE AND FREE A TIMER
+*                                            GET THE STATISTICS OF A TIMER
 *
-* Description: This function is called to allocate a timer.
+* Description: This function is called by your application code to obtain the statistics kept on the callbacks of a
+*              timer: the number of expiries, a histogram of the run times of the callback and a histogram of how many
+*              timer ticks late OSTmr_Task() was in making it.
 *
-* Arguments  : none
+* Arguments  : ptmr          Is a pointer to the timer
 *
-* Returns    : a pointer to a timer if one is available
+*              p_stats       Is a pointer to an OS_TMR_STATS structure that will receive a copy of the statistics
+*
+*              perr          Is a pointer to an error code.  '*perr' will contain one of the following:
+*                               OS_ERR_NONE
+*                               OS_ERR_TMR_INVALID        'ptmr' or 'p_stats' is a NULL pointer
+*                               OS_ERR_TMR_INVALID_TYPE   'ptmr' is not pointing to an OS_TMR
+*                               OS_ERR_TMR_ISR            if the call was made from an ISR
+*                               OS_ERR_TMR_INACTIVE       'ptmr' points to a timer that is not active
+*
+* Returns    : OS_TRUE    if the statistics were copied
+*              OS_FALSE   if an error was detected
+*
+* Note(s)    : 1) The run time is measured with OS_TS_GET() (see OS_CPU.H) around the call to the callback, so it
+*                 includes the time spent in any task or ISR that preempted it.  Without OS_TS_GET(), every callback
+*                 falls into bin 0.
+*              2) Lateness is the number of OSTmrSignal() calls that OSTmr_Task() has yet to handle when it makes the
+*                 callback.  OS_TMR_OPT_ISR_CALLBACK timers are called back from OSTmrSignal() itself and are never
+*                 late.
+*              3) The statistics are cleared by OSTmrCreate() and OSTmrStatsClr(); they are kept across
+*                 OSTmrStop() and OSTmrStart().
 ************************************************************************************************************************
 */
 
-#if OS_TMR_EN > 0
-static  OS_TMR  *OSTmr_Alloc (void)
+#if OS_TMR_STATS_EN > 0
+BOOLEAN  OSTmrStatsGet (OS_TMR        *ptmr,
+                        OS_TMR_STATS  *p_stats,
+                        INT8U         *perr)
 {
-    OS_TMR *ptmr;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register                    */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
 
 
-    if (OSTmrFreeList == (OS_TMR *)0) {
-        return ((OS_TMR *)0);
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {
+        return (OS_FALSE);
     }
-    ptmr            = (OS_TMR *)OSTmrFreeList;
-    OSTmrFreeList   = (OS_TMR *)ptmr->OSTmrNext;
-    ptmr->OSTmrNext = (OS_TCB *)0;
-    ptmr->OSTmrPrev = (OS_TCB *)0;
-    OSTmrUsed++;
-    OSTmrFree--;
-    return (ptmr);
+    if ((ptmr == (OS_TMR *)0) || (p_stats == (OS_TMR_STATS *)0)) {
+        *perr = OS_ERR_TMR_INVALID;
+        return (OS_FALSE);
+    }
+#endif
+    if (ptmr->OSTmrType != OS_TMR_TYPE) {              /* Validate timer structure                                    */
+        *perr = OS_ERR_TMR_INVALID_TYPE;
+        return (OS_FALSE);
+    }
+    if (OSIntNesting > 0) {                            /* See if trying to call from an ISR                           */
+        *perr = OS_ERR_TMR_ISR;
+        return (OS_FALSE);
+    }
+    OSTmr_Lock();
+    if (ptmr->OSTmrState == OS_TMR_STATE_UNUSED) {
+        OSTmr_Unlock();
+        *perr = OS_ERR_TMR_INACTIVE;
+        return (OS_FALSE);
+    }
+    OS_ENTER_CRITICAL();                               /* OS_TMR_OPT_ISR_CALLBACK timers are updated by the tick ISR  */
+    *p_stats = ptmr->OSTmrStats;
+    OS_EXIT_CRITICAL();
+    OSTmr_Unlock();
+    *perr = OS_ERR_NONE;
+    return (OS_TRUE);
 }
 #endif
 
-
+/*$PAGE*/
 /*
 ************************************************************************************************************************
-*                                             RETURN A TIMER TO THE FREE LIST
+*                                           CLEAR THE STATISTICS OF A TIMER
 *
-* Description: This function is called to return a timer object to the free list of timers.
+* Description: This function is called by your application code to restart the statistics of a timer from zero, e.g.
+*              once the system has reached its steady state.
 *
-* Arguments  : ptmr     is a pointer to the timer to free
+* Arguments  : ptmr          Is a pointer to the timer
 *
-* Returns    : none
+*              perr          Is a pointer to an error code.  '*perr' will contain one of the following:
+*                               OS_ERR_NONE
+*                               OS_ERR_TMR_INVALID        'ptmr' is a NULL pointer
+*                               OS_ERR_TMR_INVALID_TYPE   'ptmr' is not pointing to an OS_TMR
+*                               OS_ERR_TMR_ISR            if the call was made from an ISR
+*                               OS_ERR_TMR_INACTIVE       'ptmr' points to a timer that is not active
+*
+* Returns    : OS_TRUE    if the statistics were cleared
+*              OS_FALSE   if an error was detected
 ************************************************************************************************************************
 */
 
-#if OS_TMR_EN > 0
-static  void  OSTmr_Free (OS_TMR *ptmr)
+#if OS_TMR_STATS_EN > 0
+BOOLEAN  OSTmrStatsClr (OS_TMR  *ptmr,
+                        INT8U   *perr)
 {
-    ptmr->OSTmrState       = OS_TMR_STATE_UNUSED;      /* Clear timer object fields                                   */
-    ptmr->OSTmrOpt         = OS_TMR_OPT_NONE;
-    ptmr->OSTmrPeriod      = 0;
-    ptmr->OSTmrMatch       = 0;
-    ptmr->OSTmrCallback    = (OS_TMR_CALLBACK)0;
-    ptmr->OSTmrCallbackArg = (void *)0;
-#if OS_TMR_CFG_NAME_SIZE > 1
-    ptmr->OSTmrName[0]     = '?';                      /* Unknown name                                                */
-    ptmr->OSTmrName[1]     = OS_ASCII_NUL;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register                    */
+    OS_CPU_SR  cpu_sr = 0;
 #endif
 
-    ptmr->OSTmrPrev        = (OS_TCB *)0;              /* Chain timer to free list                                    */
-    ptmr->OSTmrNext        = OSTmrFreeList;
-    OSTmrFreeList          = ptmr;
 
-    OSTmrUsed--;                                       /* Update timer object statistics                              */
-    OSTmrFree++;
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {
+        return (OS_FALSE);
+    }
+    if (ptmr == (OS_TMR *)0) {
+        *perr = OS_ERR_TMR_INVALID;
+        return (OS_FALSE);
+    }
+#endif
+    if (ptmr->OSTmrType != OS_TMR_TYPE) {              /* Validate timer structure                                    */
+        *perr = OS_ERR_TMR_INVALID_TYPE;
+        return (OS_FALSE);
+    }
+    if (OSIntNesting > 0) {                            /* See if trying to call from an ISR                           */
+        *perr = OS_ERR_TMR_ISR;
+        return (OS_FALSE);
+    }
+    OSTmr_Lock();
+    if (ptmr->OSTmrState == OS_TMR_STATE_UNUSED) {
+        OSTmr_Unlock();
+        *perr = OS_ERR_TMR_INACTIVE;
+        return (OS_FALSE);
+    }
+    OS_ENTER_CRITICAL();
+    OS_MemClr((INT8U *)&ptmr->OSTmrStats, sizeof(OS_TMR_STATS));
+    OS_EXIT_CRITICAL();
+    OSTmr_Unlock();
+    *perr = OS_ERR_NONE;
+    return (OS_TRUE);
 }
 #endif
 
 /*$PAGE*/
 /*
 ************************************************************************************************************************
-*                                                    INITIALIZATION
-*                                          INITIALIZE THE FREE LIST OF TIMERS
+*                                                CREATE A TIMER GROUP
 *
-* Description: This function is called by OSInit() to initialize the free list of OS_TMRs.
+* Description: This function is called by your application code to create a timer group.  A group releases all its
+*              members from a single timer: every 'period' timer ticks, each member is called back at its own phase
+*              in the period, in the order of the phases and, for equal phases, in the order the members were added.
+*              Members with a phase of 0 are thus released together from one timer expiry, and members given
+*              different phases can be used to spread the work of the period over several timer ticks.
 *
-* Arguments  : none
+* Arguments  : period        Is the period of the group, in timer ticks.
 *
-* Returns    : none
+*              opt           Specifies either:
+*                               OS_TMR_OPT_NONE           The members are called back by OSTmr_Task()
+*                               OS_TMR_OPT_ISR_CALLBACK   The members are called back by OSTmrSignal() (see Note #1)
+*
+*              pname         Is the name of the timer used by the group (see OSTmrCreate()).
+*
+*              perr          Is a pointer to an error code.  '*perr' will contain one of the following:
+*                               OS_ERR_NONE
+*                               OS_ERR_TMR_INVALID_PERIOD  you specified a period of 0
+*                               OS_ERR_TMR_INVALID_OPT     you specified an invalid option
+*                               OS_ERR_TMR_ISR             if the call was made from an ISR
+*                               OS_ERR_TMR_NON_AVAIL       if there are no free groups or no free timers
+*                               OS_ERR_TMR_NAME_TOO_LONG   if the name is too long to fit
+*
+* Returns    : A pointer to the group, or a NULL pointer if no group was created.
+*
+* Note(s)    : 1) Only allowed with OS_TMR_ISR_CALLBACK_EN; see OSTmrCreate() for what the callbacks may then do.
+*              2) The group takes one timer from the pool of OS_TMR_CFG_MAX timers.
 ************************************************************************************************************************
 */
 
-#if OS_TMR_EN > 0
-void  OSTmr_Init (void)
+#if (OS_TMR_EN > 0) && (OS_TMR_GRP_EN > 0)
+OS_TMR_GRP  *OSTmrGrpCreate (INT32U   period,
+                             INT8U    opt,
+                             INT8U   *pname,
+                             INT8U   *perr)
 {
-#if OS_EVENT_NAME_SIZE > 10
-    INT8U    err;
-#endif
-    INT16U   i;
-    OS_TMR  *ptmr1;
-    OS_TMR  *ptmr2;
+    OS_TMR_GRP  *pgrp;
+    OS_TMR      *ptmr;
+    INT8U        err;
+    INT8U        i;
 
 
-    OS_MemClr((INT8U *)&OSTmrTbl[0],      sizeof(OSTmrTbl));            /* Clear all the TMRs                         */
-    OS_MemClr((INT8U *)&OSTmrWheelTbl[0], sizeof(OSTmrWheelTbl));       /* Clear the timer wheel                      */
-
-    ptmr1 = &OSTmrTbl[0];
-    ptmr2 = &OSTmrTbl[1];
-    for (i = 0; i < (OS_TMR_CFG_MAX - 1); i++) {                        /* Init. list of free TMRs                    */
-        ptmr1->OSTmrType    = OS_TMR_TYPE;
-        ptmr1->OSTmrState   = OS_TMR_STATE_UNUSED;                      /* Indicate that timer is inactive            */
-        ptmr1->OSTmrNext    = (void *)ptmr2;                            /* Link to next timer                         */
-#if OS_TMR_CFG_NAME_SIZE > 1
-        ptmr1->OSTmrName[0] = '?';                                      /* Unknown name                               */
-        ptmr1->OSTmrName[1] = OS_ASCII_NUL;
-#endif
-        ptmr1++;
-        ptmr2++;
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                               /* Validate arguments                                     */
+        return ((OS_TMR_GRP *)0);
     }
-    ptmr1->OSTmrType    = OS_TMR_TYPE;
-    ptmr1->OSTmrState   = OS_TMR_STATE_UNUSED;                          /* Indicate that timer is inactive            */
-    ptmr1->OSTmrNext    = (void *)0;                                    /* Last OS_TMR                                */
-#if OS_TMR_CFG_NAME_SIZE > 1
-    ptmr1->OSTmrName[0] = '?';                                          /* Unknown name                               */
-    ptmr1->OSTmrName[1] = OS_ASCII_NUL;
 #endif
-    OSTmrTime           = 0;
-    OSTmrUsed           = 0;
-    OSTmrFree           = OS_TMR_CFG_MAX;
-    OSTmrFreeList       = &OSTmrTbl[0];
-    OSTmrSem            = OSSemCreate(1);
-    OSTmrSemSignal      = OSSemCreate(0);
-
-#if OS_EVENT_NAME_SIZE > 18
-    OSEventNameSet(OSTmrSem,       (INT8U *)"uC/OS-II TmrLock",   &err);/* Assign names to semaphores                 */
+#if OS_TMR_ISR_CALLBACK_EN > 0
+    if ((opt & (INT8U)~OS_TMR_OPT_ISR_CALLBACK) != OS_TMR_OPT_NONE) {
 #else
-#if OS_EVENT_NAME_SIZE > 10
-    OSEventNameSet(OSTmrSem,       (INT8U *)"OS-TmrLock",         &err);
+    if (opt != OS_TMR_OPT_NONE) {
 #endif
+        *perr = OS_ERR_TMR_INVALID_OPT;
+        return ((OS_TMR_GRP *)0);
+    }
+    ptmr = OSTmrCreate(period, period, (INT8U)(OS_TMR_OPT_PERIODIC | opt), OSTmr_GrpCallback, (void *)0, pname, perr);
+    if (ptmr == (OS_TMR *)0) {                              /* The period is validated here                           */
+        return ((OS_TMR_GRP *)0);
+    }
+    OSTmr_Lock();
+    pgrp = &OSTmrGrpTbl[0];
+    for (i = 0; i < OS_TMR_CFG_GRP_MAX; i++) {              /* Find a free group                                      */
+        if (pgrp->OSTmrGrpTmr == (OS_TMR *)0) {
+            pgrp->OSTmrGrpTmr      = ptmr;
+            pgrp->OSTmrGrpPeriod   = period;
+            pgrp->OSTmrGrpEntries  = 0;
+            pgrp->OSTmrGrpNext     = 0;
+            ptmr->OSTmrCallbackArg = (void *)pgrp;
+            OSTmr_Unlock();
+            return (pgrp);                                  /* '*perr' is the one of OSTmrCreate()                    */
+        }
+        pgrp++;
+    }
+    OSTmr_Unlock();
+    (void)OSTmrDel(ptmr, &err);
+    *perr = OS_ERR_TMR_NON_AVAIL;
+    return ((OS_TMR_GRP *)0);
+}
 #endif
 
-#if OS_EVENT_NAME_SIZE > 18
-    OSEventNameSet(OSTmrSemSignal, (INT8U *)"uC/OS-II TmrSignal", &err);
-#else
-#if OS_EVENT_NAME_SIZE > 10
-    OSEventNameSet(OSTmrSemSignal, (INT8U *)"OS-TmrSig",          &err);
-#endif
-#endif
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                               ADD A MEMBER TO A TIMER GROUP
+*
+* Description: This function adds a member to a stopped timer group.
+*
+* Arguments  : pgrp          Is a pointer to the group.
+*
+*              phase         Is when, in timer ticks after the start of each period, the member is released.  It must be
+*                            smaller than the period of the group.
+*
+*              callback      Is the function to call, declared as:
+*
+*                               void MyCallback (void *pgrp, void *callback_arg);
+*
+*                            or a NULL pointer to post the semaphore 'callback_arg' instead.
+*
+*              callback_arg  Is the argument of 'callback', or the semaphore to post.
+*
+*              perr          Is a pointer to an error code.  '*perr' will contain one of the following:
+*                               OS_ERR_NONE
+*                               OS_ERR_TMR_INVALID         'pgrp' is a NULL pointer
+*                               OS_ERR_TMR_INACTIVE        if the group was not created
+*                               OS_ERR_TMR_ISR             if the call was made from an ISR
+*                               OS_ERR_TMR_INVALID_DLY     'phase' is not smaller than the period
+*                               OS_ERR_TMR_NO_CALLBACK     if neither 'callback' nor 'callback_arg' was given
+*                               OS_ERR_TMR_INVALID_STATE   if the group is running
+*                               OS_ERR_TMR_GRP_FULL        if the group has OS_TMR_CFG_GRP_MEMBERS members already
+*
+* Returns    : OS_TRUE    if the member was added
+*              OS_FALSE   if an error was detected
+************************************************************************************************************************
+*/
 
-    OSTmr_InitTask();
+#if (OS_TMR_EN > 0) && (OS_TMR_GRP_EN > 0)
+BOOLEAN  OSTmrGrpAdd (OS_TMR_GRP       *pgrp,
+                      INT32U            phase,
+                      OS_TMR_CALLBACK   callback,
+                      void             *callback_arg,
+                      INT8U            *perr)
+{
+    OS_TMR_GRP_MEMBER  *pmember;
+    INT8U               i;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                               /* Validate arguments                                     */
+        return (OS_FALSE);
+    }
+    if (pgrp == (OS_TMR_GRP *)0) {
+        *perr = OS_ERR_TMR_INVALID;
+        return (OS_FALSE);
+    }
+    if ((callback == (OS_TMR_CALLBACK)0) && (callback_arg == (void *)0)) {
+        *perr = OS_ERR_TMR_NO_CALLBACK;
+        return (OS_FALSE);
+    }
+#endif
+    if (OSIntNesting > 0) {                                 /* See if trying to call from an ISR                      */
+        *perr = OS_ERR_TMR_ISR;
+        return (OS_FALSE);
+    }
+    OSTmr_Lock();
+    if (pgrp->OSTmrGrpTmr == (OS_TMR *)0) {
+        OSTmr_Unlock();
+        *perr = OS_ERR_TMR_INACTIVE;
+        return (OS_FALSE);
+    }
+    if (phase >= pgrp->OSTmrGrpPeriod) {
+        OSTmr_Unlock();
+        *perr = OS_ERR_TMR_INVALID_DLY;
+        return (OS_FALSE);
+    }
+    if (pgrp->OSTmrGrpTmr->OSTmrState == OS_TMR_STATE_RUNNING) {
+        OSTmr_Unlock();
+        *perr = OS_ERR_TMR_INVALID_STATE;
+        return (OS_FALSE);
+    }
+    if (pgrp->OSTmrGrpEntries >= OS_TMR_CFG_GRP_MEMBERS) {
+        OSTmr_Unlock();
+        *perr = OS_ERR_TMR_GRP_FULL;
+        return (OS_FALSE);
+    }
+    i = pgrp->OSTmrGrpEntries;                              /* Insert after the members of the same or earlier phase  */
+    while ((i > 0) && (pgrp->OSTmrGrpMember[i - 1].OSTmrGrpPhase > phase)) {
+        pgrp->OSTmrGrpMember[i] = pgrp->OSTmrGrpMember[i - 1];
+        i--;
+    }
+    pmember                   = &pgrp->OSTmrGrpMember[i];
+    pmember->OSTmrGrpCallback = callback;
+    pmember->OSTmrGrpArg      = callback_arg;
+    pmember->OSTmrGrpPhase    = phase;
+    pgrp->OSTmrGrpEntries++;
+    OSTmr_Unlock();
+    *perr = OS_ERR_NONE;
+    return (OS_TRUE);
 }
 #endif
 
 /*$PAGE*/
 /*
 ************************************************************************************************************************
-*                                          INITIALIZE THE TIMER MANAGEMENT TASK
+*                                              START OR STOP A TIMER GROUP
 *
-* Description: This function is called by OSTmrInit() to create the timer management task.
+* Description: OSTmrGrpStart() (re)starts a timer group: its first period starts now, so a member of phase 'p' is first
+*              released 'period' + 'p' timer ticks from now.  OSTmrGrpStop() stops it.
 *
-* Arguments  : none
+* Arguments  : pgrp          Is a pointer to the group.
 *
-* Returns    : none
+*              perr          Is a pointer to an error code.  '*perr' will contain one of the following:
+*                               OS_ERR_NONE
+*                               OS_ERR_TMR_INVALID         'pgrp' is a NULL pointer
+*                               OS_ERR_TMR_INACTIVE        if the group was not created
+*                               OS_ERR_TMR_NO_CALLBACK     if the group has no members (OSTmrGrpStart() only)
+*                               OS_ERR_TMR_STOPPED         if the group was already stopped (OSTmrGrpStop() only)
+*                               or the other errors of OSTmrStart() and OSTmrStop()
+*
+* Returns    : OS_TRUE    if the group was started or stopped
+*              OS_FALSE   if an error was detected
 ************************************************************************************************************************
 */
 
-#if OS_TMR_EN > 0
-static  void  OSTmr_InitTask (void)
+#if (OS_TMR_EN > 0) && (OS_TMR_GRP_EN > 0)
+BOOLEAN  OSTmrGrpStart (OS_TMR_GRP  *pgrp,
+                        INT8U       *perr)
 {
-#if OS_TASK_NAME_SIZE > 6
-    INT8U  err;
-#endif
+    OS_TMR  *ptmr;
 
 
-#if OS_TASK_CREATE_EXT_EN > 0
-    #if OS_STK_GROWTH == 1
-    (void)OSTaskCreateExt(OSTmr_Task,
-                          (void *)0,                                       /* No arguments passed to OSTmrTask()      */
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                               /* Validate arguments                                     */
+        return (OS_FALSE);
+    }
+    if (pgrp == (OS_TMR_GRP *)0) {
+        *perr = OS_ERR_TMR_INVALID;
+        return (OS_FALSE);
+    }
+#endif
+    if (OSIntNesting > 0) {                                 /* See if trying to call from an ISR                      */
+        *perr = OS_ERR_TMR_ISR;
+        return (OS_FALSE);
+    }
+    OSTmr_Lock();
+    ptmr = pgrp->OSTmrGrpTmr;
+    if (ptmr == (OS_TMR *)0) {
+        OSTmr_Unlock();
+        *perr = OS_ERR_TMR_INACTIVE;
+        return (OS_FALSE);
+    }
+    if (pgrp->OSTmrGrpEntries == 0) {
+        OSTmr_Unlock();
+        *perr = OS_ERR_TMR_NO_CALLBACK;
+        return (OS_FALSE);
+    }
+    pgrp->OSTmrGrpNext = 0;                                 /* First release: the members of the smallest phase       */
+    ptmr->OSTmrDly     = pgrp->OSTmrGrpPeriod + pgrp->OSTmrGrpMember[0].OSTmrGrpPhase;
+    OSTmr_Unlock();
+    return (OSTmrStart(ptmr, perr));
+}
+#endif
+
+
+
+#if (OS_TMR_EN > 0) && (OS_TMR_GRP_EN > 0)
+BOOLEAN  OSTmrGrpStop (OS_TMR_GRP  *pgrp,
+                       INT8U       *perr)
+{
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                               /* Validate arguments                                     */
+        return (OS_FALSE);
+    }
+    if (pgrp == (OS_TMR_GRP *)0) {
+        *perr = OS_ERR_TMR_INVALID;
+        return (OS_FALSE);
+    }
+#endif
+    if (pgrp->OSTmrGrpTmr == (OS_TMR *)0) {
+        *perr = OS_ERR_TMR_INACTIVE;
+        return (OS_FALSE);
+    }
+    return (OSTmrStop(pgrp->OSTmrGrpTmr, OS_TMR_OPT_NONE, (void *)0, perr));
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                                DELETE A TIMER GROUP
+*
+* Description: This function stops a timer group and returns it, and its timer, to their pools.
+*
+* Arguments  : pgrp          Is a pointer to the group.
+*
+*              perr          Is a pointer to an error code.  '*perr' will contain one of the following:
+*                               OS_ERR_NONE
+*                               OS_ERR_TMR_INVALID         'pgrp' is a NULL pointer
+*                               OS_ERR_TMR_INACTIVE        if the group was not created
+*                               or the other errors of OSTmrDel()
+*
+* Returns    : OS_TRUE    if the group was deleted
+*              OS_FALSE   if an error was detected
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TMR_GRP_EN > 0)
+BOOLEAN  OSTmrGrpDel (OS_TMR_GRP  *pgrp,
+                      INT8U       *perr)
+{
+    OS_TMR  *ptmr;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                               /* Validate arguments                                     */
+        return (OS_FALSE);
+    }
+    if (pgrp == (OS_TMR_GRP *)0) {
+        *perr = OS_ERR_TMR_INVALID;
+        return (OS_FALSE);
+    }
+#endif
+    ptmr = pgrp->OSTmrGrpTmr;
+    if (ptmr == (OS_TMR *)0) {
+        *perr = OS_ERR_TMR_INACTIVE;
+        return (OS_FALSE);
+    }
+    if (OSTmrDel(ptmr, perr) == OS_FALSE) {
+        return (OS_FALSE);
+    }
+    OSTmr_Lock();
+    pgrp->OSTmrGrpTmr     = (OS_TMR *)0;
+    pgrp->OSTmrGrpEntries = 0;
+    OSTmr_Unlock();
+    return (OS_TRUE);
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                               ALLOCATE AND FREE A TIMER
+*
+* Description: This function is called to allocate a timer.
+*
+* Arguments  : none
+*
+* Returns    : a pointer to a timer if one is available
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0
+static  OS_TMR  *OSTmr_Alloc (void)
+{
+    OS_TMR *ptmr;
+
+
+    if (OSTmrFreeList == (OS_TMR *)0) {
+        return ((OS_TMR *)0);
+    }
+    ptmr            = (OS_TMR *)OSTmrFreeList;
+    OSTmrFreeList   = (OS_TMR *)ptmr->OSTmrNext;
+    ptmr->OSTmrNext = (OS_TCB *)0;
+    ptmr->OSTmrPrev = (OS_TCB *)0;
+    OSTmrUsed++;
+    OSTmrFree--;
+    return (ptmr);
+}
+#endif
+
+
+/*
+************************************************************************************************************************
+*                                             RETURN A TIMER TO THE FREE LIST
+*
+* Description: This function is called to return a timer object to the free list of timers.
+*
+* Arguments  : ptmr     is a pointer to the timer to free
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0
+static  void  OSTmr_Free (OS_TMR *ptmr)
+{
+    ptmr->OSTmrState       = OS_TMR_STATE_UNUSED;      /* Clear timer object fields                                   */
+    ptmr->OSTmrOpt         = OS_TMR_OPT_NONE;
+    ptmr->OSTmrPeriod      = 0;
+    ptmr->OSTmrMatch       = 0;
+    ptmr->OSTmrCallback    = (OS_TMR_CALLBACK)0;
+    ptmr->OSTmrCallbackArg = (void *)0;
+#if OS_TMR_CFG_NAME_SIZE > 1
+    ptmr->OSTmrName[0]     = '?';                      /* Unknown name                                                */
+    ptmr->OSTmrName[1]     = OS_ASCII_NUL;
+#endif
+
+    ptmr->OSTmrPrev        = (OS_TCB *)0;              /* Chain timer to free list                                    */
+    ptmr->OSTmrNext        = OSTmrFreeList;
+    OSTmrFreeList          = ptmr;
+
+    OSTmrUsed--;                                       /* Update timer object statistics                              */
+    OSTmrFree++;
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                                    INITIALIZATION
+*                                          INITIALIZE THE FREE LIST OF TIMERS
+*
+* Description: This function is called by OSInit() to initialize the free list of OS_TMRs.
+*
+* Arguments  : none
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0
+void  OSTmr_Init (void)
+{
+#if OS_EVENT_NAME_SIZE > 10
+    INT8U    err;
+#endif
+    INT16U   i;
+    OS_TMR  *ptmr1;
+    OS_TMR  *ptmr2;
+
+
+    OS_MemClr((INT8U *)&OSTmrTbl[0],      sizeof(OSTmrTbl));            /* Clear all the TMRs                         */
+    OS_MemClr((INT8U *)&OSTmrWheelTbl[0], sizeof(OSTmrWheelTbl));       /* Clear the timer wheel                      */
+#if OS_TMR_GRP_EN > 0
+    OS_MemClr((INT8U *)&OSTmrGrpTbl[0],   sizeof(OSTmrGrpTbl));         /* Free all the timer groups                  */
+#endif
+
+    ptmr1 = &OSTmrTbl[0];
+    ptmr2 = &OSTmrTbl[1];
+    for (i = 0; i < (OS_TMR_CFG_MAX - 1); i++) {                        /* Init. list of free TMRs                    */
+        ptmr1->OSTmrType    = OS_TMR_TYPE;
+        ptmr1->OSTmrState   = OS_TMR_STATE_UNUSED;                      /* Indicate that timer is inactive            */
+        ptmr1->OSTmrNext    = (void *)ptmr2;                            /* Link to next timer                         */
+#if OS_TMR_CFG_NAME_SIZE > 1
+        ptmr1->OSTmrName[0] = '?';                                      /* Unknown name                               */
+        ptmr1->OSTmrName[1] = OS_ASCII_NUL;
+#endif
+        ptmr1++;
+        ptmr2++;
+    }
+    ptmr1->OSTmrType    = OS_TMR_TYPE;
+    ptmr1->OSTmrState   = OS_TMR_STATE_UNUSED;                          /* Indicate that timer is inactive            */
+    ptmr1->OSTmrNext    = (void *)0;                                    /* Last OS_TMR                                */
+#if OS_TMR_CFG_NAME_SIZE > 1
+    ptmr1->OSTmrName[0] = '?';                                          /* Unknown name                               */
+    ptmr1->OSTmrName[1] = OS_ASCII_NUL;
+#endif
+    OSTmrTime           = 0;
+#if OS_TICKLESS_EN > 0
+    OSTmrNextMatch      = OS_TMR_NEXT_NONE;
+#endif
+#if OS_TMR_ISR_CALLBACK_EN > 0
+    OSTmrWheelEntries   = 0;
+    OSTmrIsrTime        = 0;
+    OSTmrIsrList        = (OS_TMR *)0;
+#endif
+    OSTmrUsed           = 0;
+    OSTmrFree           = OS_TMR_CFG_MAX;
+    OSTmrFreeList       = &OSTmrTbl[0];
+    OSTmrSem            = OSSemCreate(1);
+    OSTmrSemSignal      = OSSemCreate(0);
+
+#if OS_EVENT_NAME_SIZE > 18
+    OSEventNameSet(OSTmrSem,       (INT8U *)"uC/OS-II TmrLock",   &err);/* Assign names to semaphores                 */
+#else
+#if OS_EVENT_NAME_SIZE > 10
+    OSEventNameSet(OSTmrSem,       (INT8U *)"OS-TmrLock",         &err);
+#endif
+#endif
+
+#if OS_EVENT_NAME_SIZE > 18
+    OSEventNameSet(OSTmrSemSignal, (INT8U *)"uC/OS-II TmrSignal", &err);
+#else
+#if OS_EVENT_NAME_SIZE > 10
+    OSEventNameSet(OSTmrSemSignal, (INT8U *)"OS-TmrSig",          &err);
+#endif
+#endif
+
+    OSTmr_InitTask();
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                          INITIALIZE THE TIMER MANAGEMENT TASK
+*
+* Description: This function is called by OSTmrInit() to create the timer management task.
+*
+* Arguments  : none
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0
+static  void  OSTmr_InitTask (void)
+{
+#if OS_TASK_NAME_SIZE > 6
+    INT8U  err;
+#endif
+
+
+#if OS_TASK_CREATE_EXT_EN > 0
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreateExt(OSTmr_Task,
+                          (void *)0,                                       /* No arguments passed to OSTmrTask()      */
                           &OSTmrTaskStk[OS_TASK_TMR_STK_SIZE - 1],         /* Set Top-Of-Stack                        */
                           OS_TASK_TMR_PRIO,
                           OS_TASK_TMR_ID,
@@ -941,8 +1463,20 @@ static  void  OSTmr_InitTask (void)
 *              type          Is either:
 *                               OS_TMR_LINK_PERIODIC    Means to re-insert the timer after a period expired
 *                               OS_TMR_LINK_DLY         Means to insert    the timer the first time
+*                               OS_TMR_LINK_CASCADE     Means to move the timer to a lower level, 'OSTmrMatch' is kept
 *
 * Returns    : none
+*
+*              OS_TMR_OPT_ISR_CALLBACK timers are handed over to OSTmr_IsrLink().
+*
+* Note(s)    : 1) With OS_TMR_HWHEEL_EN, the wheel has OS_TMR_HWHEEL_LEVELS levels of OS_TMR_WHEEL_SPOKES spokes.  A
+*                 timer expiring in less than OS_TMR_WHEEL_SPOKES ticks goes to level 0, in the spoke of its low bits
+*                 of 'OSTmrMatch'.  Each next level covers OS_TMR_HWHEEL_BITS more bits of the delay and is indexed by
+*                 the next bits of 'OSTmrMatch'.  A timer further away than the whole wheel is parked in the last
+*                 spoke it can reach and linked again when that spoke is cascaded.
+*
+*              2) With OS_TICKLESS_EN, OSTmrNextMatch is moved up to a timer that expires before it.  It is left alone
+*                 while OSTmr_Task() handles the tick it designates; OSTmr_NextUpdate() sets it again afterwards.
 ************************************************************************************************************************
 */
 
@@ -952,19 +1486,56 @@ static  void  OSTmr_Link (OS_TMR *ptmr, INT8U type)
     OS_TMR       *ptmr1;
     OS_TMR_WHEEL *pspoke;
     INT16U        spoke;
+#if OS_TMR_HWHEEL_EN > 0
+    INT32U        dly;
+    INT8U         shift;
+#endif
+#if OS_TICKLESS_EN > 0
+    INT32U        next;
+#endif
 
 
+#if OS_TMR_ISR_CALLBACK_EN > 0
+    if ((ptmr->OSTmrOpt & OS_TMR_OPT_ISR_CALLBACK) != 0) {
+        OSTmr_IsrLink(ptmr, type);
+        return;
+    }
+    if (type != OS_TMR_LINK_CASCADE) {
+        OSTmrWheelEntries++;
+    }
+#endif
     ptmr->OSTmrState = OS_TMR_STATE_RUNNING;
     if (type == OS_TMR_LINK_PERIODIC) {                            /* Determine when timer will expire                */
         ptmr->OSTmrMatch = ptmr->OSTmrPeriod + OSTmrTime;
-    } else {
+    } else if (type == OS_TMR_LINK_DLY) {
         if (ptmr->OSTmrDly == 0) {
             ptmr->OSTmrMatch = ptmr->OSTmrPeriod + OSTmrTime;
         } else {
             ptmr->OSTmrMatch = ptmr->OSTmrDly    + OSTmrTime;
         }
     }
-    spoke  = (INT16U)(ptmr->OSTmrMatch % OS_TMR_CFG_WHEEL_SIZE);
+#if OS_TICKLESS_EN > 0
+    next = OSTmrNextMatch - OSTmrTime;                             /* See Note #2                                     */
+    if ((next != 0) && ((ptmr->OSTmrMatch - OSTmrTime) < next)) {
+        OSTmrNextMatch = ptmr->OSTmrMatch;
+    }
+#endif
+#if OS_TMR_HWHEEL_EN > 0
+    dly = ptmr->OSTmrMatch - OSTmrTime;                            /* The level is set by how far the timer expires   */
+    if (dly > OS_TMR_WHEEL_MAX_DLY) {
+        dly = OS_TMR_WHEEL_MAX_DLY;                                /* See Note #1                                     */
+    }
+    spoke = 0;
+    shift = 0;
+    while ((spoke < (OS_TMR_WHEEL_TBL_SIZE - OS_TMR_WHEEL_SPOKES)) && ((dly >> shift) >= OS_TMR_WHEEL_SPOKES)) {
+        spoke += OS_TMR_WHEEL_SPOKES;
+        shift += OS_TMR_HWHEEL_BITS;
+    }
+    spoke            += (INT16U)(((OSTmrTime + dly) >> shift) & OS_TMR_WHEEL_MASK);
+    ptmr->OSTmrSpoke  = spoke;
+#else
+    spoke  = OS_TMR_WHEEL_SPOKE(ptmr->OSTmrMatch);
+#endif
     pspoke = &OSTmrWheelTbl[spoke];
 
     if (pspoke->OSTmrFirst == (OS_TMR *)0) {                       /* Link into timer wheel                           */
@@ -1004,7 +1575,18 @@ static  void  OSTmr_Unlink (OS_TMR *ptmr)
     INT16U         spoke;
 
 
-    spoke  = (INT16U)(ptmr->OSTmrMatch % OS_TMR_CFG_WHEEL_SIZE);
+#if OS_TMR_ISR_CALLBACK_EN > 0
+    if ((ptmr->OSTmrOpt & OS_TMR_OPT_ISR_CALLBACK) != 0) {
+        OSTmr_IsrUnlink(ptmr);
+        return;
+    }
+    OSTmrWheelEntries--;
+#endif
+#if OS_TMR_HWHEEL_EN > 0
+    spoke  = ptmr->OSTmrSpoke;
+#else
+    spoke  = OS_TMR_WHEEL_SPOKE(ptmr->OSTmrMatch);
+#endif
     pspoke = &OSTmrWheelTbl[spoke];
 
     if (pspoke->OSTmrFirst == ptmr) {                       /* See if timer to remove is at the beginning of list     */
@@ -1028,6 +1610,449 @@ static  void  OSTmr_Unlink (OS_TMR *ptmr)
 }
 #endif
 
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                        CASCADE THE UPPER LEVELS OF THE TIMER WHEEL
+*
+* Description: This function is called by OSTmr_Task() after incrementing OSTmrTime.  Each time the index of a level
+*              wraps around to 0, the timers of the current spoke of the level above are linked again, which moves
+*              them to a lower level since they now expire within the range that level covers.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) The cost is a single test on most ticks.  A timer is moved at most once per level on its way down
+*                 to level 0.
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TMR_HWHEEL_EN > 0)
+static  void  OSTmr_Cascade (void)
+{
+    OS_TMR        *ptmr;
+    OS_TMR        *ptmr_next;
+    OS_TMR_WHEEL  *pspoke;
+    INT32U         time;
+    INT16U         spoke;
+
+
+    time  = OSTmrTime;
+    spoke = OS_TMR_WHEEL_SPOKES;
+    while ((spoke < OS_TMR_WHEEL_TBL_SIZE) && ((time & OS_TMR_WHEEL_MASK) == 0)) {   /* Level below wrapped around */
+        time                 >>= OS_TMR_HWHEEL_BITS;
+        pspoke                 = &OSTmrWheelTbl[spoke + (INT16U)(time & OS_TMR_WHEEL_MASK)];
+        ptmr                   = pspoke->OSTmrFirst;
+        pspoke->OSTmrFirst     = (OS_TMR *)0;                       /* Empty the spoke ...                          */
+        pspoke->OSTmrEntries   = 0;
+        while (ptmr != (OS_TMR *)0) {                               /* ... and link its timers again                */
+            ptmr_next = (OS_TMR *)ptmr->OSTmrNext;
+            OSTmr_Link(ptmr, OS_TMR_LINK_CASCADE);
+            ptmr      = ptmr_next;
+        }
+        spoke += OS_TMR_WHEEL_SPOKES;
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                     INSERT A TIMER CALLED BACK BY OSTmrSignal()
+*
+* Description: This function is called by OSTmr_Link() to insert an OS_TMR_OPT_ISR_CALLBACK timer in OSTmrIsrList.  The
+*              list is kept sorted by expiry so that OSTmr_IsrSignal() only looks at its head.
+*
+* Arguments  : ptmr          Is a pointer to the timer to insert.
+*
+*              type          Is either OS_TMR_LINK_PERIODIC or OS_TMR_LINK_DLY (see OSTmr_Link()).
+*
+* Returns    : none
+*
+* Note(s)    : 1) The list is shared with OSTmrSignal() and thus updated with interrupts disabled.  The insertion walks
+*                 the list, so the number of such timers should stay small.
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TMR_ISR_CALLBACK_EN > 0)
+static  void  OSTmr_IsrLink (OS_TMR *ptmr, INT8U type)
+{
+    OS_TMR     *pnext;
+    OS_TMR     *pprev;
+    INT32U      dly;
+#if OS_CRITICAL_METHOD == 3                                         /* Allocate storage for CPU status register     */
+    OS_CPU_SR   cpu_sr = 0;
+#endif
+
+
+    if ((type == OS_TMR_LINK_PERIODIC) || (ptmr->OSTmrDly == 0)) {
+        dly = ptmr->OSTmrPeriod;
+    } else {
+        dly = ptmr->OSTmrDly;
+    }
+    OS_ENTER_CRITICAL();
+    ptmr->OSTmrState = OS_TMR_STATE_RUNNING;
+    ptmr->OSTmrMatch = OSTmrIsrTime + dly;
+    pprev            = (OS_TMR *)0;
+    pnext            = OSTmrIsrList;
+    while ((pnext != (OS_TMR *)0) && ((pnext->OSTmrMatch - OSTmrIsrTime) <= dly)) {
+        pprev = pnext;                                              /* Insert after the timers expiring first       */
+        pnext = (OS_TMR *)pnext->OSTmrNext;
+    }
+    ptmr->OSTmrNext = (void *)pnext;
+    ptmr->OSTmrPrev = (void *)pprev;
+    if (pnext != (OS_TMR *)0) {
+        pnext->OSTmrPrev = (void *)ptmr;
+    }
+    if (pprev != (OS_TMR *)0) {
+        pprev->OSTmrNext = (void *)ptmr;
+    } else {
+        OSTmrIsrList     = ptmr;
+    }
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                     REMOVE A TIMER CALLED BACK BY OSTmrSignal()
+*
+* Description: This function is called by OSTmr_Unlink() to remove an OS_TMR_OPT_ISR_CALLBACK timer from OSTmrIsrList.
+*
+* Arguments  : ptmr          Is a pointer to the timer to remove.
+*
+* Returns    : none
+*
+* Note(s)    : 1) A ONE-SHOT timer may have expired, and left the list, since the caller checked that it was running.
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TMR_ISR_CALLBACK_EN > 0)
+static  void  OSTmr_IsrUnlink (OS_TMR *ptmr)
+{
+    OS_TMR     *pnext;
+    OS_TMR     *pprev;
+#if OS_CRITICAL_METHOD == 3                                         /* Allocate storage for CPU status register     */
+    OS_CPU_SR   cpu_sr = 0;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    if (ptmr->OSTmrState == OS_TMR_STATE_RUNNING) {                 /* See Note #1                                  */
+        pnext = (OS_TMR *)ptmr->OSTmrNext;
+        pprev = (OS_TMR *)ptmr->OSTmrPrev;
+        if (pnext != (OS_TMR *)0) {
+            pnext->OSTmrPrev = (void *)pprev;
+        }
+        if (pprev != (OS_TMR *)0) {
+            pprev->OSTmrNext = (void *)pnext;
+        } else {
+            OSTmrIsrList     = pnext;
+        }
+    }
+    ptmr->OSTmrState = OS_TMR_STATE_STOPPED;
+    ptmr->OSTmrNext  = (void *)0;
+    ptmr->OSTmrPrev  = (void *)0;
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                     UPDATE THE TIMERS CALLED BACK BY OSTmrSignal()
+*
+* Description: This function is called by OSTmrSignal() to advance OSTmrIsrTime and call back the timers that expire.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) A timer leaves the list, and a PERIODIC one is linked again, before its callback is called with
+*                 interrupts enabled again.  The list is thus consistent if OSTmrSignal() is called from a task (e.g.
+*                 the defer task, see OS_ISR_DEFER_EN) and the callback readies a task of higher priority.
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TMR_ISR_CALLBACK_EN > 0)
+static  void  OSTmr_IsrSignal (void)
+{
+    OS_TMR           *ptmr;
+    OS_TMR_CALLBACK   pfnct;
+#if OS_TMR_STATS_EN > 0
+    INT32U            start;
+#endif
+#if OS_CRITICAL_METHOD == 3                                         /* Allocate storage for CPU status register     */
+    OS_CPU_SR         cpu_sr = 0;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    OSTmrIsrTime++;
+    ptmr = OSTmrIsrList;
+    while ((ptmr != (OS_TMR *)0) && (ptmr->OSTmrMatch == OSTmrIsrTime)) {
+        OSTmr_IsrUnlink(ptmr);                                      /* See Note #1                                  */
+        if ((ptmr->OSTmrOpt & (INT8U)~OS_TMR_OPT_ISR_CALLBACK) == OS_TMR_OPT_PERIODIC) {
+            OSTmr_IsrLink(ptmr, OS_TMR_LINK_PERIODIC);
+        } else {
+            ptmr->OSTmrState = OS_TMR_STATE_COMPLETED;
+        }
+        pfnct = ptmr->OSTmrCallback;
+        OS_EXIT_CRITICAL();
+#if OS_TMR_STATS_EN > 0
+#ifdef OS_TS_GET
+        start = OS_TS_GET();
+#else
+        start = 0;
+#endif
+#endif
+        if (pfnct != (OS_TMR_CALLBACK)0) {
+            (*pfnct)((void *)ptmr, ptmr->OSTmrCallbackArg);
+        }
+#if OS_TMR_STATS_EN > 0
+        OSTmr_StatsUpdate(ptmr, 0, start);                          /* Called back from the tick, never late        */
+#endif
+        OS_ENTER_CRITICAL();
+        ptmr = OSTmrIsrList;
+    }
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                        FIND WHEN THE NEXT TIMER EXPIRES
+*
+* Description: This function is called by the idle task to find out how many timer ticks (i.e. calls to OSTmrSignal())
+*              are left before the first running timer expires.  It is used to decide how long the system tick may be
+*              stopped (see OS_TICKLESS_EN).
+*
+* Arguments  : none
+*
+* Returns    : the number of timer ticks until the next timer expires or 0 if no timer is running.  The count may be
+*              short (see OSTmr_NextUpdate()) or very large if only far timers are running.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Only OSTmrNextMatch and the head of OSTmrIsrList are read, so the time taken does not depend on the
+*                 number of timers.  The idle task calls it with interrupts enabled and discards the result if a tick
+*                 or a context switch occurred meanwhile.
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TICKLESS_EN > 0)
+INT32U  OSTmr_NextExpiry (void)
+{
+    INT32U   next;
+#if OS_TMR_ISR_CALLBACK_EN > 0
+    OS_TMR  *ptmr;
+    INT32U   remain;
+#endif
+
+
+    next = OSTmrNextMatch - OSTmrTime;
+#if OS_TMR_ISR_CALLBACK_EN > 0
+    if (OSTmrWheelEntries == 0) {                                   /* Nothing in the wheel, the bound is stale     */
+        next = 0;
+    }
+    ptmr = OSTmrIsrList;                                            /* The list is sorted: only its head counts     */
+    if (ptmr != (OS_TMR *)0) {
+        remain = ptmr->OSTmrMatch - OSTmrIsrTime;
+        if ((next == 0) || (remain < next)) {
+            next = remain;
+        }
+    }
+#endif
+    return (next);
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                           SET THE NEXT TIMER EXPIRY
+*
+* Description: This function is called by OSTmr_Task() when OSTmrTime reaches OSTmrNextMatch, to move OSTmrNextMatch
+*              to the next time a timer of the wheel may expire.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) With OS_TMR_HWHEEL_EN, a level 0 spoke only holds timers expiring within one turn of the level, so the
+*                 first non-empty spoke ahead gives the next expiry.  The search stops at the next cascade, which may
+*                 bring a timer down from an upper level; the idle task thus wakes up at least once per turn of level
+*                 0.  At most OS_TMR_WHEEL_SPOKES spokes are looked at.
+*              2) Without OS_TMR_HWHEEL_EN, a spoke holds timers of any later turn of the wheel and the timers are
+*                 looked at one by one.  This runs in the timer task, with interrupts enabled, once per expiry.
+*              3) A timer stopped since OSTmrNextMatch was set leaves it early.  The idle task then wakes up for nothing
+*                 and this function is called again.
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TICKLESS_EN > 0)
+static  void  OSTmr_NextUpdate (void)
+{
+#if OS_TMR_HWHEEL_EN > 0
+    INT32U   time;
+    INT32U   cascade;
+
+
+    time    = OSTmrTime + 1;
+    cascade = (OSTmrTime | OS_TMR_WHEEL_MASK) + 1;                  /* See Note #1                                  */
+    while ((time != cascade) && (OSTmrWheelTbl[time & OS_TMR_WHEEL_MASK].OSTmrFirst == (OS_TMR *)0)) {
+        time++;
+    }
+    OSTmrNextMatch = time;
+#else
+    OS_TMR  *ptmr;
+    INT32U   remain;
+    INT32U   next;
+    INT16U   i;
+
+
+    next = OS_TMR_NEXT_NONE;
+    ptmr = &OSTmrTbl[0];
+    for (i = 0; i < OS_TMR_CFG_MAX; i++) {                          /* See Note #2                                  */
+        if (ptmr->OSTmrState == OS_TMR_STATE_RUNNING) {
+#if OS_TMR_ISR_CALLBACK_EN > 0
+            if ((ptmr->OSTmrOpt & OS_TMR_OPT_ISR_CALLBACK) == 0) {
+#endif
+                remain = ptmr->OSTmrMatch - OSTmrTime;
+                if (remain < next) {
+                    next = remain;
+                }
+#if OS_TMR_ISR_CALLBACK_EN > 0
+            }
+#endif
+        }
+        ptmr++;
+    }
+    OSTmrNextMatch = OSTmrTime + next;
+#endif
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                           RELEASE THE MEMBERS OF A TIMER GROUP
+*
+* Description: This function is the callback of the timer of a group.  It releases the members whose phase has come,
+*              then sets the period of the timer to the time left until the next phase.
+*
+* Arguments  : ptmr          Is the timer of the group.
+*
+*              parg          Is the group.
+*
+* Returns    : none
+*
+* Note(s)    : 1) OSTmr_Task() links a PERIODIC timer again after its callback and uses the new period.  OSTmrSignal()
+*                 links it before (see OSTmr_IsrSignal()), so the timer is linked again here.
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TMR_GRP_EN > 0)
+static  void  OSTmr_GrpCallback (void *ptmr, void *parg)
+{
+    OS_TMR_GRP         *pgrp;
+    OS_TMR_GRP_MEMBER  *pmember;
+    INT32U              phase;
+    INT8U               first;
+    INT8U               i;
+
+
+    pgrp  = (OS_TMR_GRP *)parg;
+    first = pgrp->OSTmrGrpNext;
+    phase = pgrp->OSTmrGrpMember[first].OSTmrGrpPhase;
+    i     = first;
+    do {                                                            /* Release the members of this phase, in order  */
+        pmember = &pgrp->OSTmrGrpMember[i];
+        if (pmember->OSTmrGrpCallback != (OS_TMR_CALLBACK)0) {
+            (*pmember->OSTmrGrpCallback)((void *)pgrp, pmember->OSTmrGrpArg);
+        } else {
+            (void)OSSemPost((OS_EVENT *)pmember->OSTmrGrpArg);
+        }
+        i++;
+        if (i == pgrp->OSTmrGrpEntries) {
+            i = 0;
+        }
+    } while ((i != first) && (pgrp->OSTmrGrpMember[i].OSTmrGrpPhase == phase));
+
+    pgrp->OSTmrGrpNext = i;
+    if (i > first) {                                                /* Next phase in this period ...                */
+        ((OS_TMR *)ptmr)->OSTmrPeriod = pgrp->OSTmrGrpMember[i].OSTmrGrpPhase - phase;
+    } else {                                                        /* ... or first phase of the next one           */
+        ((OS_TMR *)ptmr)->OSTmrPeriod = pgrp->OSTmrGrpPeriod - phase + pgrp->OSTmrGrpMember[i].OSTmrGrpPhase;
+    }
+#if OS_TMR_ISR_CALLBACK_EN > 0
+    if ((((OS_TMR *)ptmr)->OSTmrOpt & OS_TMR_OPT_ISR_CALLBACK) != 0) {
+        OSTmr_IsrUnlink((OS_TMR *)ptmr);                            /* See Note #1                                  */
+        OSTmr_IsrLink((OS_TMR *)ptmr, OS_TMR_LINK_PERIODIC);
+    }
+#endif
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                          RECORD A CALLBACK IN THE TIMER STATISTICS
+*
+* Description: This function is called after a timer callback to count the expiry and bin its lateness and run time.
+*
+* Arguments  : ptmr          Is a pointer to the timer
+*
+*              late          Is the number of timer ticks the callback was late
+*
+*              start         Is the value of OS_TS_GET() before the callback (unused without OS_TS_GET())
+*
+* Returns    : none
+*
+* Note(s)    : 1) Run time bins are found by shifting rather than dividing, the CPU has no divider.
+************************************************************************************************************************
+*/
+
+#if OS_TMR_STATS_EN > 0
+static  void  OSTmr_StatsUpdate (OS_TMR *ptmr, INT32U late, INT32U start)
+{
+    OS_TMR_STATS  *pstats;
+    INT32U         cycles;
+    INT32U         bin;
+
+
+#ifdef OS_TS_GET
+    cycles = OS_TS_GET() - start;
+#else
+    cycles = 0;
+    (void)start;
+#endif
+    pstats = &ptmr->OSTmrStats;
+    pstats->OSTmrStatsExpiries++;
+
+    if (late > pstats->OSTmrStatsLateMax) {
+        pstats->OSTmrStatsLateMax = late;
+    }
+    if (late > OS_TMR_STATS_BINS - 1) {
+        late = OS_TMR_STATS_BINS - 1;
+    }
+    pstats->OSTmrStatsLate[late]++;
+
+    if (cycles > pstats->OSTmrStatsCyclesMax) {
+        pstats->OSTmrStatsCyclesMax = cycles;
+    }
+    cycles >>= OS_TMR_STATS_BIN0_LOG2;
+    bin      = 0;
+    while ((cycles != 0) && (bin < OS_TMR_STATS_BINS - 1)) {
+        cycles >>= 1;
+        bin++;
+    }
+    pstats->OSTmrStatsCycles[bin]++;
+}
+#endif
+
 /*$PAGE*/
 /*
 ************************************************************************************************************************
@@ -1083,6 +2108,10 @@ static  void  OSTmr_Task (void *p_arg)
     OS_TMR_CALLBACK  pfnct;
     OS_TMR_WHEEL    *pspoke;
     INT16U           spoke;
+#if OS_TMR_STATS_EN > 0
+    INT32U           late;
+    INT32U           start;
+#endif
 
 
     (void)p_arg;                                                 /* Not using 'p_arg', prevent compiler warning       */
@@ -1090,7 +2119,12 @@ static  void  OSTmr_Task (void *p_arg)
         OSSemPend(OSTmrSemSignal, 0, &err);                      /* Wait for signal indicating time to update timers  */
         OSTmr_Lock();
         OSTmrTime++;                                             /* Increment the current time                        */
-        spoke  = (INT16U)(OSTmrTime % OS_TMR_CFG_WHEEL_SIZE);    /* Position on current timer wheel entry             */
+#if OS_TMR_HWHEEL_EN > 0
+        OSTmr_Cascade();                                         /* Bring down the timers of the upper levels now due */
+        spoke  = (INT16U)(OSTmrTime & OS_TMR_WHEEL_MASK);        /* Every timer in this level 0 spoke expires now     */
+#else
+        spoke  = OS_TMR_WHEEL_SPOKE(OSTmrTime);                  /* Position on current timer wheel entry             */
+#endif
         pspoke = &OSTmrWheelTbl[spoke];
         ptmr   = pspoke->OSTmrFirst;
         while (ptmr != (OS_TMR *)0) {
@@ -1098,9 +2132,20 @@ static  void  OSTmr_Task (void *p_arg)
                                                                  /* ... timer could get unlinked from the wheel.      */
             if (OSTmrTime == ptmr->OSTmrMatch) {                 /* Process each timer that expires                   */
                 pfnct = ptmr->OSTmrCallback;                     /* Execute callback function if available            */
+#if OS_TMR_STATS_EN > 0
+                late  = OSTmrSemSignal->OSEventCnt;              /* Timer ticks signaled but not handled yet          */
+#ifdef OS_TS_GET
+                start = OS_TS_GET();
+#else
+                start = 0;
+#endif
+#endif
                 if (pfnct != (OS_TMR_CALLBACK)0) {
                     (*pfnct)((void *)ptmr, ptmr->OSTmrCallbackArg);
                 }
+#if OS_TMR_STATS_EN > 0
+                OSTmr_StatsUpdate(ptmr, late, start);
+#endif
                 OSTmr_Unlink(ptmr);                              /* Remove from current wheel spoke                   */
                 if (ptmr->OSTmrOpt == OS_TMR_OPT_PERIODIC) {
                     OSTmr_Link(ptmr, OS_TMR_LINK_PERIODIC);      /* Recalculate new position of timer in wheel        */
@@ -1110,6 +2155,11 @@ static  void  OSTmr_Task (void *p_arg)
             }
             ptmr = ptmr_next;
         }
+#if OS_TICKLESS_EN > 0
+        if (OSTmrNextMatch == OSTmrTime) {                       /* Find the next expiry for the idle task            */
+            OSTmr_NextUpdate();
+        }
+#endif
         OSTmr_Unlock();
     }
 }
@@ -339,6 +339,17 @@ ALT_CPPFLAGS += -D__ucosii__
 
 #END MANAGED
 
+# Interrupt-disabled time tracer, see HAL/inc/sys/alt_irq_trace.h. Times 
+# every alt_irq_disable_all()/alt_irq_enable_all() pair with timer_1 and 
+# keeps the longest section and a histogram per call site. Uncomment to 
+# build it into the BSP and the application. 
+#ALT_CPPFLAGS += -DALT_IRQ_TRACE
+
+# High-resolution timers, see HAL/inc/sys/alt_hrtimer.h. One-shot and 
+# periodic callbacks with microsecond deadlines, run on timer_1. Uncomment 
+# to build the service into the BSP and the application. 
+#ALT_CPPFLAGS += -DALT_HRTIMER
+
 
 #------------------------------------------------------------------------------
 #                             LIBRARY INFORMATION
@@ -0,0 +1,222 @@
+/*
+ * Interrupt-disabled time tracer, see sys/alt_irq_trace.h.
+ *
+ * The timer is programmed with the largest period and left running, so
+ * that it counts down through the whole 32-bit range. A time stamp is the
+ * snapshot of its counter and the length of a section is the difference of
+ * two snapshots, modulo 2^32.
+ *
+ * With ALT_HRTIMER, the timer belongs to the high-resolution timer service,
+ * which reloads its period, and the time stamps are taken from
+ * alt_hrtimer_time() instead.
+ */
+
+#ifdef ALT_IRQ_TRACE
+
+#include <stdio.h>
+
+#include "system.h"
+#include "sys/alt_irq.h"
+#include "altera_avalon_timer_regs.h"
+#include "alt_types.h"
+
+#ifdef ALT_HRTIMER
+#include "sys/alt_hrtimer.h"
+#define ALT_IRQ_TRACE_TIMER_FREQ ALT_HRTIMER_TIMER_FREQ
+#endif
+
+#ifndef ALT_IRQ_TRACE_TIMER_BASE
+#define ALT_IRQ_TRACE_TIMER_BASE TIMER_1_BASE
+#endif
+#ifndef ALT_IRQ_TRACE_TIMER_FREQ
+#define ALT_IRQ_TRACE_TIMER_FREQ TIMER_1_FREQ
+#endif
+
+alt_irq_trace_site alt_irq_trace_tbl[ALT_IRQ_TRACE_SITES];
+alt_u32            alt_irq_trace_lost;
+
+/*
+ * The section being timed: where interrupts were disabled and when. The
+ * CPU runs a single section at a time, since a second one can only start
+ * once interrupts are enabled again.
+ */
+
+static const char* alt_irq_trace_file;
+static alt_u32     alt_irq_trace_line;
+static alt_u32     alt_irq_trace_stamp;
+static alt_u8      alt_irq_trace_on;
+
+static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_irq_trace_now (void)
+{
+#ifdef ALT_HRTIMER
+  return - (alt_u32) alt_hrtimer_time ();     /* counts down, like the timer */
+#else
+  IOWR_ALTERA_AVALON_TIMER_SNAPL (ALT_IRQ_TRACE_TIMER_BASE, 0);
+  return (IORD_ALTERA_AVALON_TIMER_SNAPH (ALT_IRQ_TRACE_TIMER_BASE) << 16) |
+          IORD_ALTERA_AVALON_TIMER_SNAPL (ALT_IRQ_TRACE_TIMER_BASE);
+#endif
+}
+
+/*
+ * alt_irq_trace_record() adds a section of "cycles" to the entry of the
+ * site "file":"line". Sites are hashed on the line and the address of the
+ * file name; a full table drops the section.
+ */
+
+static void alt_irq_trace_record (const char* file, alt_u32 line,
+                                  alt_u32 cycles)
+{
+  alt_irq_trace_site* site;
+  alt_u32 i;
+  alt_u32 n;
+  alt_u32 bin;
+
+  i = (line + ((alt_u32) file >> 2)) % ALT_IRQ_TRACE_SITES;
+  for (n = 0; n < ALT_IRQ_TRACE_SITES; n++)
+  {
+    site = &alt_irq_trace_tbl[i];
+    if (site->file == file && site->line == line)
+    {
+      break;
+    }
+    if (site->file == NULL)
+    {
+      site->file = file;
+      site->line = line;
+      break;
+    }
+    if (++i == ALT_IRQ_TRACE_SITES)
+    {
+      i = 0;
+    }
+  }
+  if (n == ALT_IRQ_TRACE_SITES)
+  {
+    alt_irq_trace_lost++;
+    return;
+  }
+
+  site->count++;
+  if (cycles > site->max)
+  {
+    site->max = cycles;
+  }
+  bin = 0;
+  cycles >>= ALT_IRQ_TRACE_BIN0_LOG2;
+  while (cycles != 0 && bin < ALT_IRQ_TRACE_BINS - 1)
+  {
+    cycles >>= 1;
+    bin++;
+  }
+  site->hist[bin]++;
+}
+
+alt_irq_context alt_irq_trace_disable (const char* file, int line)
+{
+  alt_irq_context context;
+
+  context = (alt_irq_disable_all) ();
+  if ((context & NIOS2_STATUS_PIE_MSK) && alt_irq_trace_on)
+  {
+    alt_irq_trace_file  = file;
+    alt_irq_trace_line  = line;
+    alt_irq_trace_stamp = alt_irq_trace_now ();
+  }
+  return context;
+}
+
+void alt_irq_trace_enable (alt_irq_context context)
+{
+  alt_u32 cycles;
+
+  if ((context & NIOS2_STATUS_PIE_MSK) && alt_irq_trace_file != NULL)
+  {
+    cycles = alt_irq_trace_stamp - alt_irq_trace_now ();
+    alt_irq_trace_record (alt_irq_trace_file, alt_irq_trace_line, cycles);
+    alt_irq_trace_file = NULL;
+  }
+  (alt_irq_enable_all) (context);
+}
+
+void alt_irq_trace_start (void)
+{
+  alt_irq_context context;
+  alt_u32 i;
+
+  context = (alt_irq_disable_all) ();
+  alt_irq_trace_on   = 0;
+  alt_irq_trace_file = NULL;
+  for (i = 0; i < sizeof (alt_irq_trace_tbl); i++)
+  {
+    ((alt_u8*) alt_irq_trace_tbl)[i] = 0;
+  }
+  alt_irq_trace_lost = 0;
+
+#ifdef ALT_HRTIMER
+  alt_hrtimer_init ();
+#else
+  IOWR_ALTERA_AVALON_TIMER_CONTROL (ALT_IRQ_TRACE_TIMER_BASE,
+                                    ALTERA_AVALON_TIMER_CONTROL_STOP_MSK);
+  IOWR_ALTERA_AVALON_TIMER_PERIODL (ALT_IRQ_TRACE_TIMER_BASE, 0xFFFF);
+  IOWR_ALTERA_AVALON_TIMER_PERIODH (ALT_IRQ_TRACE_TIMER_BASE, 0xFFFF);
+  IOWR_ALTERA_AVALON_TIMER_CONTROL (ALT_IRQ_TRACE_TIMER_BASE,
+                                    ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+                                    ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+#endif
+  alt_irq_trace_on = 1;
+  (alt_irq_enable_all) (context);
+}
+
+void alt_irq_trace_dump (void)
+{
+  alt_u8 printed[ALT_IRQ_TRACE_SITES];
+  alt_irq_trace_site* site;
+  alt_u32 i;
+  alt_u32 j;
+  alt_u32 k;
+
+  alt_irq_trace_on = 0;
+
+  for (i = 0; i < ALT_IRQ_TRACE_SITES; i++)
+  {
+    printed[i] = 0;
+  }
+  printf ("Interrupts disabled, in cycles of a %lu Hz timer\n",
+          (alt_u32) ALT_IRQ_TRACE_TIMER_FREQ);
+  printf ("     max    count  site\n"
+          "          histogram, < %u cycles and doubling\n",
+          1u << ALT_IRQ_TRACE_BIN0_LOG2);
+  for (i = 0; i < ALT_IRQ_TRACE_SITES; i++)
+  {
+    site = NULL;
+    for (j = 0; j < ALT_IRQ_TRACE_SITES; j++)
+    {
+      if (!printed[j] && alt_irq_trace_tbl[j].file != NULL &&
+          (site == NULL || alt_irq_trace_tbl[j].max > site->max))
+      {
+        site = &alt_irq_trace_tbl[j];
+        k    = j;
+      }
+    }
+    if (site == NULL)
+    {
+      break;
+    }
+    printed[k] = 1;
+    printf ("%8lu %8lu  %s:%lu\n        ", site->max, site->count,
+            site->file, site->line);
+    for (j = 0; j < ALT_IRQ_TRACE_BINS; j++)
+    {
+      printf (" %lu", site->hist[j]);
+    }
+    printf ("\n");
+  }
+  if (alt_irq_trace_lost)
+  {
+    printf ("%lu sections from sites that did not fit\n", alt_irq_trace_lost);
+  }
+
+  alt_irq_trace_on = 1;
+}
+
+#endif /* ALT_IRQ_TRACE */
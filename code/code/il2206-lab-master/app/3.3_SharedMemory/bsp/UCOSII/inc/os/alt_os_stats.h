@@ -0,0 +1,26 @@
+#ifndef __ALT_OS_STATS_H__
+#define __ALT_OS_STATS_H__
+
+/*
+ * alt_os_stats.h prints the statistics kept by uC/OS-II in one report: the
+ * tick count, context switches and CPU usage, then, with OS_TMR_STATS_EN,
+ * the expiries, lateness and callback run times of every timer in use.
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/*
+ * alt_os_stats_dump() prints the report on stdout (the JTAG UART). It is
+ * called from a task, since the timer statistics are read under the lock of
+ * the timer manager.
+ */
+extern void alt_os_stats_dump (void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __ALT_OS_STATS_H__ */
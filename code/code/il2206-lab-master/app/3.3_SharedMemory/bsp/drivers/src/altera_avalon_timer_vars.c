@@ -43,3 +43,5 @@
 
 void* altera_avalon_timer_ts_base = (void*) 0;
 alt_u32 altera_avalon_timer_ts_freq = 0;
+alt_u32 altera_avalon_timer_ts_irq_controller_id = 0;
+alt_32 altera_avalon_timer_ts_irq = -1;
@@ -26,6 +26,9 @@ int SharedData = 0;
 #define TASK2_PRIORITY      7
 #define TASK_STAT_PRIORITY 12  // lowest priority 
 
+/* Period of task1 and task2, converted to ticks at compile time */
+#define TASK_PERIOD OS_TIME_HMSM_TICKS(0, 0, 0, 100)
+
 void printStackSize(char* name, INT8U prio) 
 {
   INT8U err;
@@ -48,6 +51,7 @@ void printStackSize(char* name, INT8U prio)
 void task1(void* pdata)
 {
   INT8U err;
+  INT32U last_wake = OSTimeGet();
   int i;
   
   while (1)
@@ -57,7 +61,7 @@ void task1(void* pdata)
       printf("Sending : %d \n", SharedData);
       OSSemPost(Sem2);
 
-      OSTimeDlyHMSM(0, 0, 0, 100); 
+      OSTimeDlyUntil(&last_wake, TASK_PERIOD); 
       /* Context Switch to next task
 				   * Task will go to the ready state
 				   * after the specified delay
@@ -70,6 +74,7 @@ void task1(void* pdata)
 void task2(void* pdata)
 {
   INT8U err;
+  INT32U last_wake = OSTimeGet();
   int i;
   while (1)
     { 
@@ -81,7 +86,7 @@ void task2(void* pdata)
      
       OSSemPost(Sem1);
 
-      OSTimeDlyHMSM(0, 0, 0, 100);
+      OSTimeDlyUntil(&last_wake, TASK_PERIOD);
       
     }
 }
@@ -109,9 +109,15 @@ static ALT_INLINE int ALT_ALWAYS_INLINE alt_sysclk_init (alt_u32 nticks)
 
 static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_nticks (void)
 {
-  return _alt_nticks;
+  return (alt_u32) _alt_nticks;
 }
 
+/*
+ * alt_nticks64() returns the same count in full, which does not wrap.
+ */
+
+extern alt_u64 alt_nticks64 (void);
+
 /*
  * alt_tick() should only be called by the system clock driver. This is used
  * to notify the system that the system timer period has expired.
@@ -119,6 +125,21 @@ static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_nticks (void)
 
 extern void alt_tick (void);
 
+/*
+ * alt_tick_n() is the equivalent of 'nticks' calls to alt_tick(). It is used
+ * by a system clock driver that stops the periodic interrupt while the CPU is
+ * idle. It is only available when the operating system supports it.
+ */
+
+extern void alt_tick_n (alt_u32 nticks);
+
+/*
+ * alt_alarm_next() returns the number of system clock ticks until the first
+ * registered alarm is due, or zero if no alarm is registered.
+ */
+
+extern alt_u32 alt_alarm_next (void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,87 @@
+#ifndef __ALT_IRQ_TRACE_H__
+#define __ALT_IRQ_TRACE_H__
+
+/*
+ * alt_irq_trace.h measures for how long, and from where, interrupts are
+ * disabled.
+ *
+ * When the BSP and the application are built with -DALT_IRQ_TRACE (see
+ * public.mk), alt_irq_disable_all() and alt_irq_enable_all() are replaced
+ * by the functions below. The call that turns interrupts off remembers its
+ * file and line and reads a free running timer; the call that turns them
+ * back on reads it again. OS_ENTER_CRITICAL() and OS_EXIT_CRITICAL() are
+ * built on the same two calls, so the kernel is traced along with the HAL
+ * and the drivers.
+ *
+ * The results are kept per call site in a fixed table: the number of
+ * sections, the longest one and a histogram of their lengths. Only the
+ * outermost pair of nested calls is timed, and its time is charged to the
+ * site that disabled interrupts, including any context switch made before
+ * they were enabled again. ISRs, which run with interrupts disabled by the
+ * CPU, are not timed.
+ *
+ * The timer, timer_1 unless ALT_IRQ_TRACE_TIMER_BASE says otherwise, is
+ * started by alt_irq_trace_start() and must not be used for anything else.
+ * The one exception is the high-resolution timer service: when it is built
+ * too (-DALT_HRTIMER), the tracer reads its time base instead, see
+ * sys/alt_hrtimer.h.
+ */
+
+#ifdef ALT_IRQ_TRACE
+
+#include "alt_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/*
+ * Size of the call site table. Sites that do not fit are counted in
+ * alt_irq_trace_lost.
+ */
+#define ALT_IRQ_TRACE_SITES     64
+
+/*
+ * Histogram bins, in timer cycles: bin 0 counts sections shorter than
+ * 2^ALT_IRQ_TRACE_BIN0_LOG2 cycles, each next bin doubles the limit and the
+ * last one counts everything longer.
+ */
+#define ALT_IRQ_TRACE_BINS      8
+#define ALT_IRQ_TRACE_BIN0_LOG2 7
+
+typedef struct alt_irq_trace_site_s
+{
+  const char* file;
+  alt_u32     line;
+  alt_u32     count;
+  alt_u32     max;
+  alt_u32     hist[ALT_IRQ_TRACE_BINS];
+} alt_irq_trace_site;
+
+extern alt_irq_trace_site alt_irq_trace_tbl[ALT_IRQ_TRACE_SITES];
+extern alt_u32            alt_irq_trace_lost;
+
+extern alt_irq_context alt_irq_trace_disable (const char* file, int line);
+extern void            alt_irq_trace_enable  (alt_irq_context context);
+
+/*
+ * alt_irq_trace_start() clears the table and starts the timer. Nothing is
+ * recorded before it is called.
+ *
+ * alt_irq_trace_dump() prints the sites, longest section first, on stdout
+ * (the JTAG UART). Tracing is paused while it runs.
+ */
+extern void alt_irq_trace_start (void);
+extern void alt_irq_trace_dump  (void);
+
+#define alt_irq_disable_all()        alt_irq_trace_disable (__FILE__, __LINE__)
+#define alt_irq_enable_all(context)  alt_irq_trace_enable (context)
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* ALT_IRQ_TRACE */
+
+#endif /* __ALT_IRQ_TRACE_H__ */
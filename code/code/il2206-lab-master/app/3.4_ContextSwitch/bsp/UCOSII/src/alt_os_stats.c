@@ -0,0 +1,65 @@
+/*
+ * Kernel statistics report, see os/alt_os_stats.h.
+ *
+ * Each timer is copied with OSTmrStatsGet() before it is printed, so that
+ * the timer lock is not held across printf().
+ */
+
+#include <stdio.h>
+
+#include "includes.h"
+#include "os/alt_os_stats.h"
+
+#if OS_TMR_STATS_EN > 0
+static void alt_os_stats_hist (const char* name, INT32U* bins)
+{
+  INT32U i;
+
+  printf ("    %-6s", name);
+  for (i = 0; i < OS_TMR_STATS_BINS; i++)
+  {
+    printf (" %lu", bins[i]);
+  }
+  printf ("\n");
+}
+#endif
+
+void alt_os_stats_dump (void)
+{
+#if OS_TMR_STATS_EN > 0
+  OS_TMR_STATS stats;
+  INT8U        name[OS_TMR_CFG_NAME_SIZE > 0 ? OS_TMR_CFG_NAME_SIZE : 1];
+  INT8U        err;
+  INT16U       i;
+#endif
+
+#if OS_TIME_GET_SET_EN > 0
+  printf ("Ticks            %llu\n", OSTimeGet64 ());
+#endif
+  printf ("Context switches %lu\n", OSCtxSwCtr);
+#if OS_TASK_STAT_EN > 0
+  printf ("CPU usage        %u%%\n", OSCPUUsage);
+#endif
+
+#if OS_TMR_STATS_EN > 0
+  printf ("Timers: expiries, most ticks late, longest callback in cycles\n"
+          "    late   histogram, 0, 1, ... ticks\n"
+          "    cycles histogram, < %u cycles and doubling\n",
+          1u << OS_TMR_STATS_BIN0_LOG2);
+  for (i = 0; i < OS_TMR_CFG_MAX; i++)
+  {
+    if (!OSTmrStatsGet (&OSTmrTbl[i], &stats, &err))
+    {
+      continue;                 /* not in use */
+    }
+    name[0] = 0;
+#if OS_TMR_CFG_NAME_SIZE > 0
+    (void) OSTmrNameGet (&OSTmrTbl[i], name, &err);
+#endif
+    printf ("%-16s %8lu %4lu %8lu\n", (char*) name, stats.OSTmrStatsExpiries,
+            stats.OSTmrStatsLateMax, stats.OSTmrStatsCyclesMax);
+    alt_os_stats_hist ("late", stats.OSTmrStatsLate);
+    alt_os_stats_hist ("cycles", stats.OSTmrStatsCycles);
+  }
+#endif
+}
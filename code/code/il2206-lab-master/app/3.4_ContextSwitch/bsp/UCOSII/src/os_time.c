@@ -25,6 +25,14 @@
 #include <ucos_ii.h>
 #endif
 
+/*
+*********************************************************************************************************
+*                                          LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  OS_TimeDlyCur (INT16U ticks);
+
 /*
 *********************************************************************************************************
 *                                DELAY TASK 'n' TICKS   (n from 0 to 65535)
@@ -43,7 +51,6 @@
 
 void  OSTimeDly (INT16U ticks)
 {
-    INT8U      y;
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -55,16 +62,48 @@ void  OSTimeDly (INT16U ticks)
     }
     if (ticks > 0) {                             /* 0 means no delay!                                  */
         OS_ENTER_CRITICAL();
-        y            =  OSTCBCur->OSTCBY;        /* Delay current task                                 */
-        OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
-        if (OSRdyTbl[y] == 0) {
-            OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
-        }
-        OSTCBCur->OSTCBDly = ticks;              /* Load ticks in TCB                                  */
+        OS_TimeDlyCur(ticks);
         OS_EXIT_CRITICAL();
         OS_Sched();                              /* Find next task to run!                             */
     }
 }
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      DELAY THE CURRENT TASK
+*
+* Description: This function removes the current task from the ready list and loads its delay.  It is
+*              called with interrupts disabled, by OSTimeDly() and OSTimeDlyUntil(); the caller must
+*              then call OS_Sched().
+*
+* Arguments  : ticks     is the delay, in clock ticks (> 0).
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_TimeDlyCur (INT16U ticks)
+{
+#if OS_RR_EN == 0
+    INT8U      y;
+#endif
+
+
+#if OS_RR_EN > 0
+    OS_RdyListRemove(OSTCBCur);                  /* Delay current task                                 */
+#else
+    y            =  OSTCBCur->OSTCBY;            /* Delay current task                                 */
+    OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
+    if (OSRdyTbl[y] == 0) {
+        OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
+    }
+#endif
+    OSTCBCur->OSTCBDly = ticks;                  /* Load ticks in TCB                                  */
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur);                 /* Link TCB into the tick list                        */
+#endif
+}
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -123,9 +162,10 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
     }
 #endif
                                                  /* Compute the total number of clock ticks required.. */
-                                                 /* .. (rounded to the nearest tick)                   */
-    ticks = ((INT32U)hours * 3600L + (INT32U)minutes * 60L + (INT32U)seconds) * OS_TICKS_PER_SEC
-          + OS_TICKS_PER_SEC * ((INT32U)ms + 500L / OS_TICKS_PER_SEC) / 1000L;
+                                                 /* .. (rounded to the nearest tick), in integers and  */
+                                                 /* .. without a division: ms are scaled in 16.16      */
+    ticks = ((INT32U)hours * 3600uL + (INT32U)minutes * 60uL + (INT32U)seconds) * OS_TICK_RATE
+          + (((INT32U)ms * OS_TICK_MS_Q16 + 0x8000uL) >> 16);
     loops = (INT16U)(ticks >> 16);               /* Compute the integral number of 65536 tick delays   */
     ticks = ticks & 0xFFFFL;                     /* Obtain  the fractional number of ticks             */
     OSTimeDly((INT16U)ticks);
@@ -140,6 +180,109 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                      DELAY TASK UNTIL AN ABSOLUTE TIME
+*
+* Description: This function is called to make a task run periodically, without drift.  The task is
+*              delayed until '*plast' + 'period', the wake-up time being computed from the previous one
+*              instead of from the time of the call.  '*plast' is then set to this new wake-up time:
+*
+*                  INT32U  last = OSTimeGet();
+*
+*                  for (;;) {
+*                      ...
+*                      OSTimeDlyUntil(&last, OS_TIME_HMSM_TICKS(0, 0, 0, 100));
+*                  }
+*
+*              If the task was late and one or more wake-up times have already passed, they are skipped,
+*              so the task stays in phase, and their number is returned.
+*
+* Arguments  : plast     is a pointer to the previous wake-up time, a value of OSTime (see OSTimeGet()).
+*
+*              period    is the time between two wake-ups, in clock ticks.
+*
+* Returns    : the number of periods missed (0 when the task was on time), saturated at 65535.
+*
+* Note(s)    : 1) The periods to skip are computed with interrupts enabled, by a shift-subtract division
+*                 (the CPU has no divider), so a long overrun does not lengthen the interrupt latency.
+*                 The time is then read again and the delay loaded with interrupts disabled; if a tick
+*                 has moved past the new wake-up time meanwhile, the skip is computed again.
+*              2) Nothing is done if called from an ISR, with a NULL 'plast' or a 0 'period'.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_DLY_UNTIL_EN > 0
+INT16U  OSTimeDlyUntil (INT32U *plast, INT16U period)
+{
+    INT32U     now;
+    INT32U     wake;
+    INT32U     late;
+    INT32U     rem;
+    INT32U     skip;
+    INT32U     missed;
+    INT8U      i;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
+        return (0);
+    }
+    if ((plast == (INT32U *)0) || (period == 0)) {
+        return (0);
+    }
+    missed = 0;
+    OS_ENTER_CRITICAL();
+    now    = (INT32U)OSTime;
+    wake   = *plast + period;
+    OS_EXIT_CRITICAL();
+    for (;;) {
+        late = now - wake;
+        if ((INT32S)late > 0) {                  /* Skip the wake-up times already past ...            */
+            rem  = 0;                            /* ... 'skip' = late / period, 'rem' = late % period  */
+            skip = 0;
+            for (i = 0; i < 32; i++) {
+                rem   = (rem  << 1) | (late >> 31);
+                late  =  late << 1;
+                skip  =  skip << 1;
+                if (rem >= period) {
+                    rem  -= period;
+                    skip |= 1;
+                }
+            }
+            if (rem == 0) {                      /* 'now' is itself a wake-up time                     */
+                wake  = now;
+            } else {                             /* Next wake-up time after 'now'                      */
+                wake  = now + (period - rem);
+                skip++;
+            }
+            missed += skip;
+            if (missed > 65535uL) {              /* Saturate the count                                 */
+                missed = 65535uL;
+            }
+        }
+        OS_ENTER_CRITICAL();
+        now = (INT32U)OSTime;
+        if ((INT32S)(now - wake) <= 0) {         /* Still ahead (or on time): commit the wake-up time  */
+            break;
+        }
+        OS_EXIT_CRITICAL();                      /* A tick moved past 'wake' meanwhile, skip again     */
+    }
+    *plast = wake;
+    if (wake != now) {
+        OS_TimeDlyCur((INT16U)(wake - now));     /* At most one period                                 */
+        OS_EXIT_CRITICAL();
+        OS_Sched();
+    } else {
+        OS_EXIT_CRITICAL();
+    }
+    return ((INT16U)missed);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                         RESUME A DELAYED TASK
 *
 * Description: This function is used resume a task that has been delayed through a call to either
@@ -167,6 +310,9 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
 INT8U  OSTimeDlyResume (INT8U prio)
 {
     OS_TCB    *ptcb;
+#if OS_RR_EN > 0
+    OS_TCB    *psib;
+#endif
 #if OS_CRITICAL_METHOD == 3                                    /* Storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -186,12 +332,25 @@ INT8U  OSTimeDlyResume (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);                        /* The task does not exist              */
     }
+#if OS_RR_EN > 0
+    psib = ptcb;
+    while (ptcb->OSTCBDly == 0) {                              /* First delayed task at this priority  */
+        ptcb = ptcb->OSTCBSibNext;
+        if (ptcb == psib) {
+            break;
+        }
+    }
+#endif
     if (ptcb->OSTCBDly == 0) {                                 /* See if task is delayed               */
         OS_EXIT_CRITICAL();
         return (OS_ERR_TIME_NOT_DLY);                          /* Indicate that task was not delayed   */
     }
 
+#if OS_TICK_LIST_EN > 0
+    OS_TickListRemove(ptcb);                                   /* Clear the time delay                 */
+#else
     ptcb->OSTCBDly = 0;                                        /* Clear the time delay                 */
+#endif
     if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
         ptcb->OSTCBStat     &= ~OS_STAT_PEND_ANY;              /* Yes, Clear status flag               */
         ptcb->OSTCBStatPend  =  OS_STAT_PEND_TO;               /* Indicate PEND timeout                */
@@ -199,8 +358,12 @@ INT8U  OSTimeDlyResume (INT8U prio)
         ptcb->OSTCBStatPend  =  OS_STAT_PEND_OK;
     }
     if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?                   */
+#if OS_RR_EN > 0
+        OS_RdyListInsert(ptcb);                                /* No,  Make ready                      */
+#else
         OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready                      */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
         OS_EXIT_CRITICAL();
         OS_Sched();                                            /* See if this is new highest priority  */
     } else {
@@ -219,7 +382,10 @@ INT8U  OSTimeDlyResume (INT8U prio)
 *
 * Arguments  : none
 *
-* Returns    : The current value of OSTime
+* Returns    : The low 32 bits of OSTime
+*
+* Note(s)    : 1) The value wraps after 2^32 ticks; differences taken in 32-bit unsigned arithmetic stay
+*                 correct across the wrap.
 *********************************************************************************************************
 */
 
@@ -233,6 +399,41 @@ INT32U  OSTimeGet (void)
 
 
 
+    OS_ENTER_CRITICAL();
+    ticks = (INT32U)OSTime;
+    OS_EXIT_CRITICAL();
+    return (ticks);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     GET CURRENT SYSTEM TIME, 64 BITS
+*
+* Description: This function returns the number of clock ticks since OSInit() or the last OSTimeSet().
+*              At 1000 ticks per second the count does not wrap for over 500 million years.
+*
+* Arguments  : none
+*
+* Returns    : The current value of OSTime
+*
+* Note(s)    : 1) OSTime is 64 bits wide so that OSTimeTick() updates it with a plain add and carry, and
+*                 no wrap needs to be handled anywhere.
+*              2) The critical section keeps the two halves consistent on this 32-bit CPU.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_GET_SET_EN > 0
+INT64U  OSTimeGet64 (void)
+{
+    INT64U     ticks;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
     OS_ENTER_CRITICAL();
     ticks = OSTime;
     OS_EXIT_CRITICAL();
@@ -244,7 +445,8 @@ INT32U  OSTimeGet (void)
 *********************************************************************************************************
 *                                            SET SYSTEM CLOCK
 *
-* Description: This function sets the 32-bit counter which keeps track of the number of clock ticks.
+* Description: This function sets the counter which keeps track of the number of clock ticks. Its upper
+*              32 bits are cleared.
 *
 * Arguments  : ticks      specifies the new value that OSTime needs to take.
 *
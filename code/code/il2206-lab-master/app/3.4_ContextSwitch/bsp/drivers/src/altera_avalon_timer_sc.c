@@ -40,6 +40,190 @@
 
 #include "alt_types.h"
 #include "sys/alt_log_printf.h"
+#include "os/alt_hooks.h"
+
+/*
+ * When the operating system can accept several ticks at once (it defines
+ * ALT_OS_TIME_TICK_N) the system clock can be put to sleep by the idle task:
+ * alt_avalon_timer_sc_sleep() reprograms the period register so that the
+ * next interrupt arrives on a tick boundary several ticks away, and the
+ * interrupt handler then reports all of them through alt_tick_n().
+ *
+ * If another interrupt wakes up a task before that, the operating system
+ * calls alt_avalon_timer_sc_wake(), which reports the ticks elapsed so far
+ * and shortens the current period so that the next interrupt falls on the
+ * next tick boundary again.
+ */
+
+#ifdef ALT_OS_TIME_TICK_N
+
+static void*   sc_base;     /* system clock timer                            */
+static alt_u32 sc_cycles;   /* timer cycles per tick (period register + 1)   */
+static alt_u32 sc_top;      /* sc_cycles << (sc_bits - 1)                    */
+static alt_u8  sc_bits;     /* a sleep lasts less than 2^sc_bits ticks       */
+static alt_u32 sc_sleep;    /* ticks programmed for this sleep, 0 if ticking */
+static alt_u8  sc_realign;  /* current period ends on a tick boundary only   */
+
+/*
+ * The core has no hardware multiplier or divider, so tick counts and timer
+ * cycles are converted with shifts and adds, one step per bit of the tick
+ * count, rather than with the libgcc routines. Both run with interrupts
+ * disabled.
+ */
+
+/*
+ * Return nticks * sc_cycles, for nticks < 2^sc_bits.
+ */
+
+static alt_u32 alt_avalon_timer_sc_ticks_to_cycles (alt_u32 nticks)
+{
+  alt_u32 cycles = 0;
+  alt_u32 step   = sc_cycles;
+
+  while (nticks)
+  {
+    if (nticks & 1)
+    {
+      cycles += step;
+    }
+    step   += step;
+    nticks >>= 1;
+  }
+  return cycles;
+}
+
+/*
+ * Return the number of whole ticks in *cycles and leave the rest in *cycles,
+ * for *cycles < 2^sc_bits * sc_cycles.
+ */
+
+static alt_u32 alt_avalon_timer_sc_cycles_to_ticks (alt_u32* cycles)
+{
+  alt_u32 nticks = 0;
+  alt_u32 step   = sc_top;
+  alt_u8  bit;
+
+  for (bit = sc_bits; bit > 0; bit--)
+  {
+    nticks <<= 1;
+    if (*cycles >= step)
+    {
+      *cycles -= step;
+      nticks  |= 1;
+    }
+    step >>= 1;
+  }
+  return nticks;
+}
+
+/*
+ * Write a new period to the timer and restart it in continuous mode. Writing
+ * either period register stops the counter.
+ */
+
+static void alt_avalon_timer_sc_period (void* base, alt_u32 cycles)
+{
+  IOWR_ALTERA_AVALON_TIMER_PERIODL (base, (cycles - 1) & 0xFFFF);
+  IOWR_ALTERA_AVALON_TIMER_PERIODH (base, ((cycles - 1) >> 16) & 0xFFFF);
+  IOWR_ALTERA_AVALON_TIMER_CONTROL (base, 
+            ALTERA_AVALON_TIMER_CONTROL_ITO_MSK  |
+            ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+            ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+}
+
+/*
+ * Return the number of cycles left in the current period.
+ */
+
+static alt_u32 alt_avalon_timer_sc_remain (void* base)
+{
+  IOWR_ALTERA_AVALON_TIMER_SNAPL (base, 0);
+  return (IORD_ALTERA_AVALON_TIMER_SNAPL (base) & ALTERA_AVALON_TIMER_SNAPL_MSK) |
+         ((IORD_ALTERA_AVALON_TIMER_SNAPH (base) & ALTERA_AVALON_TIMER_SNAPH_MSK) << 16);
+}
+
+/*
+ * alt_avalon_timer_sc_sleep() is called by the idle task, with interrupts
+ * disabled, to hold off the system clock interrupt for "nticks" ticks. The
+ * caller is responsible for making sure that nothing is due before then.
+ * Nothing is done if a tick is already pending or if the clock already
+ * sleeps.
+ */
+
+void alt_avalon_timer_sc_sleep (alt_u32 nticks)
+{
+  alt_u32 remain;
+
+  if ((sc_base == NULL) || (sc_sleep != 0) || sc_realign || (nticks < 2))
+  {
+    return;
+  }
+  if (nticks >= (1uL << sc_bits))
+  {
+    nticks = (1uL << sc_bits) - 1;    /* the period register holds 32 bits */
+  }
+  if (IORD_ALTERA_AVALON_TIMER_STATUS (sc_base) & ALTERA_AVALON_TIMER_STATUS_TO_MSK)
+  {
+    return;
+  }
+  remain = alt_avalon_timer_sc_remain (sc_base);
+
+  /* keep the phase: the interrupt lands on the boundary of tick "nticks" */
+
+  alt_avalon_timer_sc_period (sc_base, remain + 1 +
+                              alt_avalon_timer_sc_ticks_to_cycles (nticks - 1));
+  sc_sleep = nticks;
+}
+
+/*
+ * alt_avalon_timer_sc_wake() is called by the operating system, at interrupt
+ * level, when a task is made ready while the system clock sleeps. The ticks
+ * that have fully elapsed are reported now and the timer is set to interrupt
+ * on the next tick boundary.
+ */
+
+void alt_avalon_timer_sc_wake (void)
+{
+  alt_u32 remain;
+  alt_u32 left;
+  alt_u32 elapsed;
+
+  if (sc_sleep == 0)
+  {
+    return;
+  }
+  if (IORD_ALTERA_AVALON_TIMER_STATUS (sc_base) & ALTERA_AVALON_TIMER_STATUS_TO_MSK)
+  {
+    /* the whole sleep has elapsed, the interrupt just has not been taken */
+
+    IOWR_ALTERA_AVALON_TIMER_STATUS (sc_base, 0);
+    alt_avalon_timer_sc_period (sc_base, sc_cycles);
+    elapsed  = sc_sleep;
+  }
+  else
+  {
+    remain   = alt_avalon_timer_sc_remain (sc_base);
+    left     = alt_avalon_timer_sc_cycles_to_ticks (&remain); /* whole ticks still to go, */
+                                                               /* then cycles to boundary */
+    elapsed  = sc_sleep - 1 - left;
+    if (remain != 0)
+    {
+      alt_avalon_timer_sc_period (sc_base, remain);
+      sc_realign = 1;
+    }
+    else
+    {
+      alt_avalon_timer_sc_period (sc_base, sc_cycles);
+    }
+  }
+  sc_sleep = 0;
+  if (elapsed)
+  {
+    alt_tick_n (elapsed);
+  }
+}
+
+#endif /* ALT_OS_TIME_TICK_N */
 
 /* 
  * alt_avalon_timer_sc_irq() is the interrupt handler used for the system 
@@ -71,6 +255,28 @@ static void alt_avalon_timer_sc_irq (void* base, alt_u32 id)
   /* ALT_LOG - see altera_hal/HAL/inc/sys/alt_log_printf.h */
   ALT_LOG_SYS_CLK_HEARTBEAT();
 
+#ifdef ALT_OS_TIME_TICK_N
+  /*
+   * End of a sleep or of a shortened period: go back to one interrupt per
+   * tick. The few cycles between the timeout and this write are lost.
+   */
+  if (sc_sleep || sc_realign)
+  {
+    alt_u32 nticks = sc_sleep;
+
+    alt_avalon_timer_sc_period (base, sc_cycles);
+    sc_sleep   = 0;
+    sc_realign = 0;
+    if (nticks > 1)
+    {
+      cpu_sr = alt_irq_disable_all();
+      alt_tick_n (nticks);
+      alt_irq_enable_all(cpu_sr);
+      return;
+    }
+  }
+#endif
+
   /* 
    * Notify the system of a clock tick. disable interrupts 
    * during this time to safely support ISR preemption
@@ -92,6 +298,24 @@ void alt_avalon_timer_sc_init (void* base, alt_u32 irq_controller_id,
   /* set the system clock frequency */
   
   alt_sysclk_init (freq);
+
+#ifdef ALT_OS_TIME_TICK_N
+  /* remember the tick period programmed by the hardware configuration */
+
+  sc_base   = base;
+  sc_cycles = ((IORD_ALTERA_AVALON_TIMER_PERIODL (base) & ALTERA_AVALON_TIMER_PERIODL_MSK) |
+               ((IORD_ALTERA_AVALON_TIMER_PERIODH (base) & ALTERA_AVALON_TIMER_PERIODH_MSK) << 16)) + 1;
+
+  /* longest sleep: 2^16 - 1 ticks, or less if the period would overflow */
+
+  sc_bits = 1;
+  sc_top  = sc_cycles;
+  while ((sc_bits < 16) && (sc_top <= (0x7fffffff >> 1)))
+  {
+    sc_bits++;
+    sc_top <<= 1;
+  }
+#endif
   
   /* set to free running mode */
   
@@ -0,0 +1,132 @@
+#ifndef __ALT_HRTIMER_H__
+#define __ALT_HRTIMER_H__
+
+/*
+ * alt_hrtimer.h provides one-shot and periodic timers with microsecond
+ * deadlines, for the cases where the system clock (1 ms) and the uC/OS-II
+ * software timers (OS_TMR_CFG_TICKS_PER_SEC) are too coarse.
+ *
+ * The service is built into the BSP and the application with -DALT_HRTIMER
+ * (see public.mk) and takes a timer of its own, timer_1 unless
+ * ALT_HRTIMER_TIMER_BASE says otherwise. The timer runs continuously and
+ * extends its counter into a 64-bit count of timer cycles since
+ * alt_hrtimer_init(), returned by alt_hrtimer_now(). Pending timers are
+ * kept in a list sorted by deadline and the period of the hardware is
+ * reloaded, at each start, stop and expiry, so that it times out at the
+ * earliest deadline.
+ *
+ * A callback runs in the timer ISR, with interrupts disabled, unless the
+ * timer is started with ALT_HRTIMER_DEFERRED. It is then queued with
+ * OSIntDefer() and called by the uC/OS-II defer task, at task level
+ * (requires OS_ISR_DEFER_EN; without it, all callbacks run in the ISR).
+ * Periodic timers are rearmed from their previous deadline, not from the
+ * time of the callback, so their period does not drift.
+ *
+ * Limits:
+ * - Reloading the period stops the counter for the few cycles between
+ *   the read of the counter and the restart, which alt_hrtimer_now()
+ *   loses each time.
+ * - The timer ISR must run before the counter times out a second time,
+ *   that is within ALT_HRTIMER_MIN_CYCLES of the first time out, or
+ *   a whole period is lost from the time base.
+ * - A deadline closer than ALT_HRTIMER_MIN_CYCLES to the current time is
+ *   served ALT_HRTIMER_MIN_CYCLES from now.
+ *
+ * The interrupt-disabled time tracer (sys/alt_irq_trace.h), which also
+ * defaults to timer_1, takes its time stamps from alt_hrtimer_now() when
+ * both are built.
+ */
+
+#ifdef ALT_HRTIMER
+
+#include "system.h"
+#include "alt_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+#ifndef ALT_HRTIMER_TIMER_BASE
+#define ALT_HRTIMER_TIMER_BASE        TIMER_1_BASE
+#define ALT_HRTIMER_TIMER_IRQ         TIMER_1_IRQ
+#define ALT_HRTIMER_TIMER_IRQ_IC_ID   TIMER_1_IRQ_INTERRUPT_CONTROLLER_ID
+#define ALT_HRTIMER_TIMER_FREQ        TIMER_1_FREQ
+#endif
+
+/*
+ * Timer cycles per microsecond. The timer clock must be a whole number of
+ * MHz.
+ */
+#define ALT_HRTIMER_CYCLES_PER_US     ((alt_u32) (ALT_HRTIMER_TIMER_FREQ / 1000000))
+
+/*
+ * Shortest period loaded into the timer, 10 us: an upper bound on the
+ * latency of its ISR, and the shortest period of a periodic timer.
+ */
+#ifndef ALT_HRTIMER_MIN_CYCLES
+#define ALT_HRTIMER_MIN_CYCLES        (10 * ALT_HRTIMER_CYCLES_PER_US)
+#endif
+
+/* Options of alt_hrtimer_start() */
+#define ALT_HRTIMER_DEFERRED          0x01  /* Call back at task level       */
+
+/*
+ * "alt_hrtimer" is a timer. Like alt_alarm, its contents are set up by
+ * alt_hrtimer_start() and belong to the service until the timer expires
+ * (one-shot) or is stopped.
+ */
+
+typedef struct alt_hrtimer_s alt_hrtimer;
+
+struct alt_hrtimer_s
+{
+  alt_hrtimer* next;                    /* next timer, by deadline */
+  alt_u64      expires;                 /* deadline, in alt_hrtimer_now() cycles */
+  alt_u32      period;                  /* cycles, 0 for a one-shot timer */
+  void         (*callback) (void* context);
+  void*        context;
+  alt_u8       opt;                     /* ALT_HRTIMER_xxx options */
+  alt_u8       state;                   /* see alt_hrtimer.c */
+};
+
+/*
+ * alt_hrtimer_init() starts the timer and registers its ISR. It is called
+ * by alt_hrtimer_start() and alt_irq_trace_start() if needed.
+ */
+extern void alt_hrtimer_init (void);
+
+/*
+ * alt_hrtimer_start() arms "timer" to call "callback" "delay_us"
+ * microseconds from now, then every "period_us" microseconds if that is
+ * not zero. A running timer is restarted. Returns -EINVAL if the period is
+ * shorter than ALT_HRTIMER_MIN_CYCLES.
+ *
+ * alt_hrtimer_stop() disarms "timer". A deferred callback already queued
+ * is still made.
+ *
+ * Both may be called from a callback, including on its own timer.
+ */
+extern int  alt_hrtimer_start (alt_hrtimer* timer,
+                               alt_u32      delay_us,
+                               alt_u32      period_us,
+                               void         (*callback) (void* context),
+                               void*        context,
+                               alt_u8       opt);
+extern void alt_hrtimer_stop  (alt_hrtimer* timer);
+
+/*
+ * alt_hrtimer_now() returns the number of timer cycles since
+ * alt_hrtimer_init(). alt_hrtimer_time() is the same, for callers that
+ * already run with interrupts disabled.
+ */
+extern alt_u64 alt_hrtimer_now  (void);
+extern alt_u64 alt_hrtimer_time (void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* ALT_HRTIMER */
+
+#endif /* __ALT_HRTIMER_H__ */
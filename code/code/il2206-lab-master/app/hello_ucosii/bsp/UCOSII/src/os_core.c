@@ -73,10 +73,40 @@ static  void  OS_InitTaskIdle(void);
 static  void  OS_InitTaskStat(void);
 #endif
 
+#if OS_ISR_DEFER_EN > 0
+static  void  OS_InitTaskDefer(void);
+#endif
+
+#if OS_IDLE_JOB_EN > 0
+static  void  OS_IdleJobRun(void);
+#endif
+
+#if (OS_IDLE_JOB_EN > 0) && (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+static  void  OS_IdleJobStkChk(void *p_arg);
+#endif
+
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+static  void  OS_TaskStkChkPrio(INT8U prio);
+#endif
+
 static  void  OS_InitTCBList(void);
 
 static  void  OS_SchedNew(void);
 
+#if OS_EDF_EN > 0
+static  INT8U  OS_EDF_SchedNew(INT8U prio);
+#endif
+
+#if OS_PREEMPT_THRESH_EN > 0
+static  void  OS_SchedThresh(void);
+#endif
+
+static  void  OS_TimeTickExpire(OS_TCB *ptcb);
+
+#if (OS_EVENT_EN) && (OS_RR_EN > 0)
+static  BOOLEAN  OS_EventTaskWaits(OS_TCB *ptcb, OS_EVENT *pevent);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -459,6 +489,9 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
                                OS_STAT_MULTI;           /* ... pend on multiple events                 */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly       = timeout;                 /* Store pend timeout in TCB                   */
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur);                        /* Link TCB into the tick list                 */
+#endif
     OS_EventTaskWaitMulti(pevents_pend);                /* Suspend task until events or timeout occurs */
 
     OS_EXIT_CRITICAL();
@@ -537,6 +570,109 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
 }
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          ADD AN IDLE JOB
+*
+* Description: This function registers a job that the idle task runs in the time no other task needs.  The
+*              idle task calls the registered jobs in turn, one call per pass of its loop.  A job is not
+*              given a stack or a priority of its own: each call must do a small, bounded step of work and
+*              return, keeping whatever it needs to resume in the structure 'p_arg' points to.
+*
+* Arguments  : fnct     is the function doing one step of the job.
+*
+*              p_arg    is passed to 'fnct' on every call.
+*
+* Returns    : OS_ERR_NONE             if the job was added
+*              OS_ERR_IDLE_JOB_NULL    if 'fnct' is a NULL pointer
+*              OS_ERR_IDLE_JOB_FULL    if OS_MAX_IDLE_JOBS jobs are already registered
+*
+* Note(s)    : 1) A job runs at the priority of the idle task and must never call a service that waits.
+*              2) The time taken by the jobs is reported as CPU usage by the statistic task.  Jobs are not
+*                 called while OSStatInit() measures the speed of the idle loop.
+*              3) The same function may be registered several times with different arguments.
+*********************************************************************************************************
+*/
+
+#if OS_IDLE_JOB_EN > 0
+INT8U  OSIdleJobAdd (OS_IDLE_JOB_FNCT fnct, void *p_arg)
+{
+    OS_IDLE_JOB  *pjob;
+    INT8U         i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR     cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (fnct == (OS_IDLE_JOB_FNCT)0) {                     /* Validate 'fnct'                          */
+        return (OS_ERR_IDLE_JOB_NULL);
+    }
+#endif
+    pjob = &OSIdleJobTbl[0];
+    OS_ENTER_CRITICAL();
+    for (i = 0; i < OS_MAX_IDLE_JOBS; i++) {               /* Find a free entry                        */
+        if (pjob->OSIdleJobFnct == (OS_IDLE_JOB_FNCT)0) {
+            pjob->OSIdleJobArg  = p_arg;
+            pjob->OSIdleJobFnct = fnct;
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_NONE);
+        }
+        pjob++;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_IDLE_JOB_FULL);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         DELETE AN IDLE JOB
+*
+* Description: This function removes a job registered by OSIdleJobAdd() with the same 'fnct' and 'p_arg'.
+*
+* Arguments  : fnct     is the function of the job.
+*
+*              p_arg    is the argument it was registered with.
+*
+* Returns    : OS_ERR_NONE                 if the job was removed
+*              OS_ERR_IDLE_JOB_NOT_FOUND   if no such job is registered
+*
+* Note(s)    : 1) If the idle task was preempted just before calling the job, it makes that last call when
+*                 it resumes.  Do not release the structure 'p_arg' points to before the idle task ran.
+*********************************************************************************************************
+*/
+
+#if OS_IDLE_JOB_EN > 0
+INT8U  OSIdleJobDel (OS_IDLE_JOB_FNCT fnct, void *p_arg)
+{
+    OS_IDLE_JOB  *pjob;
+    INT8U         i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR     cpu_sr = 0;
+#endif
+
+
+
+    pjob = &OSIdleJobTbl[0];
+    OS_ENTER_CRITICAL();
+    for (i = 0; i < OS_MAX_IDLE_JOBS; i++) {
+        if ((pjob->OSIdleJobFnct == fnct) && (pjob->OSIdleJobArg == p_arg)) {
+            pjob->OSIdleJobFnct = (OS_IDLE_JOB_FNCT)0;
+            pjob->OSIdleJobArg  = (void *)0;
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_NONE);
+        }
+        pjob++;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_IDLE_JOB_NOT_FOUND);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -575,10 +711,32 @@ void  OSInit (void)
     OS_QInit();                                                  /* Initialize the message queue structures  */
 #endif
 
+#if (OS_PORT_EN > 0) && (OS_MAX_PORTS > 0)
+    OS_PortInit();                                               /* Initialize the free list of state ports  */
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+    OS_RingInit();                                               /* Initialize the free list of ring channels */
+#endif
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+    OS_TopicInit();                                              /* Initialize the free list of topics       */
+#endif
+
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+    OS_WaitSetInit();                                            /* Initialize the free list of wait-sets    */
+#endif
+
     OS_InitTaskIdle();                                           /* Create the Idle Task                     */
 #if OS_TASK_STAT_EN > 0
     OS_InitTaskStat();                                           /* Create the Statistic Task                */
 #endif
+#if (OS_IDLE_JOB_EN > 0) && (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+    (void)OSIdleJobAdd(OS_IdleJobStkChk, (void *)0);             /* Check stacks from the idle task          */
+#endif
+#if OS_ISR_DEFER_EN > 0
+    OS_InitTaskDefer();                                          /* Create the task replaying ISR posts      */
+#endif
 
 #if OS_TMR_EN > 0
     OSTmr_Init();                                                /* Initialize the Timer Manager             */
@@ -645,6 +803,10 @@ void  OSIntEnter (void)
 *                 to OSIntEnter() at the beginning of the ISR you MUST have a call to OSIntExit() at the
 *                 end of the ISR.
 *              2) Rescheduling is prevented when the scheduler is locked (see OS_SchedLock())
+*              3) With OS_TICKLESS_EN, an ISR that readies a task while the idle task sleeps through
+*                 several ticks calls OSTicklessWakeHook() so that the ticks elapsed so far are
+*                 accounted for before the task runs.  This is done while OSIntNesting is still
+*                 non-zero so that any post made by the tick processing does not reschedule.
 *********************************************************************************************************
 */
 
@@ -658,14 +820,30 @@ void  OSIntExit (void)
 
     if (OSRunning == OS_TRUE) {
         OS_ENTER_CRITICAL();
+#if OS_TICKLESS_EN > 0
+        if ((OSIntNesting == 1) && (OSPrioCur == OS_TASK_IDLE_PRIO)) {
+            OS_SchedNew();
+            if (OSPrioHighRdy != OS_TASK_IDLE_PRIO) {      /* Idle task about to be preempted          */
+                OSTicklessWakeHook();                      /* ... catch up on the ticks it slept       */
+            }
+        }
+#endif
         if (OSIntNesting > 0) {                            /* Prevent OSIntNesting from wrapping       */
             OSIntNesting--;
         }
         if (OSIntNesting == 0) {                           /* Reschedule only if all ISRs complete ... */
             if (OSLockNesting == 0) {                      /* ... and not locked.                      */
                 OS_SchedNew();
+#if OS_PREEMPT_THRESH_EN > 0
+                OS_SchedThresh();                          /* Running task may be above the new one    */
+#endif
+#if OS_RR_EN > 0
+                OSTCBHighRdy = OSRdyHead[OSPrioHighRdy];   /* Several tasks may share that priority    */
+                if (OSTCBHighRdy != OSTCBCur) {            /* No Ctx Sw if current task is highest rdy */
+#else
                 if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy */
                     OSTCBHighRdy  = OSTCBPrioTbl[OSPrioHighRdy];
+#endif
 #if OS_TASK_PROFILE_EN > 0
                     OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task  */
 #endif
@@ -680,6 +858,90 @@ void  OSIntExit (void)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                       DEFER A POST FROM AN ISR
+*
+* Description: This function queues a post for OS_TaskDefer() instead of making it from the ISR.  Only the
+*              record is stored here, so the time spent with interrupts disabled does not depend on the
+*              number of waiting tasks or on the kind of object.  The post itself, with OS_EventTaskRdy()
+*              and the rest, is made by OS_TaskDefer() with interrupts enabled, as soon as the ISR returns
+*              to task level.
+*
+* Arguments  : op       is the post to make (see OS_DEFER_xxx in ucos_ii.h).
+*
+*              pobj     is the semaphore, mailbox, queue or event flag group to post to.  For the
+*                       OS_DEFER_NOTIFY_xxx operations, it is the priority of the task to notify, given as
+*                       OS_DEFER_PRIO(prio).  For OS_DEFER_CALL, it is the function to call.
+*
+*              arg      is the message (mailbox and queue), the flags to set or clear (event flag group),
+*                       the notification value, the number of timer ticks to signal (OS_DEFER_TMR_SIGNAL)
+*                       or the argument of the function.  It is ignored by the other operations.
+*
+* Returns    : OS_ERR_NONE          if the post was queued
+*              OS_ERR_INVALID_OPT   if 'op' is not a valid OS_DEFER_xxx operation
+*              OS_ERR_DEFER_FULL    if OS_ISR_DEFER_SIZE posts are already queued.  The post is lost and
+*                                   counted in OSDeferOvfCtr.
+*
+* Note(s)    : 1) Posts are replayed in the order they were queued.
+*              2) Errors returned by the post functions themselves are not reported.
+*              3) This function may also be called from a task; the post is then made before it returns
+*                 if OS_TASK_DEFER_PRIO is higher than the caller's priority.
+*********************************************************************************************************
+*/
+
+#if OS_ISR_DEFER_EN > 0
+INT8U  OSIntDefer (INT8U op, void *pobj, INT32U arg)
+{
+    OS_DEFER  *pdefer;
+    BOOLEAN    wake;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (op > OS_DEFER_CALL) {                              /* Validate 'op'                            */
+        return (OS_ERR_INVALID_OPT);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (OSDeferEntries >= OS_ISR_DEFER_SIZE) {             /* Make sure the ring is not full           */
+        OSDeferOvfCtr++;
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_DEFER_FULL);
+    }
+    pdefer             = &OSDeferTbl[OSDeferIn];
+    pdefer->OSDeferObj = pobj;
+    pdefer->OSDeferArg = arg;
+    pdefer->OSDeferOp  = op;
+    OSDeferIn++;
+    if (OSDeferIn == OS_ISR_DEFER_SIZE) {                  /* Wrap IN pointer if we are at end of ring */
+        OSDeferIn = 0;
+    }
+    OSDeferEntries++;
+    if (OSDeferEntries > OSDeferEntriesMax) {
+        OSDeferEntriesMax = OSDeferEntries;
+    }
+    wake = OSDeferWait;
+    if (wake == OS_TRUE) {                                 /* Make the defer task ready again          */
+        OSDeferWait = OS_FALSE;
+#if OS_RR_EN > 0
+        OS_RdyListInsert(OSDeferTCB);
+#else
+        OSRdyGrp                     |= OSDeferTCB->OSTCBBitY;
+        OSRdyTbl[OSDeferTCB->OSTCBY] |= OSDeferTCB->OSTCBBitX;
+#endif
+    }
+    OS_EXIT_CRITICAL();
+    if (wake == OS_TRUE) {
+        OS_Sched();                                        /* No effect from an ISR, see OSIntExit()   */
+    }
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                          PREVENT SCHEDULING
 *
 * Description: This function is used to prevent rescheduling to take place.  This allows your application
@@ -787,7 +1049,11 @@ void  OSStart (void)
     if (OSRunning == OS_FALSE) {
         OS_SchedNew();                               /* Find highest priority's task priority number   */
         OSPrioCur     = OSPrioHighRdy;
+#if OS_RR_EN > 0
+        OSTCBHighRdy  = OSRdyHead[OSPrioHighRdy];    /* Point to highest priority task ready to run    */
+#else
         OSTCBHighRdy  = OSTCBPrioTbl[OSPrioHighRdy]; /* Point to highest priority task ready to run    */
+#endif
         OSTCBCur      = OSTCBHighRdy;
         OSStartHighRdy();                            /* Execute target specific code to start task     */
     }
@@ -822,6 +1088,9 @@ void  OSStatInit (void)
 
 
 
+#if OS_IDLE_JOB_EN > 0
+    OSIdleJobHold = OS_TRUE;                     /* Measure an idle loop that runs no job              */
+#endif
     OSTimeDly(2);                                /* Synchronize with clock tick                        */
     OS_ENTER_CRITICAL();
     OSIdleCtr    = 0L;                           /* Clear idle counter                                 */
@@ -830,6 +1099,9 @@ void  OSStatInit (void)
     OS_ENTER_CRITICAL();
     OSIdleCtrMax = OSIdleCtr;                    /* Store maximum idle counter count in 1/10 second    */
     OSStatRdy    = OS_TRUE;
+#if OS_IDLE_JOB_EN > 0
+    OSIdleJobHold = OS_FALSE;
+#endif
     OS_EXIT_CRITICAL();
 }
 #endif
@@ -864,7 +1136,7 @@ void  OSTimeTick (void)
     OSTimeTickHook();                                      /* Call user definable hook                     */
 #endif
 #if OS_TIME_GET_SET_EN > 0
-    OS_ENTER_CRITICAL();                                   /* Update the 32-bit tick counter               */
+    OS_ENTER_CRITICAL();                                   /* Update the 64-bit tick counter               */
     OSTime++;
     OS_EXIT_CRITICAL();
 #endif
@@ -893,28 +1165,145 @@ void  OSTimeTick (void)
             return;
         }
 #endif
+#if OS_RR_EN > 0
+        OS_ENTER_CRITICAL();                               /* Time slice the running task ...              */
+        ptcb = OSTCBCur;
+        if ((OSRdyHead[ptcb->OSTCBPrio] == ptcb) &&        /* ... if other tasks are ready at its priority */
+            (ptcb->OSTCBRdyNext != ptcb)) {
+            if (--ptcb->OSTCBQuantaCtr == 0) {
+                ptcb->OSTCBQuantaCtr        = ptcb->OSTCBQuanta;
+                OSRdyHead[ptcb->OSTCBPrio] = ptcb->OSTCBRdyNext;  /* Next one runs at OSIntExit()      */
+                OSRRCtxSwCtr++;
+            }
+        }
+        OS_EXIT_CRITICAL();
+#endif
+#if OS_TICK_LIST_EN > 0
+        OS_ENTER_CRITICAL();
+        ptcb = OSTickList;                                 /* Only the head of the delta list is touched   */
+        if (ptcb != (OS_TCB *)0) {
+            ptcb->OSTCBDlyDelta--;
+            while (ptcb != (OS_TCB *)0) {
+                if (ptcb->OSTCBDlyDelta != 0) {            /* Stop at first TCB that has not expired       */
+                    break;
+                }
+                OS_TickListRemove(ptcb);                   /* Unlink and clear OSTCBDly                    */
+                OS_TimeTickExpire(ptcb);
+                OS_EXIT_CRITICAL();                        /* Give interrupts a chance between expiries    */
+                OS_ENTER_CRITICAL();
+                ptcb = OSTickList;
+            }
+        }
+        OS_EXIT_CRITICAL();
+#else
         ptcb = OSTCBList;                                  /* Point at first TCB in TCB list               */
         while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {     /* Go through all TCBs in TCB list              */
             OS_ENTER_CRITICAL();
             if (ptcb->OSTCBDly != 0) {                     /* No, Delayed or waiting for event with TO     */
                 if (--ptcb->OSTCBDly == 0) {               /* Decrement nbr of ticks to end of delay       */
-                                                           /* Check for timeout                            */
-                    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
-                        ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;          /* Yes, Clear status flag   */
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_TO;                 /* Indicate PEND timeout    */
-                    } else {
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
-                    }
-
-                    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?       */
-                        OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready          */
-                        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
-                    }
+                    OS_TimeTickExpire(ptcb);               /* Check for timeout                            */
                 }
             }
             ptcb = ptcb->OSTCBNext;                        /* Point at next TCB in TCB list                */
             OS_EXIT_CRITICAL();
         }
+#endif
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        PROCESS SEVERAL TICKS AT ONCE
+*
+* Description: This function is called by the system clock driver when the tick interrupt was held off
+*              for several ticks while the CPU was idle (see OS_TICKLESS_EN).  It has the same effect as
+*              calling OSTimeTick() 'ticks' times but only walks the tick list as far as the tasks that
+*              expire.
+*
+* Arguments  : ticks    is the number of ticks that have elapsed since the last call to OSTimeTick() or
+*                       OSTimeTickN().
+*
+* Returns    : none
+*
+* Note(s)    : 1) Tick stepping (OS_TICK_STEP_EN) is not honoured for ticks announced this way.
+*********************************************************************************************************
+*/
+
+#if OS_TICKLESS_EN > 0
+void  OSTimeTickN (INT32U ticks)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (ticks == 0) {
+        return;
+    }
+#if OS_TIME_TICK_HOOK_EN > 0
+    OSTimeTickHookN(ticks);                                /* Call user definable hook                     */
+#endif
+#if OS_TIME_GET_SET_EN > 0
+    OS_ENTER_CRITICAL();                                   /* Update the 64-bit tick counter               */
+    OSTime += ticks;
+    OS_EXIT_CRITICAL();
+#endif
+    if (OSRunning == OS_TRUE) {
+        OS_ENTER_CRITICAL();
+        ptcb = OSTickList;
+        while (ptcb != (OS_TCB *)0) {
+            if (ptcb->OSTCBDlyDelta > ticks) {             /* First TCB that outlives the elapsed ticks    */
+                ptcb->OSTCBDlyDelta -= (INT16U)ticks;
+                break;
+            }
+            ticks               -= ptcb->OSTCBDlyDelta;
+            ptcb->OSTCBDlyDelta  = 0;                      /* Successor keeps its delta on removal         */
+            OS_TickListRemove(ptcb);
+            OS_TimeTickExpire(ptcb);
+            ptcb = OSTickList;
+        }
+        OS_EXIT_CRITICAL();
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     READY A TASK WHOSE DELAY EXPIRED
+*
+* Description: This function is called by OSTimeTick() when the delay or pend timeout of a task has
+*              reached zero.  A task that was pending is marked as having timed out and, unless it is also
+*              suspended, the task is placed in the ready list.
+*
+* Arguments  : ptcb     is a pointer to the OS_TCB of the task whose delay expired.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_TimeTickExpire (OS_TCB *ptcb)
+{
+    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
+        ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;          /* Yes, Clear status flag               */
+        ptcb->OSTCBStatPend = OS_STAT_PEND_TO;                 /* Indicate PEND timeout                */
+    } else {
+        ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
+    }
+
+    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?                   */
+#if OS_RR_EN > 0
+        OS_RdyListInsert(ptcb);                                /* No,  Make ready                      */
+#else
+        OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready                      */
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
     }
 }
 
@@ -989,15 +1378,28 @@ void  OS_Dummy (void)
 INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat)
 {
     OS_TCB  *ptcb;
+#if OS_RR_EN == 0
     INT8U    y;
     INT8U    x;
+#endif
     INT8U    prio;
-#if OS_LOWEST_PRIO > 63
+#if (OS_SCHED_BITMAP_EN == 0) && (OS_LOWEST_PRIO > 63)
     INT16U  *ptbl;
 #endif
 
 
-#if OS_LOWEST_PRIO <= 63
+#if OS_RR_EN > 0
+    ptcb = OS_EventTaskFind(pevent);                    /* Find HPT waiting for message                */
+    prio = ptcb->OSTCBPrio;
+#elif OS_SCHED_BITMAP_EN > 0
+#if OS_LOWEST_PRIO <= 31
+    y    = 0;                                           /* Only one group, OSEventGrp is not scanned   */
+#else
+    y    = OS_BitScan(pevent->OSEventGrp);              /* Find HPT waiting for message                */
+#endif
+    x    = OS_BitScan(pevent->OSEventTbl[y]);
+    prio = (INT8U)((y << 5) + x);                       /* Find priority of task getting the msg       */
+#elif OS_LOWEST_PRIO <= 63
     y    = OSUnMapTbl[pevent->OSEventGrp];              /* Find HPT waiting for message                */
     x    = OSUnMapTbl[pevent->OSEventTbl[y]];
     prio = (INT8U)((y << 3) + x);                       /* Find priority of task getting the msg       */
@@ -1016,8 +1418,14 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
     prio = (INT8U)((y << 4) + x);                       /* Find priority of task getting the msg       */
 #endif
 
+#if OS_RR_EN == 0
     ptcb                  =  OSTCBPrioTbl[prio];        /* Point to this task's OS_TCB                 */
+#endif
+#if OS_TICK_LIST_EN > 0
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from readying task     */
+#else
     ptcb->OSTCBDly        =  0;                         /* Prevent OSTimeTick() from readying task     */
+#endif
 #if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0)
     ptcb->OSTCBMsg        =  pmsg;                      /* Send message directly to waiting task       */
 #else
@@ -1027,8 +1435,12 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
     ptcb->OSTCBStatPend   =  pend_stat;                 /* Set pend status of post or abort            */
                                                         /* See if task is ready (could be susp'd)      */
     if ((ptcb->OSTCBStat &   OS_STAT_SUSPEND) == OS_STAT_RDY) {
+#if OS_RR_EN > 0
+        OS_RdyListInsert(ptcb);                         /* Put task in the ready to run list           */
+#else
         OSRdyGrp         |=  ptcb->OSTCBBitY;           /* Put task in the ready to run list           */
         OSRdyTbl[y]      |=  ptcb->OSTCBBitX;
+#endif
     }
 
     OS_EventTaskRemove(ptcb, pevent);                   /* Remove this task from event   wait list     */
@@ -1060,7 +1472,9 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
 #if (OS_EVENT_EN)
 void  OS_EventTaskWait (OS_EVENT *pevent)
 {
+#if OS_RR_EN == 0
     INT8U  y;
+#endif
 
 
     OSTCBCur->OSTCBEventPtr               = pevent;                 /* Store ptr to ECB in TCB         */
@@ -1068,11 +1482,15 @@ void  OS_EventTaskWait (OS_EVENT *pevent)
     pevent->OSEventTbl[OSTCBCur->OSTCBY] |= OSTCBCur->OSTCBBitX;    /* Put task in waiting list        */
     pevent->OSEventGrp                   |= OSTCBCur->OSTCBBitY;
 
+#if OS_RR_EN > 0
+    OS_RdyListRemove(OSTCBCur);                   /* Task no longer ready                              */
+#else
     y             =  OSTCBCur->OSTCBY;            /* Task no longer ready                              */
     OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
     }
+#endif
 }
 #endif
 /*$PAGE*/
@@ -1096,7 +1514,9 @@ void  OS_EventTaskWaitMulti (OS_EVENT **pevents_wait)
 {
     OS_EVENT **pevents;
     OS_EVENT  *pevent;
+#if OS_RR_EN == 0
     INT8U      y;
+#endif
 
 
     OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;
@@ -1111,11 +1531,15 @@ void  OS_EventTaskWaitMulti (OS_EVENT **pevents_wait)
         pevent = *pevents;
     }
 
+#if OS_RR_EN > 0
+    OS_RdyListRemove(OSTCBCur);                   /* Task no longer ready                              */
+#else
     y             =  OSTCBCur->OSTCBY;            /* Task no longer ready                              */
     OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
     }
+#endif
 }
 #endif
 /*$PAGE*/
@@ -1141,6 +1565,11 @@ void  OS_EventTaskRemove (OS_TCB   *ptcb,
     INT8U  y;
 
 
+#if OS_RR_EN > 0
+    if (OS_EventTaskShared(ptcb, pevent) == OS_TRUE) {  /* Keep the bit for other tasks at this prio   */
+        return;
+    }
+#endif
     y                       =  ptcb->OSTCBY;
     pevent->OSEventTbl[y]  &= ~ptcb->OSTCBBitX;         /* Remove task from wait list                  */
     if (pevent->OSEventTbl[y] == 0) {
@@ -1171,7 +1600,10 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
     OS_EVENT **pevents;
     OS_EVENT  *pevent;
     INT8U      y;
-#if (OS_LOWEST_PRIO <= 63)
+#if OS_SCHED_BITMAP_EN > 0
+    INT8U      bity;
+    INT32U     bitx;
+#elif (OS_LOWEST_PRIO <= 63)
     INT8U      bity;
     INT8U      bitx;
 #else
@@ -1186,10 +1618,19 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
     pevents =  pevents_multi;
     pevent  = *pevents;
     while (pevent != (OS_EVENT *)0) {                   /* Remove task from all events' wait lists     */
+#if OS_RR_EN > 0
+        if (OS_EventTaskShared(ptcb, pevent) == OS_FALSE) {
+            pevent->OSEventTbl[y]  &= ~bitx;
+            if (pevent->OSEventTbl[y] == 0) {
+                pevent->OSEventGrp &= ~bity;
+            }
+        }
+#else
         pevent->OSEventTbl[y]  &= ~bitx;
         if (pevent->OSEventTbl[y] == 0) {
             pevent->OSEventGrp &= ~bity;
         }
+#endif
         pevents++;
         pevent = *pevents;
     }
@@ -1198,55 +1639,186 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                                 INITIALIZE EVENT CONTROL BLOCK'S WAIT LIST
+*                              FIND HIGHEST PRIORITY TASK WAITING FOR AN EVENT
 *
-* Description: This function is called by other uC/OS-II services to initialize the event wait list.
+* Description: This function is called by OS_EventTaskRdy() when several tasks may be created at the same
+*              priority (OS_RR_EN).  The event's wait list only tells which priority to serve, so the task
+*              is looked up among the tasks at that priority.
 *
-* Arguments  : pevent    is a pointer to the event control block allocated to the event.
+* Arguments  : pevent   is a pointer to the event control block.  At least one task must be waiting.
 *
-* Returns    : none
+* Returns    : a pointer to the OS_TCB of the task to make ready.
 *
-* Note       : This function is INTERNAL to uC/OS-II and your application should not call it.
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) When the priority is not shared, the task is the one in OSTCBPrioTbl[] as before.
 *********************************************************************************************************
 */
-#if (OS_EVENT_EN)
-void  OS_EventWaitListInit (OS_EVENT *pevent)
+#if (OS_EVENT_EN) && (OS_RR_EN > 0)
+OS_TCB  *OS_EventTaskFind (OS_EVENT *pevent)
 {
-#if OS_LOWEST_PRIO <= 63
-    INT8U  *ptbl;
-#else
-    INT16U *ptbl;
-#endif
-    INT8U   i;
-
+    OS_TCB  *ptcb;
+    OS_TCB  *psib;
+    INT8U    y;
+    INT8U    prio;
 
-    pevent->OSEventGrp = 0;                      /* No task waiting on event                           */
-    ptbl               = &pevent->OSEventTbl[0];
 
-    for (i = 0; i < OS_EVENT_TBL_SIZE; i++) {
-        *ptbl++ = 0;
+#if OS_LOWEST_PRIO <= 31
+    y    = 0;
+#else
+    y    = OS_BitScan(pevent->OSEventGrp);
+#endif
+    prio = (INT8U)((y << 5) + OS_BitScan(pevent->OSEventTbl[y]));
+    ptcb = OSTCBPrioTbl[prio];
+    if (ptcb->OSTCBSibNext == ptcb) {                   /* Only task at this priority                  */
+        return (ptcb);
     }
+    psib = ptcb;
+    do {                                                /* First task at 'prio' that waits on 'pevent' */
+        if (psib->OSTCBPrio == prio) {
+            if (OS_EventTaskWaits(psib, pevent) == OS_TRUE) {
+                return (psib);
+            }
+        }
+        psib = psib->OSTCBSibNext;
+    } while (psib != ptcb);
+    return (ptcb);
 }
 #endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                                             INITIALIZATION
-*                           INITIALIZE THE FREE LIST OF EVENT CONTROL BLOCKS
+*                           SEE IF OTHER TASKS AT THE SAME PRIORITY WAIT FOR AN EVENT
 *
-* Description: This function is called by OSInit() to initialize the free list of event control blocks.
+* Description: This function tells whether a task other than 'ptcb', at the same priority, waits for the
+*              event.  If so, the priority must stay in the event's wait list when 'ptcb' is removed.
 *
-* Arguments  : none
+* Arguments  : ptcb     is a pointer to the task being removed from the wait list.
 *
-* Returns    : none
+*              pevent   is a pointer to the event control block.
+*
+* Returns    : OS_TRUE  if another task at 'ptcb's priority waits for 'pevent'
+*              OS_FALSE otherwise
+*
+* Note       : This function is INTERNAL to uC/OS-II and your application should not call it.
 *********************************************************************************************************
 */
-
-static  void  OS_InitEventList (void)
+#if (OS_EVENT_EN) && (OS_RR_EN > 0)
+BOOLEAN  OS_EventTaskShared (OS_TCB *ptcb, OS_EVENT *pevent)
 {
-#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
-#if (OS_MAX_EVENTS > 1)
-    INT16U     i;
+    OS_TCB  *psib;
+
+
+    psib = ptcb->OSTCBSibNext;
+    while (psib != ptcb) {
+        if (psib->OSTCBPrio == ptcb->OSTCBPrio) {
+            if (OS_EventTaskWaits(psib, pevent) == OS_TRUE) {
+                return (OS_TRUE);
+            }
+        }
+        psib = psib->OSTCBSibNext;
+    }
+    return (OS_FALSE);
+}
+
+/*
+*********************************************************************************************************
+*                                    SEE IF A TASK WAITS FOR AN EVENT
+*
+* Description: This function tells whether the task is in the wait list of the event.  A task that timed
+*              out stays there until it runs again, as its bit does in the wait list.
+*
+* Arguments  : ptcb     is a pointer to the task.
+*
+*              pevent   is a pointer to the event control block.
+*
+* Returns    : OS_TRUE  if the task waits for 'pevent', alone or as one of multiple events
+*              OS_FALSE otherwise
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_EventTaskWaits (OS_TCB *ptcb, OS_EVENT *pevent)
+{
+#if (OS_EVENT_MULTI_EN > 0)
+    OS_EVENT  **pevents;
+#endif
+
+
+    if (ptcb->OSTCBEventPtr == pevent) {
+        return (OS_TRUE);
+    }
+#if (OS_EVENT_MULTI_EN > 0)
+    pevents = ptcb->OSTCBEventMultiPtr;
+    if (pevents != (OS_EVENT **)0) {
+        while (*pevents != (OS_EVENT *)0) {
+            if (*pevents == pevent) {
+                return (OS_TRUE);
+            }
+            pevents++;
+        }
+    }
+#endif
+    return (OS_FALSE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 INITIALIZE EVENT CONTROL BLOCK'S WAIT LIST
+*
+* Description: This function is called by other uC/OS-II services to initialize the event wait list.
+*
+* Arguments  : pevent    is a pointer to the event control block allocated to the event.
+*
+* Returns    : none
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) It is called for every new event, which is in no wait-set; a deleted event already left
+*                 its wait-set in OSSemDel(), OSMboxDel() or OSQDel().
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN)
+void  OS_EventWaitListInit (OS_EVENT *pevent)
+{
+#if OS_SCHED_BITMAP_EN > 0
+    INT32U *ptbl;
+#elif OS_LOWEST_PRIO <= 63
+    INT8U  *ptbl;
+#else
+    INT16U *ptbl;
+#endif
+    INT8U   i;
+
+
+    pevent->OSEventGrp = 0;                      /* No task waiting on event                           */
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+    pevent->OSEventWaitSet = (struct os_waitset *)0;  /* A new event is in no wait-set (Note 2)        */
+#endif
+    ptbl               = &pevent->OSEventTbl[0];
+
+    for (i = 0; i < OS_EVENT_TBL_SIZE; i++) {
+        *ptbl++ = 0;
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             INITIALIZATION
+*                           INITIALIZE THE FREE LIST OF EVENT CONTROL BLOCKS
+*
+* Description: This function is called by OSInit() to initialize the free list of event control blocks.
+*
+* Arguments  : none
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_InitEventList (void)
+{
+#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
+#if (OS_MAX_EVENTS > 1)
+    INT16U     i;
     OS_EVENT  *pevent1;
     OS_EVENT  *pevent2;
 
@@ -1299,7 +1871,7 @@ static  void  OS_InitEventList (void)
 static  void  OS_InitMisc (void)
 {
 #if OS_TIME_GET_SET_EN > 0
-    OSTime        = 0L;                                    /* Clear the 32-bit system clock            */
+    OSTime        = 0;                                     /* Clear the 64-bit system clock            */
 #endif
 
     OSIntNesting  = 0;                                     /* Clear the interrupt nesting counter      */
@@ -1310,6 +1882,9 @@ static  void  OS_InitMisc (void)
     OSRunning     = OS_FALSE;                              /* Indicate that multitasking not started   */
 
     OSCtxSwCtr    = 0;                                     /* Clear the context switch counter         */
+#if OS_RR_EN > 0
+    OSRRCtxSwCtr  = 0;
+#endif
     OSIdleCtr     = 0L;                                    /* Clear the 32-bit idle counter            */
 
 #if OS_TASK_STAT_EN > 0
@@ -1317,6 +1892,25 @@ static  void  OS_InitMisc (void)
     OSIdleCtrMax  = 0L;
     OSStatRdy     = OS_FALSE;                              /* Statistic task is not ready              */
 #endif
+
+#if OS_ISR_DEFER_EN > 0
+    OSDeferIn         = 0;                                 /* The deferred post ring is empty          */
+    OSDeferOut        = 0;
+    OSDeferEntries    = 0;
+    OSDeferEntriesMax = 0;
+    OSDeferOvfCtr     = 0L;
+    OSDeferWait       = OS_FALSE;
+    OSDeferTCB        = (OS_TCB *)0;
+#endif
+
+#if OS_IDLE_JOB_EN > 0
+    OS_MemClr((INT8U *)&OSIdleJobTbl[0], sizeof(OSIdleJobTbl)); /* No idle jobs                        */
+    OSIdleJobIx       = 0;
+    OSIdleJobHold     = OS_FALSE;
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+    OSIdleStkChkPrio  = OS_TASK_IDLE_PRIO + 1;             /* No stack check pass in progress          */
+#endif
+#endif
 }
 /*$PAGE*/
 /*
@@ -1335,7 +1929,9 @@ static  void  OS_InitMisc (void)
 static  void  OS_InitRdyList (void)
 {
     INT8U    i;
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    INT32U  *prdytbl;
+#elif OS_LOWEST_PRIO <= 63
     INT8U   *prdytbl;
 #else
     INT16U  *prdytbl;
@@ -1347,6 +1943,13 @@ static  void  OS_InitRdyList (void)
     for (i = 0; i < OS_RDY_TBL_SIZE; i++) {
         *prdytbl++ = 0;
     }
+#if OS_RR_EN > 0
+    OS_MemClr((INT8U *)&OSRdyHead[0], sizeof(OSRdyHead));  /* No task ready at any priority            */
+#endif
+#if OS_PREEMPT_THRESH_EN > 0
+    OSPreemptGrp  = 0;                                     /* No task preempted yet                    */
+    OS_MemClr((INT8U *)&OSPreemptTbl[0], sizeof(OSPreemptTbl));
+#endif
 
     OSPrioCur     = 0;
     OSPrioHighRdy = 0;
@@ -1491,6 +2094,73 @@ static  void  OS_InitTaskStat (void)
 /*
 *********************************************************************************************************
 *                                             INITIALIZATION
+*                                        CREATING THE DEFER TASK
+*
+* Description: This function creates the task that replays the posts queued by OSIntDefer().
+*
+* Arguments  : none
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if OS_ISR_DEFER_EN > 0
+static  void  OS_InitTaskDefer (void)
+{
+#if OS_TASK_NAME_SIZE > 8
+    INT8U  err;
+#endif
+
+
+#if OS_TASK_CREATE_EXT_EN > 0
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreateExt(OS_TaskDefer,
+                          (void *)0,                                   /* No args passed to OS_TaskDefer */
+                          &OSTaskDeferStk[OS_TASK_DEFER_STK_SIZE - 1], /* Set Top-Of-Stack               */
+                          OS_TASK_DEFER_PRIO,
+                          OS_TASK_DEFER_ID,
+                          &OSTaskDeferStk[0],                          /* Set Bottom-Of-Stack            */
+                          OS_TASK_DEFER_STK_SIZE,
+                          (void *)0,                                   /* No TCB extension               */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);  /* Enable stack checking + clear  */
+    #else
+    (void)OSTaskCreateExt(OS_TaskDefer,
+                          (void *)0,                                   /* No args passed to OS_TaskDefer */
+                          &OSTaskDeferStk[0],                          /* Set Top-Of-Stack               */
+                          OS_TASK_DEFER_PRIO,
+                          OS_TASK_DEFER_ID,
+                          &OSTaskDeferStk[OS_TASK_DEFER_STK_SIZE - 1], /* Set Bottom-Of-Stack            */
+                          OS_TASK_DEFER_STK_SIZE,
+                          (void *)0,                                   /* No TCB extension               */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);  /* Enable stack checking + clear  */
+    #endif
+#else
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreate(OS_TaskDefer,
+                       (void *)0,                                      /* No args passed to OS_TaskDefer */
+                       &OSTaskDeferStk[OS_TASK_DEFER_STK_SIZE - 1],    /* Set Top-Of-Stack               */
+                       OS_TASK_DEFER_PRIO);
+    #else
+    (void)OSTaskCreate(OS_TaskDefer,
+                       (void *)0,                                      /* No args passed to OS_TaskDefer */
+                       &OSTaskDeferStk[0],                             /* Set Top-Of-Stack               */
+                       OS_TASK_DEFER_PRIO);
+    #endif
+#endif
+
+#if OS_TASK_NAME_SIZE > 15
+    OSTaskNameSet(OS_TASK_DEFER_PRIO, (INT8U *)"uC/OS-II Defer", &err);
+#else
+#if OS_TASK_NAME_SIZE > 8
+    OSTaskNameSet(OS_TASK_DEFER_PRIO, (INT8U *)"OS-Defer", &err);
+#endif
+#endif
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             INITIALIZATION
 *                            INITIALIZE THE FREE LIST OF TASK CONTROL BLOCKS
 *
 * Description: This function is called by OSInit() to initialize the free list of OS_TCBs.
@@ -1528,6 +2198,9 @@ static  void  OS_InitTCBList (void)
 #endif
     OSTCBList               = (OS_TCB *)0;                       /* TCB lists initializations          */
     OSTCBFreeList           = &OSTCBTbl[0];
+#if OS_TICK_LIST_EN > 0
+    OSTickList              = (OS_TCB *)0;                       /* No task is delayed yet             */
+#endif
 }
 /*$PAGE*/
 /*
@@ -1577,13 +2250,28 @@ void  OS_MemClr (INT8U *pdest, INT16U size)
 *                 no provision to handle overlapping memory copy.  However, that's not a problem since this
 *                 is not a situation that will happen.
 *              2) Note that we can only copy up to 64K bytes of RAM
-*              3) The copy is done one byte at a time since this will work on any processor irrespective
-*                 of the alignment of the source and destination.
+*              3) The copy is done one word at a time when both the source and the destination are word
+*                 aligned, which is the case of the OS_TCBs and of the values of the ring channels and state
+*                 ports, else one byte at a time since this will work irrespective of the alignment.
 *********************************************************************************************************
 */
 
 void  OS_MemCopy (INT8U *pdest, INT8U *psrc, INT16U size)
 {
+    INT32U  *pd;
+    INT32U  *ps;
+
+
+    if ((((INT32U)pdest | (INT32U)psrc) & (sizeof(INT32U) - 1)) == 0) {
+        pd = (INT32U *)pdest;
+        ps = (INT32U *)psrc;
+        while (size >= sizeof(INT32U)) {
+            *pd++  = *ps++;
+            size  -= sizeof(INT32U);
+        }
+        pdest = (INT8U *)pd;
+        psrc  = (INT8U *)ps;
+    }
     while (size > 0) {
         *pdest++ = *psrc++;
         size--;
@@ -1619,8 +2307,16 @@ void  OS_Sched (void)
     if (OSIntNesting == 0) {                           /* Schedule only if all ISRs done and ...       */
         if (OSLockNesting == 0) {                      /* ... scheduler is not locked                  */
             OS_SchedNew();
+#if OS_PREEMPT_THRESH_EN > 0
+            OS_SchedThresh();                          /* Running task may be above the new one        */
+#endif
+#if OS_RR_EN > 0
+            OSTCBHighRdy = OSRdyHead[OSPrioHighRdy];   /* Several tasks may share that priority        */
+            if (OSTCBHighRdy != OSTCBCur) {            /* No Ctx Sw if current task is highest rdy     */
+#else
             if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy     */
                 OSTCBHighRdy = OSTCBPrioTbl[OSPrioHighRdy];
+#endif
 #if OS_TASK_PROFILE_EN > 0
                 OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task      */
 #endif
@@ -1633,6 +2329,42 @@ void  OS_Sched (void)
 }
 
 
+/*
+*********************************************************************************************************
+*                                  FIND LOWEST BIT SET IN A 32-BIT WORD
+*
+* Description: This function returns the position of the lowest bit set in 'bits', i.e. the highest
+*              priority found in a word of the ready list or of an event wait list when
+*              OS_SCHED_BITMAP_EN is enabled.  It replaces the OSUnMapTbl[] lookups.
+*
+* Arguments  : bits     is the word to scan.  It must not be 0.
+*
+* Returns    : the position of the lowest bit set (0..31).
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) The search is a branch-free binary search on the isolated bit.  It reads no table from
+*                 memory and needs no multiplier (unlike a De Bruijn sequence), which suits a core without
+*                 data cache or hardware multiply.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_BITMAP_EN > 0
+INT8U  OS_BitScan (INT32U bits)
+{
+    INT32U  pos;
+
+
+    bits &= (INT32U)0 - bits;                           /* Isolate the lowest bit set                  */
+    pos   = ((INT32U)0 - (INT32U)((bits & 0xFFFF0000uL) != 0)) & 16;
+    pos  |= ((INT32U)0 - (INT32U)((bits & 0xFF00FF00uL) != 0)) &  8;
+    pos  |= ((INT32U)0 - (INT32U)((bits & 0xF0F0F0F0uL) != 0)) &  4;
+    pos  |= ((INT32U)0 - (INT32U)((bits & 0xCCCCCCCCuL) != 0)) &  2;
+    pos  |=              (INT32U)((bits & 0xAAAAAAAAuL) != 0);
+    return ((INT8U)pos);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                              FIND HIGHEST PRIORITY TASK READY TO RUN
@@ -1651,7 +2383,17 @@ void  OS_Sched (void)
 
 static  void  OS_SchedNew (void)
 {
-#if OS_LOWEST_PRIO <= 63                         /* See if we support up to 64 tasks                   */
+#if OS_SCHED_BITMAP_EN > 0                       /* Ready list made of 32-bit words                    */
+#if OS_LOWEST_PRIO <= 31
+    OSPrioHighRdy = OS_BitScan(OSRdyTbl[0]);
+#else
+    INT8U   y;
+
+
+    y             = OS_BitScan(OSRdyGrp);
+    OSPrioHighRdy = (INT8U)((y << 5) + OS_BitScan(OSRdyTbl[y]));
+#endif
+#elif OS_LOWEST_PRIO <= 63                       /* See if we support up to 64 tasks                   */
     INT8U   y;
 
 
@@ -1674,7 +2416,178 @@ static  void  OS_SchedNew (void)
         OSPrioHighRdy = (INT8U)((y << 4) + OSUnMapTbl[(*ptbl >> 8) & 0xFF] + 8);
     }
 #endif
+#if OS_EDF_EN > 0
+    if ((OSPrioHighRdy >= OS_EDF_PRIO_HI) && (OSPrioHighRdy <= OS_EDF_PRIO_LO)) {
+        OSPrioHighRdy = OS_EDF_SchedNew(OSPrioHighRdy);  /* Earliest deadline among the EDF band        */
+    }
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              FIND EARLIEST DEADLINE TASK READY TO RUN
+*
+* Description: This function is called by OS_SchedNew() when the highest priority ready task is in the
+*              EDF band (OS_EDF_PRIO_HI to OS_EDF_PRIO_LO).  Among the ready tasks of the band, the one
+*              whose current job has the earliest absolute deadline is picked.  Equal deadlines go to the
+*              higher priority.  Tasks of the band that were not created by OSTaskCreateEDF() have no
+*              deadline: they run, by priority, when no EDF job is ready.
+*
+* Arguments  : prio     is the highest priority ready task, within the band.
+*
+* Returns    : the priority of the task to run.
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) Deadlines are compared as differences so that they stay in order when OSTime wraps.
+*********************************************************************************************************
+*/
+
+#if OS_EDF_EN > 0
+static  INT8U  OS_EDF_SchedNew (INT8U prio)
+{
+    OS_TCB  *ptcb;
+    OS_TCB  *pbest;
+    INT32U   bits;
+    INT8U    best;
+    INT8U    y;
+    INT8U    p;
+
+
+#if OS_RR_EN > 0
+    pbest = OSRdyHead[prio];                             /* Next task to run at each priority          */
+#else
+    pbest = OSTCBPrioTbl[prio];
+#endif
+    best  = prio;
+    y     = (INT8U)(prio >> 5);
+    bits  = OSRdyTbl[y] & ~(((INT32U)2 << (prio & 0x1F)) - 1);  /* Ready tasks below 'prio'           */
+    for (;;) {
+        while (bits != 0) {
+            p = (INT8U)((y << 5) + OS_BitScan(bits));
+            if (p > OS_EDF_PRIO_LO) {                    /* Past the end of the band                   */
+                return (best);
+            }
+            bits &= bits - 1;                            /* Clear the lowest bit                       */
+#if OS_RR_EN > 0
+            ptcb  = OSRdyHead[p];
+#else
+            ptcb  = OSTCBPrioTbl[p];
+#endif
+            if (ptcb->OSTCBEDFPeriod != 0) {             /* Only an EDF job may go ahead               */
+                if ((pbest->OSTCBEDFPeriod == 0) ||
+                    ((INT32S)(ptcb->OSTCBEDFDeadlineAbs - pbest->OSTCBEDFDeadlineAbs) < 0)) {
+                    pbest = ptcb;
+                    best  = p;
+                }
+            }
+        }
+        y++;
+        if (y > (OS_EDF_PRIO_LO >> 5)) {
+            return (best);
+        }
+        bits = OSRdyTbl[y];
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    APPLY THE PREEMPTION THRESHOLDS
+*
+* Description: This function is called after OS_SchedNew() by OS_Sched() and OSIntExit().  It may keep
+*              the CPU with another task than 'OSPrioHighRdy':
+*
+*              a) If the running task is still ready, it is only preempted by a task of a higher priority
+*                 than its threshold (see OSTaskThreshSet()).  When it is, it is recorded in
+*                 OSPreemptTbl[].
+*
+*              b) If the running task gives up the CPU, the highest priority task recorded in
+*                 OSPreemptTbl[] that is ready resumes, unless the new task is above its threshold.
+*                 Tasks between its priority and its threshold thus never run ahead of it.
+*
+*              The task picked leaves OSPreemptTbl[].
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) A task raised to a mutex PIP uses the higher of its priority and its threshold.
+*********************************************************************************************************
+*/
+
+#if OS_PREEMPT_THRESH_EN > 0
+static  void  OS_SchedThresh (void)
+{
+    OS_TCB  *ptcb;
+    INT32U   bits;
+    INT8U    grp;
+    INT8U    thresh;
+    INT8U    y;
+    INT8U    p;
+
+
+    if (OSPrioHighRdy == OSPrioCur) {
+        return;
+    }
+    ptcb = OSTCBCur;
+    if ((OSRdyTbl[ptcb->OSTCBY] & ptcb->OSTCBBitX) != 0) {  /* a) Running task would be preempted      */
+        thresh = ptcb->OSTCBThresh;
+        if (thresh > ptcb->OSTCBPrio) {
+            thresh = ptcb->OSTCBPrio;
+        }
+        if (OSPrioHighRdy >= thresh) {                      /*    Not above its threshold, keep it     */
+            OSPrioHighRdy = OSPrioCur;
+            return;
+        }
+        if (thresh < ptcb->OSTCBPrio) {                     /*    Resume it before tasks under thresh  */
+            OSPreemptGrp               |= ptcb->OSTCBBitY;
+            OSPreemptTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+        }
+    } else {                                                /* b) Return to a preempted task?          */
+        grp = OSPreemptGrp;
+        while (grp != 0) {
+            y     = OS_BitScan(grp);
+            grp  &= grp - 1;
+            bits  = OSPreemptTbl[y];
+            while (bits != 0) {
+                p     = (INT8U)((y << 5) + OS_BitScan(bits));
+                bits &= bits - 1;
+                ptcb  = OSTCBPrioTbl[p];
+                if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+                    OSPreemptTbl[y] &= ~((INT32U)1 << (p & 0x1F));  /* Stale entry                 */
+                    if (OSPreemptTbl[y] == 0) {
+                        OSPreemptGrp &= ~(INT8U)(1 << y);
+                    }
+                } else if ((OSRdyTbl[ptcb->OSTCBY] & ptcb->OSTCBBitX) != 0) {
+                    thresh = ptcb->OSTCBThresh;             /*    Highest one still ready decides      */
+                    if (thresh > ptcb->OSTCBPrio) {
+                        thresh = ptcb->OSTCBPrio;
+                    }
+                    if (OSPrioHighRdy >= thresh) {
+                        OSPreemptTbl[y] &= ~((INT32U)1 << (p & 0x1F));
+                        if (OSPreemptTbl[y] == 0) {
+                            OSPreemptGrp &= ~(INT8U)(1 << y);
+                        }
+                        OSPrioHighRdy = ptcb->OSTCBPrio;    /*    May run at a mutex PIP meanwhile     */
+                    }
+                    grp = 0;
+                    break;
+                }
+            }
+        }
+    }
+    y                = (INT8U)(OSPrioHighRdy >> 5);         /* Task picked is not preempted any more   */
+    OSPreemptTbl[y] &= ~((INT32U)1 << (OSPrioHighRdy & 0x1F));
+    if (OSPreemptTbl[y] == 0) {
+        OSPreemptGrp &= ~(INT8U)(1 << y);
+    }
 }
+#endif
 
 /*$PAGE*/
 /*
@@ -1745,27 +2658,31 @@ INT8U  OS_StrLen (INT8U *psrc)
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                                              IDLE TASK
+*                                              DEFER TASK
 *
-* Description: This task is internal to uC/OS-II and executes whenever no other higher priority tasks
-*              executes because they are ALL waiting for event(s) to occur.
+* Description: This task is internal to uC/OS-II and makes the posts queued by OSIntDefer(), oldest first.
+*              When the ring is empty, it takes itself out of the ready list and OSIntDefer() puts it back.
 *
-* Arguments  : none
+* Arguments  : parg     this pointer is not used at this time.
 *
 * Returns    : none
 *
-* Note(s)    : 1) OSTaskIdleHook() is called after the critical section to ensure that interrupts will be
-*                 enabled for at least a few instructions.  On some processors (ex. Philips XA), enabling
-*                 and then disabling interrupts didn't allow the processor enough time to have interrupts
-*                 enabled before they were disabled again.  uC/OS-II would thus never recognize
-*                 interrupts.
-*              2) This hook has been added to allow you to do such things as STOP the CPU to conserve
-*                 power.
+* Notes      : 1) This task runs at OS_TASK_DEFER_PRIO, which should be above every task that ISRs post
+*                 to so that a deferred post is made before they could have run.
+*              2) Interrupts are only disabled to take a record out of the ring.
 *********************************************************************************************************
 */
 
-void  OS_TaskIdle (void *p_arg)
+#if OS_ISR_DEFER_EN > 0
+void  OS_TaskDefer (void *p_arg)
 {
+    OS_DEFER   defer;
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    INT8U      err;
+#endif
+#if OS_RR_EN == 0
+    INT8U      y;
+#endif
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -1773,13 +2690,206 @@ void  OS_TaskIdle (void *p_arg)
 
 
     (void)p_arg;                                 /* Prevent compiler warning for not using 'p_arg'     */
+    OSDeferTCB = OSTCBCur;
     for (;;) {
         OS_ENTER_CRITICAL();
-        OSIdleCtr++;
+        if (OSDeferEntries == 0) {               /* Nothing to post, wait for OSIntDefer()             */
+            OSDeferWait = OS_TRUE;
+#if OS_RR_EN > 0
+            OS_RdyListRemove(OSTCBCur);
+#else
+            y            =  OSTCBCur->OSTCBY;
+            OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
+            if (OSRdyTbl[y] == 0) {
+                OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
+            }
+#endif
+            OS_EXIT_CRITICAL();
+            OS_Sched();
+            continue;
+        }
+        defer = OSDeferTbl[OSDeferOut];          /* Take the oldest record out of the ring             */
+        OSDeferOut++;
+        if (OSDeferOut == OS_ISR_DEFER_SIZE) {
+            OSDeferOut = 0;
+        }
+        OSDeferEntries--;
         OS_EXIT_CRITICAL();
-        OSTaskIdleHook();                        /* Call user definable HOOK                           */
-    }
-}
+        switch (defer.OSDeferOp) {
+#if OS_SEM_EN > 0
+            case OS_DEFER_SEM_POST:
+                 (void)OSSemPost((OS_EVENT *)defer.OSDeferObj);
+                 break;
+#endif
+
+#if (OS_MBOX_EN > 0) && (OS_MBOX_POST_EN > 0)
+            case OS_DEFER_MBOX_POST:
+                 (void)OSMboxPost((OS_EVENT *)defer.OSDeferObj, (void *)defer.OSDeferArg);
+                 break;
+#endif
+
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0) && (OS_Q_POST_EN > 0)
+            case OS_DEFER_Q_POST:
+                 (void)OSQPost((OS_EVENT *)defer.OSDeferObj, (void *)defer.OSDeferArg);
+                 break;
+#endif
+
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+            case OS_DEFER_FLAG_SET:
+                 (void)OSFlagPost((OS_FLAG_GRP *)defer.OSDeferObj, (OS_FLAGS)defer.OSDeferArg, OS_FLAG_SET, &err);
+                 break;
+
+            case OS_DEFER_FLAG_CLR:
+                 (void)OSFlagPost((OS_FLAG_GRP *)defer.OSDeferObj, (OS_FLAGS)defer.OSDeferArg, OS_FLAG_CLR, &err);
+                 break;
+#endif
+
+#if OS_TASK_NOTIFY_EN > 0
+            case OS_DEFER_NOTIFY_SET_BITS:
+            case OS_DEFER_NOTIFY_INC:
+            case OS_DEFER_NOTIFY_OVERWRITE:
+                 (void)OSTaskNotify((INT8U)(INT32U)defer.OSDeferObj,
+                                    defer.OSDeferArg,
+                                    (INT8U)(defer.OSDeferOp - OS_DEFER_NOTIFY_SET_BITS));
+                 break;
+#endif
+
+#if OS_TMR_EN > 0
+            case OS_DEFER_TMR_SIGNAL:
+                 while (defer.OSDeferArg > 0) {  /* One record for all the ticks of a tickless wake-up */
+                     defer.OSDeferArg--;
+                     (void)OSTmrSignal();
+                 }
+                 break;
+#endif
+
+            case OS_DEFER_CALL:
+                 (*(void (*)(void *))defer.OSDeferObj)((void *)defer.OSDeferArg);
+                 break;
+
+            default:                             /* Service not included in the build                  */
+                 break;
+        }
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                              IDLE TASK
+*
+* Description: This task is internal to uC/OS-II and executes whenever no other higher priority tasks
+*              executes because they are ALL waiting for event(s) to occur.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) OSTaskIdleHook() is called after the critical section to ensure that interrupts will be
+*                 enabled for at least a few instructions.  On some processors (ex. Philips XA), enabling
+*                 and then disabling interrupts didn't allow the processor enough time to have interrupts
+*                 enabled before they were disabled again.  uC/OS-II would thus never recognize
+*                 interrupts.
+*              2) This hook has been added to allow you to do such things as STOP the CPU to conserve
+*                 power.
+*********************************************************************************************************
+*/
+
+void  OS_TaskIdle (void *p_arg)
+{
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    (void)p_arg;                                 /* Prevent compiler warning for not using 'p_arg'     */
+    for (;;) {
+        OS_ENTER_CRITICAL();
+        OSIdleCtr++;
+        OS_EXIT_CRITICAL();
+#if OS_IDLE_JOB_EN > 0
+        OS_IdleJobRun();                         /* Run one step of the next idle job                  */
+#endif
+        OSTaskIdleHook();                        /* Call user definable HOOK                           */
+    }
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           RUN AN IDLE JOB
+*
+* Description: This function is called by OS_TaskIdle() on every pass of its loop and calls the next
+*              registered idle job, in round robin order.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) The job is looked up even while OSIdleJobHold is set, so that OSStatInit() measures an
+*                 idle loop that costs the same as one with idle jobs that have nothing to do.
+*********************************************************************************************************
+*/
+
+#if OS_IDLE_JOB_EN > 0
+static  void  OS_IdleJobRun (void)
+{
+    OS_IDLE_JOB_FNCT  fnct;
+    void             *p_arg;
+    INT8U             i;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR         cpu_sr = 0;
+#endif
+
+
+
+    fnct  = (OS_IDLE_JOB_FNCT)0;
+    p_arg = (void *)0;
+    OS_ENTER_CRITICAL();
+    for (i = 0; i < OS_MAX_IDLE_JOBS; i++) {     /* Find the next registered job                       */
+        fnct  = OSIdleJobTbl[OSIdleJobIx].OSIdleJobFnct;
+        p_arg = OSIdleJobTbl[OSIdleJobIx].OSIdleJobArg;
+        OSIdleJobIx++;
+        if (OSIdleJobIx >= OS_MAX_IDLE_JOBS) {
+            OSIdleJobIx = 0;
+        }
+        if (fnct != (OS_IDLE_JOB_FNCT)0) {
+            break;
+        }
+    }
+    if (OSIdleJobHold == OS_TRUE) {              /* OSStatInit() is calibrating the idle loop          */
+        fnct = (OS_IDLE_JOB_FNCT)0;
+    }
+    OS_EXIT_CRITICAL();
+    if (fnct != (OS_IDLE_JOB_FNCT)0) {
+        (*fnct)(p_arg);
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        STACK CHECKING IDLE JOB
+*
+* Description: This idle job does the work of OS_TaskStatStkChk() one task per call.  OS_TaskStat() starts
+*              a pass by setting OSIdleStkChkPrio to 0.
+*
+* Arguments  : p_arg    is not used.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if (OS_IDLE_JOB_EN > 0) && (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+static  void  OS_IdleJobStkChk (void *p_arg)
+{
+    (void)p_arg;                                 /* Prevent compiler warning for not using 'p_arg'     */
+    if (OSIdleStkChkPrio <= OS_TASK_IDLE_PRIO) { /* Is a pass in progress?                             */
+        OS_TaskStkChkPrio(OSIdleStkChkPrio);
+        OSIdleStkChkPrio++;
+    }
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1831,7 +2941,13 @@ void  OS_TaskStat (void *p_arg)
         OSCPUUsage   = (INT8U)(100L - OSIdleCtrRun / OSIdleCtrMax);
         OSTaskStatHook();                        /* Invoke user definable hook                         */
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+#if OS_IDLE_JOB_EN > 0
+        if (OSIdleStkChkPrio > OS_TASK_IDLE_PRIO) {
+            OSIdleStkChkPrio = 0;                /* Have the idle task check the stacks                */
+        }
+#else
         OS_TaskStatStkChk();                     /* Check the stacks for each task                     */
+#endif
 #endif
         OSTimeDly(OS_TICKS_PER_SEC / 10);        /* Accumulate OSIdleCtr for the next 1/10 second      */
     }
@@ -1852,33 +2968,392 @@ void  OS_TaskStat (void *p_arg)
 
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
 void  OS_TaskStatStkChk (void)
+{
+    INT8U  prio;
+
+
+    for (prio = 0; prio <= OS_TASK_IDLE_PRIO; prio++) {
+        OS_TaskStkChkPrio(prio);
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    CHECK THE STACK OF ONE TASK
+*
+* Description: This function checks the stack of the task at priority 'prio', if there is one, and records
+*              its usage in the task's OS_TCB.
+*
+* Arguments  : prio     is the priority of the task.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+static  void  OS_TaskStkChkPrio (INT8U prio)
 {
     OS_TCB      *ptcb;
     OS_STK_DATA  stk_data;
     INT8U        err;
-    INT8U        prio;
 
 
-    for (prio = 0; prio <= OS_TASK_IDLE_PRIO; prio++) {
-        err = OSTaskStkChk(prio, &stk_data);
-        if (err == OS_ERR_NONE) {
-            ptcb = OSTCBPrioTbl[prio];
-            if (ptcb != (OS_TCB *)0) {                               /* Make sure task 'ptcb' is ...   */
-                if (ptcb != OS_TCB_RESERVED) {                       /* ... still valid.               */
+    err = OSTaskStkChk(prio, &stk_data);
+    if (err == OS_ERR_NONE) {
+        ptcb = OSTCBPrioTbl[prio];
+        if (ptcb != (OS_TCB *)0) {                                   /* Make sure task 'ptcb' is ...   */
+            if (ptcb != OS_TCB_RESERVED) {                           /* ... still valid.               */
 #if OS_TASK_PROFILE_EN > 0
-                    #if OS_STK_GROWTH == 1
-                    ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom + ptcb->OSTCBStkSize;
-                    #else
-                    ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom - ptcb->OSTCBStkSize;
-                    #endif
-                    ptcb->OSTCBStkUsed = stk_data.OSUsed;            /* Store the number of bytes used */
+                #if OS_STK_GROWTH == 1
+                ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom + ptcb->OSTCBStkSize;
+                #else
+                ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom - ptcb->OSTCBStkSize;
+                #endif
+                ptcb->OSTCBStkUsed = stk_data.OSUsed;                /* Store the number of bytes used */
 #endif
-                }
             }
         }
     }
 }
 #endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  INSERT A TASK IN THE TICK (DELTA) LIST
+*
+* Description: This function is called to link a delayed or pending task into the list of tasks that
+*              OSTimeTick() must count down.  The list is kept sorted by expiry and each entry only holds
+*              the number of ticks it expires after its predecessor (OSTCBDlyDelta).  A tick therefore
+*              only decrements the head of the list, whatever the number of tasks.
+*
+* Arguments  : ptcb     is a pointer to the task's OS_TCB.  'ptcb->OSTCBDly' must already contain the
+*                       number of ticks to wait.  Nothing is done if it is 0 (i.e. wait forever).
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) Tasks expiring on the same tick are kept in FIFO order.
+*********************************************************************************************************
+*/
+
+#if OS_TICK_LIST_EN > 0
+void  OS_TickListInsert (OS_TCB *ptcb)
+{
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+    INT16U   dly;
+
+
+    dly = ptcb->OSTCBDly;
+    if (dly == 0) {                                        /* Wait forever, no need to be in the list  */
+        return;
+    }
+    pprev = (OS_TCB *)0;
+    pnext = OSTickList;
+    while (pnext != (OS_TCB *)0) {                         /* Find insertion point                     */
+        if (pnext->OSTCBDlyDelta > dly) {
+            break;
+        }
+        dly   -= pnext->OSTCBDlyDelta;
+        pprev  = pnext;
+        pnext  = pnext->OSTCBDlyNext;
+    }
+    ptcb->OSTCBDlyDelta = dly;
+    ptcb->OSTCBDlyPrev  = pprev;
+    ptcb->OSTCBDlyNext  = pnext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBDlyDelta -= dly;                       /* Successor now expires relative to us     */
+        pnext->OSTCBDlyPrev   = ptcb;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBDlyNext   = ptcb;
+    } else {
+        OSTickList            = ptcb;                      /* New head of the list                     */
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    TICKS UNTIL THE NEXT TASK EXPIRES
+*
+* Description: This function returns the number of ticks before the first task in the tick list times
+*              out.  It is used to decide how long the tick can be stopped while the CPU is idle.
+*
+* Arguments  : none
+*
+* Returns    : the number of ticks until the next delay or pend timeout expires, or 0 if no task is
+*              waiting with a timeout.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) The idle task calls this function with interrupts enabled and discards the result if a
+*                 tick or a context switch occurred meanwhile (see OSTaskIdleHook()).
+*********************************************************************************************************
+*/
+
+#if OS_TICK_LIST_EN > 0
+INT16U  OS_TickListNext (void)
+{
+    if (OSTickList == (OS_TCB *)0) {
+        return (0);
+    }
+    return (OSTickList->OSTCBDlyDelta);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  TICKS LEFT BEFORE A TASK EXPIRES
+*
+* Description: This function returns the number of ticks before the delay or pend timeout of a task
+*              expires.  In the tick list, OSTCBDly keeps the delay the task started with; the ticks left
+*              are the sum of the deltas from the head of the list up to the task.
+*
+* Arguments  : ptcb     is a pointer to the task's OS_TCB.
+*
+* Returns    : the number of ticks left, or 0 if the task is not in the tick list.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The cost grows with the number of tasks expiring before this one; it is meant for
+*                 OSTaskQuery(), not for a time-critical path.
+*********************************************************************************************************
+*/
+
+#if OS_TICK_LIST_EN > 0
+INT16U  OS_TickListLeft (OS_TCB *ptcb)
+{
+    INT16U  left;
+
+
+    if (ptcb->OSTCBDly == 0) {                             /* Task is not in the list                  */
+        return (0);
+    }
+    left = 0;
+    while (ptcb != (OS_TCB *)0) {                          /* Walk back to the head of the list        */
+        left += ptcb->OSTCBDlyDelta;
+        ptcb  = ptcb->OSTCBDlyPrev;
+    }
+    return (left);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 REMOVE A TASK FROM THE TICK (DELTA) LIST
+*
+* Description: This function is called to unlink a task from the tick list when its delay expires, when
+*              the event it waits for is signaled, or when the task is resumed or deleted.  The ticks the
+*              task had left are handed over to its successor so that the successor's expiry is unchanged.
+*
+* Arguments  : ptcb     is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) 'ptcb->OSTCBDly' is cleared; it is safe to call this function for a task that is not
+*                 in the list.
+*********************************************************************************************************
+*/
+
+#if OS_TICK_LIST_EN > 0
+void  OS_TickListRemove (OS_TCB *ptcb)
+{
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+
+
+    if (ptcb->OSTCBDly == 0) {                             /* Task is not in the list                  */
+        return;
+    }
+    pprev = ptcb->OSTCBDlyPrev;
+    pnext = ptcb->OSTCBDlyNext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBDlyDelta += ptcb->OSTCBDlyDelta;
+        pnext->OSTCBDlyPrev   = pprev;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBDlyNext   = pnext;
+    } else {
+        OSTickList            = pnext;
+    }
+    ptcb->OSTCBDly      = 0;
+    ptcb->OSTCBDlyDelta = 0;
+    ptcb->OSTCBDlyNext  = (OS_TCB *)0;
+    ptcb->OSTCBDlyPrev  = (OS_TCB *)0;
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   ADD A TASK TO THE TASKS AT ITS PRIORITY
+*
+* Description: This function is called when a task is created or moved to a new priority.  The first task
+*              at a priority owns the OSTCBPrioTbl[] entry, so that services taking a priority as argument
+*              address it; the others are linked after it in creation order.
+*
+* Arguments  : ptcb     is a pointer to the task's OS_TCB.  'ptcb->OSTCBPrio' must be set.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+#if OS_RR_EN > 0
+void  OS_PrioJoin (OS_TCB *ptcb)
+{
+    OS_TCB  *powner;
+
+
+    powner = OSTCBPrioTbl[ptcb->OSTCBPrio];
+    if ((powner == (OS_TCB *)0) || (powner == OS_TCB_RESERVED)) {
+        ptcb->OSTCBSibNext             = ptcb;     /* First task at this priority                      */
+        ptcb->OSTCBSibPrev             = ptcb;
+        OSTCBPrioTbl[ptcb->OSTCBPrio]  = ptcb;
+    } else {
+        ptcb->OSTCBSibNext             = powner;   /* Link at the end, just before the owner           */
+        ptcb->OSTCBSibPrev             = powner->OSTCBSibPrev;
+        powner->OSTCBSibPrev->OSTCBSibNext = ptcb;
+        powner->OSTCBSibPrev           = ptcb;
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 REMOVE A TASK FROM THE TASKS AT ITS PRIORITY
+*
+* Description: This function is called when a task is deleted or moved to another priority.  If the task
+*              owned the OSTCBPrioTbl[] entry, the next task at that priority takes it over; the entry is
+*              cleared with the last task.
+*
+* Arguments  : ptcb     is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_PrioLeave (OS_TCB *ptcb)
+{
+    INT8U  prio;
+
+
+    prio = ptcb->OSTCBPrio;
+    if (ptcb->OSTCBSibNext == ptcb) {                       /* Last task at this priority              */
+        if (OSTCBPrioTbl[prio] == ptcb) {
+            OSTCBPrioTbl[prio] = (OS_TCB *)0;
+        }
+    } else {
+        ptcb->OSTCBSibPrev->OSTCBSibNext = ptcb->OSTCBSibNext;
+        ptcb->OSTCBSibNext->OSTCBSibPrev = ptcb->OSTCBSibPrev;
+        if (OSTCBPrioTbl[prio] == ptcb) {                   /* Hand the entry over to the next task    */
+            OSTCBPrioTbl[prio] = ptcb->OSTCBSibNext;
+        }
+    }
+    ptcb->OSTCBSibNext = ptcb;
+    ptcb->OSTCBSibPrev = ptcb;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      MAKE A TASK READY TO RUN
+*
+* Description: This function puts a task at the end of the ready list of its priority.  A task alone at
+*              its priority only sets its bit in the ready table, as without OS_RR_EN.
+*
+* Arguments  : ptcb     is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) Nothing is done if the task is already ready.
+*              4) The task starts with a full time slice.
+*********************************************************************************************************
+*/
+
+void  OS_RdyListInsert (OS_TCB *ptcb)
+{
+    OS_TCB  *phead;
+
+
+    if (ptcb->OSTCBRdyNext != (OS_TCB *)0) {                /* Already ready                           */
+        return;
+    }
+    ptcb->OSTCBQuantaCtr = ptcb->OSTCBQuanta;
+    phead                = OSRdyHead[ptcb->OSTCBPrio];
+    if (phead == (OS_TCB *)0) {                             /* Only ready task at this priority        */
+        ptcb->OSTCBRdyNext          = ptcb;
+        ptcb->OSTCBRdyPrev          = ptcb;
+        OSRdyHead[ptcb->OSTCBPrio]  = ptcb;
+        OSRdyGrp                   |= ptcb->OSTCBBitY;
+        OSRdyTbl[ptcb->OSTCBY]     |= ptcb->OSTCBBitX;
+    } else {                                                /* Others ready, run after them (FIFO)     */
+        ptcb->OSTCBRdyNext                 = phead;
+        ptcb->OSTCBRdyPrev                 = phead->OSTCBRdyPrev;
+        phead->OSTCBRdyPrev->OSTCBRdyNext  = ptcb;
+        phead->OSTCBRdyPrev                = ptcb;
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     REMOVE A TASK FROM THE READY LIST
+*
+* Description: This function takes a task out of the ready list of its priority.  The priority's bit in
+*              the ready table is cleared with its last ready task.
+*
+* Arguments  : ptcb     is a pointer to the task's OS_TCB.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) Nothing is done if the task is not ready.
+*********************************************************************************************************
+*/
+
+void  OS_RdyListRemove (OS_TCB *ptcb)
+{
+    INT8U  prio;
+
+
+    if (ptcb->OSTCBRdyNext == (OS_TCB *)0) {                /* Not ready                               */
+        return;
+    }
+    prio = ptcb->OSTCBPrio;
+    if (ptcb->OSTCBRdyNext == ptcb) {                       /* Last ready task at this priority        */
+        OSRdyHead[prio]         = (OS_TCB *)0;
+        OSRdyTbl[ptcb->OSTCBY] &= ~ptcb->OSTCBBitX;
+        if (OSRdyTbl[ptcb->OSTCBY] == 0) {
+            OSRdyGrp &= ~ptcb->OSTCBBitY;
+        }
+    } else {
+        ptcb->OSTCBRdyPrev->OSTCBRdyNext = ptcb->OSTCBRdyNext;
+        ptcb->OSTCBRdyNext->OSTCBRdyPrev = ptcb->OSTCBRdyPrev;
+        if (OSRdyHead[prio] == ptcb) {                      /* Next task at this priority runs first   */
+            OSRdyHead[prio] = ptcb->OSTCBRdyNext;
+        }
+    }
+    ptcb->OSTCBRdyNext = (OS_TCB *)0;
+    ptcb->OSTCBRdyPrev = (OS_TCB *)0;
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1939,9 +3414,17 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         OS_EXIT_CRITICAL();
         ptcb->OSTCBStkPtr        = ptos;                   /* Load Stack pointer in TCB                */
         ptcb->OSTCBPrio          = prio;                   /* Load task priority into TCB              */
+#if OS_PREEMPT_THRESH_EN > 0
+        ptcb->OSTCBThresh        = prio;                   /* No threshold (see OSTaskThreshSet())     */
+#endif
         ptcb->OSTCBStat          = OS_STAT_RDY;            /* Task is ready to run                     */
         ptcb->OSTCBStatPend      = OS_STAT_PEND_OK;        /* Clear pend status                        */
         ptcb->OSTCBDly           = 0;                      /* Task is not delayed                      */
+#if OS_TICK_LIST_EN > 0
+        ptcb->OSTCBDlyDelta      = 0;
+        ptcb->OSTCBDlyNext       = (OS_TCB *)0;            /* Task is not in the tick list             */
+        ptcb->OSTCBDlyPrev       = (OS_TCB *)0;
+#endif
 
 #if OS_TASK_CREATE_EXT_EN > 0
         ptcb->OSTCBExtPtr        = pext;                   /* Store pointer to TCB extension           */
@@ -1961,7 +3444,33 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBDelReq        = OS_ERR_NONE;
 #endif
 
-#if OS_LOWEST_PRIO <= 63
+#if OS_RR_EN > 0
+        ptcb->OSTCBRdyNext       = (OS_TCB *)0;            /* Not in the ready list yet                */
+        ptcb->OSTCBRdyPrev       = (OS_TCB *)0;
+        ptcb->OSTCBQuanta        = OS_RR_QUANTA;           /* Default time slice                       */
+        ptcb->OSTCBQuantaCtr     = OS_RR_QUANTA;
+#endif
+
+#if OS_EDF_EN > 0
+        ptcb->OSTCBEDFPeriod     = 0;                      /* Not an EDF task (see OSTaskCreateEDF())  */
+        ptcb->OSTCBEDFDeadline   = 0;
+        ptcb->OSTCBEDFRelease    = 0L;
+        ptcb->OSTCBEDFDeadlineAbs = 0L;
+        ptcb->OSTCBEDFMissCtr    = 0L;
+#endif
+
+#if OS_TASK_PERIODIC_EN > 0
+        ptcb->OSTCBPeriod        = 0;                      /* Not periodic (see OSTaskCreatePeriodic()) */
+        ptcb->OSTCBRelease       = 0L;
+        ptcb->OSTCBOverrunCtr    = 0L;
+#endif
+
+#if OS_SCHED_BITMAP_EN > 0
+        ptcb->OSTCBY             = (INT8U)(prio >> 5);          /* Pre-compute X, Y, BitX and BitY     */
+        ptcb->OSTCBX             = (INT8U)(prio & 0x1F);
+        ptcb->OSTCBBitY          = (INT8U)(1 << ptcb->OSTCBY);
+        ptcb->OSTCBBitX          = (INT32U)1 << ptcb->OSTCBX;
+#elif OS_LOWEST_PRIO <= 63
         ptcb->OSTCBY             = (INT8U)(prio >> 3);          /* Pre-compute X, Y, BitX and BitY     */
         ptcb->OSTCBX             = (INT8U)(prio & 0x07);
         ptcb->OSTCBBitY          = (INT8U)(1 << ptcb->OSTCBY);
@@ -1988,6 +3497,11 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBMsg       = (void *)0;                  /* No message received                      */
 #endif
 
+#if OS_TASK_NOTIFY_EN > 0
+        ptcb->OSTCBNotifyVal = 0L;                         /* No notification received                 */
+        ptcb->OSTCBNotifyRdy = OS_FALSE;
+#endif
+
 #if OS_TASK_PROFILE_EN > 0
         ptcb->OSTCBCtxSwCtr    = 0L;                       /* Initialize profiling variables           */
         ptcb->OSTCBCyclesStart = 0L;
@@ -2006,15 +3520,23 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         OSTaskCreateHook(ptcb);                            /* Call user defined hook                   */
 
         OS_ENTER_CRITICAL();
+#if OS_RR_EN > 0
+        OS_PrioJoin(ptcb);                                 /* Owner of, or sibling at, this priority   */
+#else
         OSTCBPrioTbl[prio] = ptcb;
+#endif
         ptcb->OSTCBNext    = OSTCBList;                    /* Link into TCB chain                      */
         ptcb->OSTCBPrev    = (OS_TCB *)0;
         if (OSTCBList != (OS_TCB *)0) {
             OSTCBList->OSTCBPrev = ptcb;
         }
         OSTCBList               = ptcb;
+#if OS_RR_EN > 0
+        OS_RdyListInsert(ptcb);                            /* Make task ready to run                   */
+#else
         OSRdyGrp               |= ptcb->OSTCBBitY;         /* Make task ready to run                   */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
         OSTaskCtr++;                                       /* Increment the #tasks counter             */
         OS_EXIT_CRITICAL();
         return (OS_ERR_NONE);
@@ -988,12 +988,17 @@ OS_FLAGS  OSFlagQuery (OS_FLAG_GRP *pgrp, INT8U *perr)
 static  void  OS_FlagBlock (OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS flags, INT8U wait_type, INT16U timeout)
 {
     OS_FLAG_NODE  *pnode_next;
+#if OS_RR_EN == 0
     INT8U          y;
+#endif
 
 
     OSTCBCur->OSTCBStat      |= OS_STAT_FLAG;
     OSTCBCur->OSTCBStatPend   = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly        = timeout;              /* Store timeout in task's TCB                   */
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur);                      /* Link TCB into the tick list                   */
+#endif
 #if OS_TASK_DEL_EN > 0
     OSTCBCur->OSTCBFlagNode   = pnode;                /* TCB to link to node                           */
 #endif
@@ -1009,11 +1014,15 @@ static  void  OS_FlagBlock (OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS fla
     }
     pgrp->OSFlagWaitList = (void *)pnode;
 
+#if OS_RR_EN > 0
+    OS_RdyListRemove(OSTCBCur);                       /* Suspend current task until flag(s) received   */
+#else
     y            =  OSTCBCur->OSTCBY;                 /* Suspend current task until flag(s) received   */
     OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
     if (OSRdyTbl[y] == 0x00) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
     }
+#endif
 }
 
 /*$PAGE*/
@@ -1105,13 +1114,21 @@ static  BOOLEAN  OS_FlagTaskRdy (OS_FLAG_NODE *pnode, OS_FLAGS flags_rdy)
 
 
     ptcb                 = (OS_TCB *)pnode->OSFlagNodeTCB; /* Point to TCB of waiting task             */
+#if OS_TICK_LIST_EN > 0
+    OS_TickListRemove(ptcb);
+#else
     ptcb->OSTCBDly       = 0;
+#endif
     ptcb->OSTCBFlagsRdy  = flags_rdy;
     ptcb->OSTCBStat     &= ~(INT8U)OS_STAT_FLAG;
     ptcb->OSTCBStatPend  = OS_STAT_PEND_OK;
     if (ptcb->OSTCBStat == OS_STAT_RDY) {                  /* Task now ready?                          */
+#if OS_RR_EN > 0
+        OS_RdyListInsert(ptcb);                            /* Put task into ready list                 */
+#else
         OSRdyGrp               |= ptcb->OSTCBBitY;         /* Put task into ready list                 */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
         sched                   = OS_TRUE;
     } else {
         sched                   = OS_FALSE;
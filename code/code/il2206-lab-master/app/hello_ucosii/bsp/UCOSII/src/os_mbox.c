@@ -192,6 +192,11 @@ OS_EVENT  *OSMboxDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 #if OS_EVENT_NAME_SIZE > 1
                  pevent->OSEventName[0] = '?';             /* Unknown name                             */
                  pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+                 if (pevent->OSEventWaitSet != (OS_WAITSET *)0) {
+                     OS_WaitSetUnlink(pevent);             /* Leave the wait-set first                 */
+                 }
 #endif
                  pevent->OSEventType = OS_EVENT_TYPE_UNUSED;
                  pevent->OSEventPtr  = OSEventFreeList;    /* Return Event Control Block to free list  */
@@ -214,6 +219,11 @@ OS_EVENT  *OSMboxDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 #if OS_EVENT_NAME_SIZE > 1
              pevent->OSEventName[0] = '?';                 /* Unknown name                             */
              pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+             if (pevent->OSEventWaitSet != (OS_WAITSET *)0) {
+                 OS_WaitSetUnlink(pevent);                 /* Leave the wait-set first                 */
+             }
 #endif
              pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
              pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
@@ -312,6 +322,9 @@ void  *OSMboxPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     OSTCBCur->OSTCBStat     |= OS_STAT_MBOX;          /* Message not available, task will pend         */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly       = timeout;               /* Load timeout in TCB                           */
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur);                      /* Link TCB into the tick list                   */
+#endif
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready to run  */
@@ -484,6 +497,13 @@ INT8U  OSMboxPost (OS_EVENT *pevent, void *pmsg)
         return (OS_ERR_MBOX_FULL);
     }
     pevent->OSEventPtr = pmsg;                        /* Place message in mailbox                      */
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+    if ((pevent->OSEventWaitSet != (OS_WAITSET *)0) && (OS_WaitSetSignal(pevent) == OS_TRUE)) {
+        OS_EXIT_CRITICAL();                           /* Task waiting on the wait-set made ready       */
+        OS_Sched();
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -562,6 +582,15 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
         return (OS_ERR_MBOX_FULL);
     }
     pevent->OSEventPtr = pmsg;                        /* Place message in mailbox                      */
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+    if ((pevent->OSEventWaitSet != (OS_WAITSET *)0) && (OS_WaitSetSignal(pevent) == OS_TRUE)) {
+        OS_EXIT_CRITICAL();                           /* Task waiting on the wait-set made ready       */
+        if ((opt & OS_POST_OPT_NO_SCHED) == 0) {
+            OS_Sched();
+        }
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -590,7 +619,10 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
 INT8U  OSMboxQuery (OS_EVENT *pevent, OS_MBOX_DATA *p_mbox_data)
 {
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    INT32U    *psrc;
+    INT32U    *pdest;
+#elif OS_LOWEST_PRIO <= 63
     INT8U     *psrc;
     INT8U     *pdest;
 #else
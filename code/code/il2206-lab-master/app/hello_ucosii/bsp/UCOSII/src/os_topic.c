@@ -0,0 +1,596 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                            TOPIC MANAGEMENT
+*
+* File    : OS_TOPIC.C
+* Version : V2.86
+*
+* A topic carries fixed-size messages from ONE publisher to any number of subscribers, each of which
+* receives every message.  The messages are copied once, into storage given by the application whose
+* number of entries and entry size are powers of 2 (an entry is found with a mask and a shift), and stay
+* there until the publisher wraps around.  A subscriber is an
+* OS_TOPIC_SUB owned by the subscribing task: it holds the sequence number of the next message that task
+* is to receive, so that the publisher does not know about subscribers that are not waiting and does not
+* wait for slow ones.  A subscriber that falls more than a whole buffer behind skips to the oldest message
+* still held and counts the messages it lost.
+*
+* Subscribers with nothing to receive wait on the OS_EVENT of the topic.  Publishing a message readies the
+* tasks found in its wait list, OSEventGrp/OSEventTbl[], so the cost of a publication grows with the number
+* of subscribers actually waiting, not with the number of subscribers.
+*
+* Subscribers copy messages out without disabling interrupts.  OSTopicWr, the number of publications
+* started, tells them when the entry they copied was being overwritten; they then skip to the oldest
+* intact entry and copy it again with interrupts disabled, so that a receive is never retried more than
+* once.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_TopicCopy (OS_TOPIC *ptopic, OS_TOPIC_SUB *psub, void *pmsg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             CREATE A TOPIC
+*
+* Description: This function creates a topic over storage provided by the application.
+*
+* Arguments  : pstorage    is the storage of the messages, 'entries' * 'entry_size' bytes.  It should be word
+*                          aligned for messages to be copied by words.
+*
+*              entries     is the number of messages the topic holds for its subscribers, a power of 2 and
+*                          at least 2.
+*
+*              entry_size  is the size of a message, in bytes, a power of 2.
+*
+*              perr        is a pointer to an error code and can be:
+*                          OS_ERR_NONE            the topic was created
+*                          OS_ERR_CREATE_ISR      if called from an ISR
+*                          OS_ERR_PDATA_NULL      if 'pstorage' is a NULL pointer
+*                          OS_ERR_TOPIC_SIZE      if 'entries' is not a power of 2 >= 2 or 'entry_size' is not
+*                                                 a power of 2
+*                          OS_ERR_TOPIC_DEPLETED  if there is no free topic or no free OS_EVENT
+*
+* Returns    : A pointer to the topic, or NULL on error.
+*********************************************************************************************************
+*/
+
+OS_TOPIC  *OSTopicCreate (void *pstorage, INT32U entries, INT16U entry_size, INT8U *perr)
+{
+    OS_TOPIC  *ptopic;
+    OS_EVENT  *pevent;
+    INT8U      shift;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((OS_TOPIC *)0);
+    }
+    if (pstorage == (void *)0) {                           /* Validate 'pstorage'                      */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((OS_TOPIC *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE from an ISR             */
+        return ((OS_TOPIC *)0);
+    }
+    if ((entries < 2) || ((entries & (entries - 1)) != 0) ||
+        (entry_size == 0) || ((entry_size & (entry_size - 1)) != 0)) {
+        *perr = OS_ERR_TOPIC_SIZE;                         /* Need powers of 2 for the mask and shift  */
+        return ((OS_TOPIC *)0);
+    }
+    shift = 0;
+    while ((entry_size >> shift) > 1) {                    /* shift = log2(entry_size)                 */
+        shift++;
+    }
+    OS_ENTER_CRITICAL();
+    ptopic = OSTopicFreeList;                              /* Get next free topic ...                  */
+    pevent = OSEventFreeList;                              /* ... and an ECB for its waiting tasks     */
+    if ((ptopic == (OS_TOPIC *)0) || (pevent == (OS_EVENT *)0)) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TOPIC_DEPLETED;
+        return ((OS_TOPIC *)0);
+    }
+    OSTopicFreeList = ptopic->OSTopicPtr;
+    OSEventFreeList = (OS_EVENT *)pevent->OSEventPtr;
+    OS_EXIT_CRITICAL();
+    pevent->OSEventType    = OS_EVENT_TYPE_TOPIC;
+    pevent->OSEventCnt     = 0;
+    pevent->OSEventPtr     = (void *)ptopic;               /* Back link to the topic                   */
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                          /* Unknown name                             */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);                          /* No subscriber waiting                    */
+    ptopic->OSTopicPtr       = (OS_TOPIC *)0;
+    ptopic->OSTopicEvent     = pevent;
+    ptopic->OSTopicBuf       = (INT8U *)pstorage;
+    ptopic->OSTopicMask      = entries - 1;
+    ptopic->OSTopicEntrySize = entry_size;
+    ptopic->OSTopicShift     = shift;
+    ptopic->OSTopicSubs      = 0;
+    ptopic->OSTopicSeq       = 0;
+    ptopic->OSTopicWr        = 0;
+    *perr                    = OS_ERR_NONE;
+    return (ptopic);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             DELETE A TOPIC
+*
+* Description: This function deletes a topic.  Its subscribers must have unsubscribed first.
+*
+* Arguments  : ptopic  is a pointer to the topic.
+*
+*              perr    is a pointer to an error code and can be:
+*                      OS_ERR_NONE              the topic was deleted
+*                      OS_ERR_DEL_ISR           if called from an ISR
+*                      OS_ERR_TOPIC_INVALID     if 'ptopic' is not a topic in use
+*                      OS_ERR_TOPIC_SUBSCRIBED  if the topic still has subscribers
+*
+* Returns    : NULL if the topic was deleted, else 'ptopic'.
+*********************************************************************************************************
+*/
+
+OS_TOPIC  *OSTopicDel (OS_TOPIC *ptopic, INT8U *perr)
+{
+    OS_EVENT  *pevent;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (ptopic);
+    }
+    if (ptopic == (OS_TOPIC *)0) {                         /* Validate 'ptopic'                        */
+        *perr = OS_ERR_TOPIC_INVALID;
+        return (ptopic);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (ptopic);
+    }
+    OS_ENTER_CRITICAL();
+    if (ptopic->OSTopicEntrySize == 0) {                   /* Topic already deleted or never created   */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TOPIC_INVALID;
+        return (ptopic);
+    }
+    if (ptopic->OSTopicSubs != 0) {                        /* Waiting tasks are subscribers too        */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TOPIC_SUBSCRIBED;
+        return (ptopic);
+    }
+    pevent                   = ptopic->OSTopicEvent;
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0]   = '?';                        /* Unknown name                             */
+    pevent->OSEventName[1]   = OS_ASCII_NUL;
+#endif
+    pevent->OSEventType      = OS_EVENT_TYPE_UNUSED;
+    pevent->OSEventPtr       = OSEventFreeList;            /* Return Event Control Block to free list  */
+    OSEventFreeList          = pevent;
+    ptopic->OSTopicEntrySize = 0;                          /* Return the topic to the free list        */
+    ptopic->OSTopicEvent     = (OS_EVENT *)0;
+    ptopic->OSTopicBuf       = (INT8U *)0;
+    ptopic->OSTopicPtr       = OSTopicFreeList;
+    OSTopicFreeList          = ptopic;
+    OS_EXIT_CRITICAL();
+    *perr                    = OS_ERR_NONE;
+    return ((OS_TOPIC *)0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           SUBSCRIBE TO A TOPIC
+*
+* Description: This function makes 'psub' a subscriber of the topic.  It receives the messages published
+*              from now on.
+*
+* Arguments  : ptopic  is a pointer to the topic.
+*
+*              psub    is a pointer to the subscriber, storage owned by the subscribing task.  It must not
+*                      be subscribed to a topic already.
+*
+*              perr    is a pointer to an error code and can be:
+*                      OS_ERR_NONE           'psub' is subscribed
+*                      OS_ERR_TOPIC_INVALID  if 'ptopic' is not a topic in use, or 'psub' a NULL pointer
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OSTopicSubscribe (OS_TOPIC *ptopic, OS_TOPIC_SUB *psub, INT8U *perr)
+{
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return;
+    }
+    if ((ptopic == (OS_TOPIC *)0) || (psub == (OS_TOPIC_SUB *)0)) {
+        *perr = OS_ERR_TOPIC_INVALID;
+        return;
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (ptopic->OSTopicEntrySize == 0) {                   /* Topic deleted or never created           */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TOPIC_INVALID;
+        return;
+    }
+    ptopic->OSTopicSubs++;
+    psub->OSTopicSubTopic = ptopic;
+    psub->OSTopicSubSeq   = ptopic->OSTopicSeq;            /* Next message is the next one published   */
+    psub->OSTopicSubLost  = 0;
+    OS_EXIT_CRITICAL();
+    *perr                 = OS_ERR_NONE;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         UNSUBSCRIBE FROM A TOPIC
+*
+* Description: This function removes 'psub' from the subscribers of its topic.  It must not be called for
+*              a subscriber whose task waits in OSTopicPend().
+*
+* Arguments  : psub  is a pointer to the subscriber.
+*
+*              perr  is a pointer to an error code and can be:
+*                    OS_ERR_NONE           'psub' is no longer subscribed
+*                    OS_ERR_TOPIC_INVALID  if 'psub' is a NULL pointer or is not subscribed
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OSTopicUnsubscribe (OS_TOPIC_SUB *psub, INT8U *perr)
+{
+    OS_TOPIC  *ptopic;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return;
+    }
+    if (psub == (OS_TOPIC_SUB *)0) {                       /* Validate 'psub'                          */
+        *perr = OS_ERR_TOPIC_INVALID;
+        return;
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    ptopic = psub->OSTopicSubTopic;
+    if (ptopic == (OS_TOPIC *)0) {                         /* Not subscribed                           */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TOPIC_INVALID;
+        return;
+    }
+    ptopic->OSTopicSubs--;
+    psub->OSTopicSubTopic = (OS_TOPIC *)0;
+    OS_EXIT_CRITICAL();
+    *perr                 = OS_ERR_NONE;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           PUBLISH TO A TOPIC
+*
+* Description: This function copies a message into the topic, for every subscriber, and readies the
+*              subscribers waiting in OSTopicPend().  It never waits: when a subscriber is a whole buffer
+*              behind, its oldest message is overwritten.  It can be called from an ISR.
+*
+* Arguments  : ptopic  is a pointer to the topic.
+*
+*              pmsg    is a pointer to the message, 'entry_size' bytes.
+*
+* Returns    : OS_ERR_NONE           the message was published
+*              OS_ERR_TOPIC_INVALID  if 'ptopic' is a NULL pointer
+*              OS_ERR_POST_NULL_PTR  if 'pmsg' is a NULL pointer
+*
+* Note(s)    : 1) A topic has a single publisher.  Several publishers, such as a task and an ISR, must
+*                 serialize among themselves.
+*
+*              2) Interrupts are only disabled when subscribers wait, for as long as it takes to ready them.
+*********************************************************************************************************
+*/
+
+INT8U  OSTopicPublish (OS_TOPIC *ptopic, void *pmsg)
+{
+    OS_EVENT  *pevent;
+    INT32U     seq;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (ptopic == (OS_TOPIC *)0) {                         /* Validate 'ptopic'                        */
+        return (OS_ERR_TOPIC_INVALID);
+    }
+    if (pmsg == (void *)0) {                               /* Validate 'pmsg'                          */
+        return (OS_ERR_POST_NULL_PTR);
+    }
+#endif
+    seq               = ptopic->OSTopicSeq;
+    ptopic->OSTopicWr = seq + 1;                           /* Subscribers copying this entry must retry */
+    OS_CPU_BARRIER();
+    OS_MemCopy(ptopic->OSTopicBuf + ((seq & ptopic->OSTopicMask) << ptopic->OSTopicShift),
+               (INT8U *)pmsg, ptopic->OSTopicEntrySize);
+    OS_CPU_BARRIER();                                      /* Message written before it is published   */
+    ptopic->OSTopicSeq = seq + 1;
+    OS_CPU_BARRIER();                                      /* Published before the wait list is read   */
+    pevent = ptopic->OSTopicEvent;
+    if (pevent->OSEventGrp != 0) {                         /* Only waiting subscribers cost anything   */
+        OS_ENTER_CRITICAL();
+        while (pevent->OSEventGrp != 0) {                  /* Ready ALL tasks waiting on the topic     */
+            (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_TOPIC, OS_STAT_PEND_OK);
+        }
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                        /* Find highest priority task ready to run  */
+    }
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   RECEIVE A MESSAGE WITHOUT WAITING
+*
+* Description: This function copies the next message of the subscriber, if there is one.  It can be
+*              called from an ISR that owns the subscriber.
+*
+* Arguments  : psub  is a pointer to the subscriber.
+*
+*              pmsg  is a pointer to where the message is copied, 'entry_size' bytes.
+*
+* Returns    : OS_ERR_NONE           a message was copied
+*              OS_ERR_TOPIC_EMPTY    if no message was published since the last one received
+*              OS_ERR_TOPIC_INVALID  if 'psub' is a NULL pointer or is not subscribed
+*              OS_ERR_PDATA_NULL     if 'pmsg' is a NULL pointer
+*********************************************************************************************************
+*/
+
+INT8U  OSTopicAccept (OS_TOPIC_SUB *psub, void *pmsg)
+{
+    OS_TOPIC  *ptopic;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (psub == (OS_TOPIC_SUB *)0) {                       /* Validate 'psub'                          */
+        return (OS_ERR_TOPIC_INVALID);
+    }
+    if (pmsg == (void *)0) {                               /* Validate 'pmsg'                          */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    ptopic = psub->OSTopicSubTopic;
+    if (ptopic == (OS_TOPIC *)0) {                         /* Not subscribed                           */
+        return (OS_ERR_TOPIC_INVALID);
+    }
+    if (OS_TopicCopy(ptopic, psub, pmsg) == OS_FALSE) {
+        return (OS_ERR_TOPIC_EMPTY);
+    }
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     WAIT FOR A MESSAGE ON A TOPIC
+*
+* Description: This function copies the next message of the subscriber, waiting for it to be published if
+*              the subscriber has received them all.
+*
+* Arguments  : psub     is a pointer to the subscriber.
+*
+*              pmsg     is a pointer to where the message is copied, 'entry_size' bytes.
+*
+*              timeout  is an optional timeout period (in clock ticks).  If non-zero, your task will wait
+*                       for a message up to the amount of time specified by this argument.  If you specify
+*                       0, however, your task will wait forever.
+*
+*              perr     is a pointer to an error code and can be:
+*                       OS_ERR_NONE           a message was copied
+*                       OS_ERR_TIMEOUT        no message was published within 'timeout'
+*                       OS_ERR_PEND_ISR       if called from an ISR
+*                       OS_ERR_PEND_LOCKED    if called with the scheduler locked and no message
+*                       OS_ERR_TOPIC_INVALID  if 'psub' is a NULL pointer or is not subscribed
+*                       OS_ERR_PDATA_NULL     if 'pmsg' is a NULL pointer
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OSTopicPend (OS_TOPIC_SUB *psub, void *pmsg, INT16U timeout, INT8U *perr)
+{
+    OS_TOPIC  *ptopic;
+    OS_EVENT  *pevent;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return;
+    }
+    if (psub == (OS_TOPIC_SUB *)0) {                       /* Validate 'psub'                          */
+        *perr = OS_ERR_TOPIC_INVALID;
+        return;
+    }
+    if (pmsg == (void *)0) {                               /* Validate 'pmsg'                          */
+        *perr = OS_ERR_PDATA_NULL;
+        return;
+    }
+#endif
+    ptopic = psub->OSTopicSubTopic;
+    if (ptopic == (OS_TOPIC *)0) {                         /* Not subscribed                           */
+        *perr = OS_ERR_TOPIC_INVALID;
+        return;
+    }
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_PEND_ISR;                           /* ... can't PEND from an ISR               */
+        return;
+    }
+    if (OS_TopicCopy(ptopic, psub, pmsg) == OS_TRUE) {     /* Message already there                    */
+        *perr = OS_ERR_NONE;
+        return;
+    }
+    pevent = ptopic->OSTopicEvent;
+    OS_ENTER_CRITICAL();
+    if (psub->OSTopicSubSeq == ptopic->OSTopicSeq) {       /* Still nothing new, must wait             */
+        if (OSLockNesting > 0) {                           /* See if called with scheduler locked ...  */
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_PEND_LOCKED;                    /* ... can't PEND when locked               */
+            return;
+        }
+        OSTCBCur->OSTCBStat     |= OS_STAT_TOPIC;          /* Pend on the topic                        */
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+        OSTCBCur->OSTCBDly       = timeout;                /* Store pend timeout in TCB                */
+#if OS_TICK_LIST_EN > 0
+        OS_TickListInsert(OSTCBCur);                       /* Link TCB into the tick list              */
+#endif
+        OS_EventTaskWait(pevent);                          /* Suspend task until published or timeout  */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                        /* Find next highest priority task ready    */
+        OS_ENTER_CRITICAL();
+        if (OSTCBCur->OSTCBStatPend != OS_STAT_PEND_OK) {  /* See if we timed-out or aborted           */
+            OS_EventTaskRemove(OSTCBCur, pevent);
+        }
+        OSTCBCur->OSTCBStat          =  OS_STAT_RDY;       /* Set   task  status to ready              */
+        OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;   /* Clear pend  status                       */
+        OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;     /* Clear event pointers                     */
+#if (OS_EVENT_MULTI_EN > 0)
+        OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    }
+    OS_EXIT_CRITICAL();
+    if (OS_TopicCopy(ptopic, psub, pmsg) == OS_TRUE) {     /* A message published at the timeout counts */
+        *perr = OS_ERR_NONE;
+    } else {
+        *perr = OS_ERR_TIMEOUT;                            /* Indicate that nothing came within TO     */
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  COPY THE NEXT MESSAGE OF A SUBSCRIBER
+*
+* Description: This function copies the next message of 'psub', skipping the messages that were
+*              overwritten, and moves the subscriber past it.
+*
+* Arguments  : ptopic  is a pointer to the topic of 'psub'.
+*
+*              psub    is a pointer to the subscriber.
+*
+*              pmsg    is a pointer to where the message is copied.
+*
+* Returns    : OS_TRUE   if a message was copied
+*              OS_FALSE  if the subscriber has received every message published
+*
+* Note(s)    : 1) Entry N is overwritten by publication N + 'entries', which sets OSTopicWr to
+*                 N + 'entries' + 1 before it starts.  With interrupts disabled, the entries from
+*                 OSTopicWr - 'entries' to OSTopicSeq - 1 are intact, at least one since 'entries' >= 2.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_TopicCopy (OS_TOPIC *ptopic, OS_TOPIC_SUB *psub, void *pmsg)
+{
+    INT32U     seq;
+    INT32U     pub;
+    INT32U     entries;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    seq = psub->OSTopicSubSeq;
+    pub = ptopic->OSTopicSeq;
+    if (seq == pub) {                                      /* Nothing new                              */
+        return (OS_FALSE);
+    }
+    entries = ptopic->OSTopicMask + 1;
+    if ((pub - seq) > entries) {                           /* Oldest messages already overwritten      */
+        seq = pub - entries;
+    }
+    OS_CPU_BARRIER();                                      /* Message read after it was published      */
+    OS_MemCopy((INT8U *)pmsg, ptopic->OSTopicBuf + ((seq & ptopic->OSTopicMask) << ptopic->OSTopicShift),
+               ptopic->OSTopicEntrySize);
+    OS_CPU_BARRIER();
+    if ((ptopic->OSTopicWr - seq) > entries) {             /* Overwritten while copied, see Note #1    */
+        OS_ENTER_CRITICAL();                               /* The publisher cannot run                 */
+        seq = ptopic->OSTopicWr - entries;
+        OS_MemCopy((INT8U *)pmsg, ptopic->OSTopicBuf + ((seq & ptopic->OSTopicMask) << ptopic->OSTopicShift),
+                   ptopic->OSTopicEntrySize);
+        OS_EXIT_CRITICAL();
+    }
+    psub->OSTopicSubLost += seq - psub->OSTopicSubSeq;
+    psub->OSTopicSubSeq   = seq + 1;
+    return (OS_TRUE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         INITIALIZE THE TOPICS
+*
+* Description: This function is called by OSInit() to chain the topic control blocks into the free list.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_TopicInit (void)
+{
+    INT16U  i;
+
+
+    OS_MemClr((INT8U *)&OSTopicTbl[0], sizeof(OSTopicTbl));   /* Clear the topic table              */
+    for (i = 0; i < (OS_MAX_TOPICS - 1); i++) {                /* Init. list of free topics          */
+        OSTopicTbl[i].OSTopicPtr = &OSTopicTbl[i + 1];
+    }
+    OSTopicTbl[OS_MAX_TOPICS - 1].OSTopicPtr = (OS_TOPIC *)0;
+    OSTopicFreeList = &OSTopicTbl[0];
+}
+#endif                                                     /* OS_TOPIC_EN                              */
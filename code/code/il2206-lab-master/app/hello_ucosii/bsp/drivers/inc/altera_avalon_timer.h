@@ -72,6 +72,15 @@ extern "C"
 extern void alt_avalon_timer_sc_init (void* base, alt_u32 irq_controller_id, 
                                       alt_u32 irq, alt_u32 freq);
 
+/*
+ * Stop and restart the periodic system clock around idle periods. These are
+ * only available when the operating system accepts several ticks at once
+ * (see altera_avalon_timer_sc.c).
+ */
+
+extern void alt_avalon_timer_sc_sleep (alt_u32 nticks);
+extern void alt_avalon_timer_sc_wake (void);
+
 /*
  * Variables used to store the timestamp parameters, when the device is to be
  * accessed using the high resolution timestamp driver.
@@ -79,6 +88,8 @@ extern void alt_avalon_timer_sc_init (void* base, alt_u32 irq_controller_id,
 
 extern void*   altera_avalon_timer_ts_base;
 extern alt_u32 altera_avalon_timer_ts_freq;
+extern alt_u32 altera_avalon_timer_ts_irq_controller_id;
+extern alt_32  altera_avalon_timer_ts_irq;
 
 /*
  * ALTERA_AVALON_TIMER_INSTANCE is the macro used by alt_sys_init() to 
@@ -115,6 +126,11 @@ extern alt_u32 altera_avalon_timer_ts_freq;
 #define ALT_SYS_CLK_BASE _ALT_CLK_BASE(ALT_SYS_CLK)
 #define ALT_TIMESTAMP_CLK_BASE _ALT_CLK_BASE(ALT_TIMESTAMP_CLK)
 
+#define __ALT_CLK_FREQ(name) name##_FREQ
+#define _ALT_CLK_FREQ(name) __ALT_CLK_FREQ(name)
+
+#define ALT_TIMESTAMP_CLK_FREQ _ALT_CLK_FREQ(ALT_TIMESTAMP_CLK)
+
 /*
  * If there is no system clock, then the above macro will result in 
  * ALT_SYS_CLK_BASE being set to none_BASE. We therefore need to provide an
@@ -131,7 +147,8 @@ extern alt_u32 altera_avalon_timer_ts_freq;
  * if it has the name "sysclk".
  *
  * If the device is not the system clock, then it is used to provide the
- * timestamp facility. 
+ * timestamp facility. Its interrupt, if connected, is used to extend the
+ * timestamp to 64 bits (see altera_avalon_timer_ts.c).
  *
  * To ensure as much as possible is evaluated at compile time, rather than 
  * compare the name of the device to "/dev/sysclk" using strcmp(), the base
@@ -171,6 +188,9 @@ extern alt_u32 altera_avalon_timer_ts_freq;
     {                                                                         \
       altera_avalon_timer_ts_base = (void*) name##_BASE;                      \
       altera_avalon_timer_ts_freq = name##_FREQ;                              \
+      altera_avalon_timer_ts_irq_controller_id =                              \
+                                    name##_IRQ_INTERRUPT_CONTROLLER_ID;       \
+      altera_avalon_timer_ts_irq  = name##_IRQ;                               \
     }                                                                         \
     else                                                                      \
     {                                                                         \
@@ -7,8 +7,6 @@
 
 #define DEBUG 1
 
-#define HW_TIMER_PERIOD 100 /* 100ms */
-
 /* Definition of Task Stacks */
 #define   TASK_STACKSIZE       2048
 OS_STK    task1_stk[TASK_STACKSIZE];
@@ -25,58 +23,26 @@ OS_STK    StartTask_Stack[TASK_STACKSIZE];
 #define TASK1_PERIOD 400
 #define TASK2_PERIOD 500
 
-/*
- * Global variables
- */
-int delay; // Delay of HW-timer 
-
-/*
- * ISR for HW Timer
- */
-alt_u32 alarm_handler(void* context)
-{
-  OSTmrSignal(); /* Signals a 'tick' to the SW timers */
-  
-  return delay;
-}
-
-// Semaphores
-OS_EVENT *Task1TmrSem;
-OS_EVENT *Task2TmrSem;
-
-// SW-Timer
-OS_TMR *Task1Tmr;
-OS_TMR *Task2Tmr;
-
-/* Timer Callback Functions */ 
-void Task1TmrCallback (void *ptmr, void *callback_arg){
-  OSSemPost(Task1TmrSem);
-  printf("OSSemPost(Task1Sem);\n");
-}
-
-void Task2TmrCallback (void *ptmr, void *callback_arg){
-  OSSemPost(Task2TmrSem);
-  printf("OSSemPost(Task2Sem);\n");
-}
+/* Task Periods in ticks, the tasks are released by the kernel */
+#define TASK1_PERIOD_TICKS OS_TIME_HMSM_TICKS(0, 0, 0, TASK1_PERIOD)
+#define TASK2_PERIOD_TICKS OS_TIME_HMSM_TICKS(0, 0, 0, TASK2_PERIOD)
 
 void task1(void* pdata)
 {
-  INT8U err;
   while (1)
   { 
     printf("Hello from task1\n");
-    OSSemPend(Task1TmrSem, 0, &err);
+    OSTaskWaitNextPeriod(); /* Sleeps until the next release */
   }
 }
 
 
 void task2(void* pdata)
 {
-  INT8U err;
   while (1)
   { 
     printf("Hello from task2\n");
-    OSSemPend(Task2TmrSem, 0, &err);
+    OSTaskWaitNextPeriod(); /* Sleeps until the next release */
   }
 }
 
@@ -84,87 +50,6 @@ void task2(void* pdata)
 void StartTask(void* pdata)
 {
   INT8U err;
-  void* context;
-
-  static alt_alarm alarm;     /* Is needed for timer ISR function */
-  
-  /* Base resolution for SW timer : HW_TIMER_PERIOD ms */
-  delay = alt_ticks_per_second() * HW_TIMER_PERIOD / 1000; 
-  printf("delay in ticks %d\n", delay);
-
-  /* 
-   * Create Hardware Timer with a period of 'delay' 
-   */
-  if (alt_alarm_start (&alarm,
-      delay,
-      alarm_handler,
-      context) < 0)
-      {
-          printf("No system clock available!n");
-      }
-
-  /* 
-   * Create and start Software Timer 
-   */
-
-   //Create Task1 Timer
-   Task1Tmr = OSTmrCreate(0, //delay
-                            TASK1_PERIOD/HW_TIMER_PERIOD, //period
-                            OS_TMR_OPT_PERIODIC,
-                            Task1TmrCallback, //OS_TMR_CALLBACK
-                            (void *)0,
-                            "Task1Tmr",
-                            &err);
-                            
-   if (DEBUG) {
-    if (err == OS_ERR_NONE) { //if creation successful
-      printf("Task1Tmr created\n");
-    }
-   }
-   
-   //Create Task1 Timer
-   Task2Tmr = OSTmrCreate(0, //delay
-                            TASK2_PERIOD/HW_TIMER_PERIOD, //period
-                            OS_TMR_OPT_PERIODIC,
-                            Task2TmrCallback, //OS_TMR_CALLBACK
-                            (void *)0,
-                            "Task2Tmr",
-                            &err);
-                            
-   if (DEBUG) {
-    if (err == OS_ERR_NONE) { //if creation successful
-      printf("Task2Tmr created\n");
-    }
-   }
-
-   /*
-    * Start timers
-    */
-   
-   //start Task1 Timer
-   OSTmrStart(Task1Tmr, &err);
-   
-   if (DEBUG) {
-    if (err == OS_ERR_NONE) { //if start successful
-      printf("Task1Tmr started\n");
-    }
-   }
-
-   //start Task2 Timer
-   OSTmrStart(Task2Tmr, &err);
-   
-   if (DEBUG) {
-    if (err == OS_ERR_NONE) { //if start successful
-      printf("Task2Tmr started\n");
-    }
-   }  
-
-   /*
-   * Creation of Kernel Objects
-   */
-
-  Task1TmrSem = OSSemCreate(0);   
-  Task2TmrSem = OSSemCreate(0);   
 
   /*
    * Create statistics task
@@ -176,7 +61,7 @@ void StartTask(void* pdata)
    * Creating Tasks in the system 
    */
 
-  err=OSTaskCreateExt(task1,
+  err=OSTaskCreatePeriodic(task1,
                   NULL,
                   (void *)&task1_stk[TASK_STACKSIZE-1],
                   TASK1_PRIORITY,
@@ -184,7 +69,8 @@ void StartTask(void* pdata)
                   task1_stk,
                   TASK_STACKSIZE,
                   NULL,
-                  0);
+                  0,
+                  TASK1_PERIOD_TICKS);
 
   if (DEBUG) {
      if (err == OS_ERR_NONE) { //if start successful
@@ -192,7 +78,7 @@ void StartTask(void* pdata)
     }
    }  
 
-  err=OSTaskCreateExt(task2,
+  err=OSTaskCreatePeriodic(task2,
                   NULL,
                   (void *)&task2_stk[TASK_STACKSIZE-1],
                   TASK2_PRIORITY,
@@ -200,7 +86,8 @@ void StartTask(void* pdata)
                   task2_stk,
                   TASK_STACKSIZE,
                   NULL,
-                  0);
+                  0,
+                  TASK2_PERIOD_TICKS);
 
   if (DEBUG) {
      if (err == OS_ERR_NONE) { //if start successful
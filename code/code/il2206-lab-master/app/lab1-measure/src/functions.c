@@ -22,25 +22,33 @@ int matrix[M][M];
 void initMatrix (int matrix[][M]);
 int  sumMatrix  (int matrix[][M], int size);
 
-alt_u32 ticks;
-alt_u32 time_1;
-alt_u32 time_2;
-alt_u32 timer_overhead;
-
-float microseconds(int ticks)
+/*
+ * 64-bit timestamps do not wrap, so the timer is started once in main() and
+ * measurements of any length can be taken from it.
+ *
+ * The BSP must have a timestamp timer, e.g. nios2-bsp-editor --set
+ * hal.timestamp_timer timer_1 (ALT_TIMESTAMP_CLK in system.h); with "none"
+ * alt_timestamp_start() fails and nothing is measured.
+ */
+
+alt_u64 ticks;
+alt_u64 time_1;
+alt_u64 time_2;
+alt_u64 timer_overhead;
+
+float microseconds(alt_u64 ticks)
 {
   return (float) 1000000 * (float) ticks / (float) alt_timestamp_freq();
 }
 
 void start_measurement()
 {
-  alt_timestamp_start();
-  time_1 = alt_timestamp();
+  time_1 = alt_timestamp64();
 }
 
 void stop_measurement()
 {
-  time_2 = alt_timestamp();
+  time_2 = alt_timestamp64();
   ticks = time_2 - time_1;
 }
 
@@ -71,7 +79,7 @@ int main ()
       }
       timer_overhead = timer_overhead / 10;
         
-      printf("Timer overhead in ticks: %d\n", (int) timer_overhead);
+      printf("Timer overhead in ticks: %llu\n", timer_overhead);
       printf("Timer overhead in ms:    %f\n\n", 
 	     1000.0 * (float)timer_overhead/(float)alt_timestamp_freq());
     
@@ -82,7 +90,7 @@ int main ()
       stop_measurement();    
       printf("Result: %d\n", a);
       printf("%5.2f us", microseconds(ticks - timer_overhead));
-      printf("(%d ticks)\n", (int) (ticks - timer_overhead)); 
+      printf("(%llu ticks)\n", ticks - timer_overhead); 
 
       printf("Done!\n");
 
@@ -82,6 +82,8 @@ typedef unsigned short INT16U;                   /* Unsigned 16 bit quantity
 typedef signed   short INT16S;                   /* Signed   16 bit quantity                           */
 typedef unsigned long  INT32U;                   /* Unsigned 32 bit quantity                           */
 typedef signed   long  INT32S;                   /* Signed   32 bit quantity                           */
+typedef unsigned long long INT64U;               /* Unsigned 64 bit quantity                           */
+typedef signed   long long INT64S;               /* Signed   64 bit quantity                           */
 typedef float          FP32;                     /* Single precision floating point                    */
 typedef double         FP64;                     /* Double precision floating point                    */
 typedef unsigned int   OS_STK;                   /* Each stack entry is 32-bits                        */
@@ -130,6 +132,36 @@ typedef unsigned int   OS_STK;                   /* Each stack entry is 32-bits
          alt_irq_enable_all (cpu_sr);
 #endif
 
+/******************************************************************************************
+ *                        Free running cycle counter (OS_TS_GET)
+ *
+ * OS_TS_GET() returns the low 32 bits of a cycle count, used by OS_TMR_STATS_EN to time
+ * the timer callbacks. It reads the time base of the high-resolution timers when they are
+ * built (-DALT_HRTIMER), else the timestamp timer if the system has one, which the
+ * application starts with alt_timestamp_start(). Without either, OS_TS_GET() is left
+ * undefined and the callbacks are not timed.
+ *****************************************************************************************/
+
+#if defined(ALT_HRTIMER)
+#include "sys/alt_hrtimer.h"
+#define  OS_TS_GET()          ((INT32U)alt_hrtimer_now())
+#else
+#include "sys/alt_timestamp.h"
+#if      ALT_TIMESTAMP_CLK_BASE != none_BASE
+#define  OS_TS_GET()          ((INT32U)alt_timestamp())
+#endif
+#endif
+
+/******************************************************************************************
+ *                               Memory ordering (OS_CPU_BARRIER)
+ *
+ * The Nios II is a single in-order core that sees its own loads and stores in program
+ * order, so the lock-free ring channels (OS_RING.C) only have to stop the compiler from
+ * moving memory accesses across OS_CPU_BARRIER().
+ *****************************************************************************************/
+
+#define  OS_CPU_BARRIER()     __asm__ __volatile__ ("" : : : "memory")
+
 /* Prototypes */
 void OSStartHighRdy(void); 
 void OSCtxSw(void); 
@@ -242,4 +242,10 @@ static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_irq_pending (void)
 }
 #endif /* __cplusplus */
 
+/*
+ * With ALT_IRQ_TRACE, alt_irq_disable_all() and alt_irq_enable_all() are
+ * redirected to the interrupt-disabled time tracer from here on.
+ */
+#include "sys/alt_irq_trace.h"
+
 #endif /* __ALT_IRQ_H__ */
@@ -60,6 +60,15 @@ extern OS_EVENT *alt_heapsem;
 #define ALT_OS_INT_ENTER OSIntEnter
 #define ALT_OS_INT_EXIT  OSIntExit
 
+/*
+ * With OS_TICKLESS_EN the system clock driver may stop the tick while the
+ * CPU is idle and report the elapsed ticks in one call.
+ */
+
+#if OS_TICKLESS_EN > 0
+#define ALT_OS_TIME_TICK_N OSTimeTickN
+#endif
+
 #endif /* ALT_ASM_SRC */
 
 /* These macros are used by the VIC funnel assembly code */
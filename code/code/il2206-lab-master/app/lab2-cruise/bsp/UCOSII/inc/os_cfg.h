@@ -45,16 +45,70 @@ extern "C"
                                        /* ---------------------- MISCELLANEOUS ----------------------- */
 #define OS_APP_HOOKS_EN           1    /* Application-defined hooks are called from the uC/OS-II hooks */
 #define OS_EVENT_MULTI_EN         1    /* Include code for OSEventPendMulti()                          */
+#define OS_SCHED_BITMAP_EN        1    /* Ready/wait lists as 32-bit bitmaps, no OSUnMapTbl[] lookups  */
+#define OS_ISR_DEFER_EN           0    /* ISRs queue posts with OSIntDefer(), replayed by a task       */
+#define OS_ISR_DEFER_SIZE        16u   /*     Number of deferred posts that can be queued              */
+#define OS_TASK_DEFER_PRIO        1u   /*     Priority of the task replaying them                      */
+#define OS_TASK_DEFER_STK_SIZE  512u   /*     Stack size of that task, in OS_STK units                 */
+#define OS_IDLE_JOB_EN            0    /* Background jobs run by the idle task (see OSIdleJobAdd())    */
+#define OS_MAX_IDLE_JOBS          4u   /*     Max. number of idle jobs                                 */
+
+                                       /* ---------------------- TASK MANAGEMENT --------------------- */
+#define OS_RR_EN                  0    /*     Allow several tasks per priority, time sliced            */
+#define OS_RR_QUANTA             10u   /*     Default time slice, in ticks                             */
+#define OS_EDF_EN                 0    /*     Earliest-deadline-first among the tasks in a priority band */
+#define OS_EDF_PRIO_HI            5u   /*     Highest priority of the EDF band                         */
+#define OS_EDF_PRIO_LO           15u   /*     Lowest  priority of the EDF band                         */
+#define OS_PREEMPT_THRESH_EN      0    /*     Per-task preemption threshold (see OSTaskThreshSet())    */
+#define OS_TASK_NOTIFY_EN         1    /*     Include code for OSTaskNotify() and OSTaskNotifyPend()    */
+#define OS_TASK_PERIODIC_EN       1    /*     Include code for OSTaskCreatePeriodic()                  */
 
                                        /* -------------------- MESSAGE MAILBOXES --------------------- */
 #define OS_MBOX_PEND_ABORT_EN     1    /*     Include code for OSMboxPendAbort()                       */
 
                                        /* ---------------------- MESSAGE QUEUES ---------------------- */
 #define OS_Q_PEND_ABORT_EN        1    /*     Include code for OSQPendAbort()                          */
+#define OS_Q_MULTI_EN             1    /*     Include code for OSQPostMulti() and OSQPendMulti()       */
+
+                                       /* ----------------------- RING CHANNELS ---------------------- */
+#define OS_RING_EN                1    /* Single-producer/single-consumer channels (OSRing...())       */
+#define OS_MAX_RINGS              4u   /*     Max. number of ring channels                             */
+
+                                       /* ------------------------ STATE PORTS ----------------------- */
+#define OS_PORT_EN                1    /* Latest-value cells, one writer, many readers (OSPort...())   */
+#define OS_MAX_PORTS              8u   /*     Max. number of state ports                               */
+#define OS_PORT_DATA_SIZE         8u   /*     Largest value held by a port, in bytes                   */
+
+                                       /* -------------------------- TOPICS -------------------------- */
+#define OS_TOPIC_EN               1    /* One publisher, each message to all subscribers (OSTopic...())*/
+#define OS_MAX_TOPICS             4u   /*     Max. number of topics                                    */
+
+                                       /* ------------------------- WAIT-SETS ------------------------ */
+#define OS_WAITSET_EN             1    /* Wait on registered sems/mboxes/queues (OSWaitSet...())       */
+#define OS_MAX_WAITSETS           2u   /*     Max. number of wait-sets                                 */
+#define OS_WAITSET_SIZE          16u   /*     Max. number of members of a wait-set (<= 32)             */
 
                                        /* ------------------------ SEMAPHORES ------------------------ */
 #define OS_SEM_PEND_ABORT_EN      1    /*    Include code for OSSemPendAbort()                         */
 
+                                       /* --------------------- TIME MANAGEMENT ---------------------- */
+#define OS_TICK_LIST_EN           1    /*     Keep delays/timeouts in a delta list (O(1) OSTimeTick()) */
+#define OS_TIME_DLY_UNTIL_EN      1    /*     Include code for OSTimeDlyUntil()                        */
+#define OS_TICKLESS_EN            0    /*     Stop the periodic tick while idle (needs OS_TICK_LIST_EN) */
+#define OS_TICKLESS_MAX_TICKS  1000u   /*     Longest idle period programmed in one go, in ticks        */
+
+                                       /* --------------------- TIMER MANAGEMENT --------------------- */
+#define OS_TMR_HWHEEL_EN          1    /*     Hierarchical timer wheel, replaces OS_TMR_CFG_WHEEL_SIZE */
+#define OS_TMR_HWHEEL_BITS        6u   /*     Spokes per level, as a power of 2 (64)                   */
+#define OS_TMR_HWHEEL_LEVELS      4u   /*     Number of levels, covers 2^(BITS*LEVELS) timer ticks     */
+#define OS_TMR_ISR_CALLBACK_EN    1    /*     Allow callbacks run by OSTmrSignal() (OS_TMR_OPT_ISR_CALLBACK) */
+#define OS_TMR_GRP_EN             1    /*     Include code for timer groups (OSTmrGrp...())            */
+#define OS_TMR_CFG_GRP_MAX        2u   /*     Maximum number of timer groups                           */
+#define OS_TMR_CFG_GRP_MEMBERS    8u   /*     Maximum number of members in a timer group               */
+#define OS_TMR_STATS_EN           0    /*     Per-timer expiries, callback run time and lateness       */
+#define OS_TMR_STATS_BINS         8u   /*     Bins per histogram, the last one counts all larger values */
+#define OS_TMR_STATS_BIN0_LOG2    7u   /*     Run time bin 0 is < 2^7 cycles, each next bin doubles    */
+
                                                                                                                      
 #include "system.h"
 
@@ -402,7 +402,9 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     BOOLEAN    rdy;                                        /* Flag indicating task was ready           */
     OS_TCB    *ptcb;
     OS_EVENT  *pevent2;
+#if OS_RR_EN == 0
     INT8U      y;
+#endif
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -451,6 +453,18 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     ptcb  = (OS_TCB *)(pevent->OSEventPtr);                       /*     Point to TCB of mutex owner   */
     if (ptcb->OSTCBPrio > pip) {                                  /*     Need to promote prio of owner?*/
         if (mprio > OSTCBCur->OSTCBPrio) {
+#if OS_RR_EN > 0
+            if (ptcb->OSTCBRdyNext != (OS_TCB *)0) {              /*     See if mutex owner is ready   */
+                OS_RdyListRemove(ptcb);                           /*     Yes, Remove owner from Rdy ...*/
+                rdy = OS_TRUE;                                    /*          ... list at current prio */
+            } else {
+                pevent2 = ptcb->OSTCBEventPtr;
+                if (pevent2 != (OS_EVENT *)0) {                   /* Remove from event wait list       */
+                    OS_EventTaskRemove(ptcb, pevent2);
+                }
+                rdy = OS_FALSE;                            /* No                                       */
+            }
+#else
             y = ptcb->OSTCBY;
             if ((OSRdyTbl[y] & ptcb->OSTCBBitX) != 0) {           /*     See if mutex owner is ready   */
                 OSRdyTbl[y] &= ~ptcb->OSTCBBitX;                  /*     Yes, Remove owner from Rdy ...*/
@@ -467,8 +481,14 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
                 }
                 rdy = OS_FALSE;                            /* No                                       */
             }
+#endif
             ptcb->OSTCBPrio = pip;                         /* Change owner task prio to PIP            */
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+            ptcb->OSTCBY    = (INT8U)( ptcb->OSTCBPrio >> 5);
+            ptcb->OSTCBX    = (INT8U)( ptcb->OSTCBPrio & 0x1F);
+            ptcb->OSTCBBitY = (INT8U)(1 << ptcb->OSTCBY);
+            ptcb->OSTCBBitX = (INT32U)1 << ptcb->OSTCBX;
+#elif OS_LOWEST_PRIO <= 63
             ptcb->OSTCBY    = (INT8U)( ptcb->OSTCBPrio >> 3);
             ptcb->OSTCBX    = (INT8U)( ptcb->OSTCBPrio & 0x07);
             ptcb->OSTCBBitY = (INT8U)(1 << ptcb->OSTCBY);
@@ -480,8 +500,12 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
             ptcb->OSTCBBitX = (INT16U)(1 << ptcb->OSTCBX);
 #endif
             if (rdy == OS_TRUE) {                          /* If task was ready at owner's priority ...*/
+#if OS_RR_EN > 0
+                OS_RdyListInsert(ptcb);                    /* ... make it ready at new priority.       */
+#else
                 OSRdyGrp               |= ptcb->OSTCBBitY; /* ... make it ready at new priority.       */
                 OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
             } else {
                 pevent2 = ptcb->OSTCBEventPtr;
                 if (pevent2 != (OS_EVENT *)0) {            /* Add to event wait list                   */
@@ -495,6 +519,9 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     OSTCBCur->OSTCBStat     |= OS_STAT_MUTEX;         /* Mutex not available, pend current task        */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly       = timeout;               /* Store timeout in current task's TCB           */
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur);                      /* Link TCB into the tick list                   */
+#endif
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
@@ -580,11 +607,16 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
     }
     OSTCBPrioTbl[pip] = OS_TCB_RESERVED;              /* Reserve table entry                           */
     if (pevent->OSEventGrp != 0) {                    /* Any task waiting for the mutex?               */
+#if OS_RR_EN > 0
+        pevent->OSEventPtr  = (void *)OS_EventTaskFind(pevent);  /* Link to new mutex owner's OS_TCB  */
+#endif
                                                       /* Yes, Make HPT waiting for mutex ready         */
         prio                = OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;  /*      Save priority of mutex's new owner       */
         pevent->OSEventCnt |= prio;
+#if OS_RR_EN == 0
         pevent->OSEventPtr  = OSTCBPrioTbl[prio];     /*      Link to new mutex owner's OS_TCB         */
+#endif
         if (prio <= pip) {                            /*      PIP 'must' have a SMALLER prio ...       */
             OS_EXIT_CRITICAL();                       /*      ... than current task!                   */
             OS_Sched();                               /*      Find highest priority task ready to run  */
@@ -623,7 +655,10 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
 INT8U  OSMutexQuery (OS_EVENT *pevent, OS_MUTEX_DATA *p_mutex_data)
 {
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    INT32U    *psrc;
+    INT32U    *pdest;
+#elif OS_LOWEST_PRIO <= 63
     INT8U     *psrc;
     INT8U     *pdest;
 #else
@@ -686,6 +721,9 @@ INT8U  OSMutexQuery (OS_EVENT *pevent, OS_MUTEX_DATA *p_mutex_data)
 
 static  void  OSMutex_RdyAtPrio (OS_TCB *ptcb, INT8U prio)
 {
+#if OS_RR_EN > 0
+    OS_RdyListRemove(ptcb);                                /* Remove owner from ready list at 'pip'    */
+#else
     INT8U   y;
 
 
@@ -694,8 +732,14 @@ static  void  OSMutex_RdyAtPrio (OS_TCB *ptcb, INT8U prio)
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~ptcb->OSTCBBitY;
     }
+#endif
     ptcb->OSTCBPrio         = prio;
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_BITMAP_EN > 0
+    ptcb->OSTCBY            = (INT8U)((prio >> (INT8U)5) & (INT8U)0x07);
+    ptcb->OSTCBX            = (INT8U) (prio & (INT8U)0x1F);
+    ptcb->OSTCBBitY         = (INT8U)(1 << ptcb->OSTCBY);
+    ptcb->OSTCBBitX         = (INT32U)1 << ptcb->OSTCBX;
+#elif OS_LOWEST_PRIO <= 63
     ptcb->OSTCBY            = (INT8U)((prio >> (INT8U)3) & (INT8U)0x07);
     ptcb->OSTCBX            = (INT8U) (prio & (INT8U)0x07);
     ptcb->OSTCBBitY         = (INT8U)(1 << ptcb->OSTCBY);
@@ -706,9 +750,13 @@ static  void  OSMutex_RdyAtPrio (OS_TCB *ptcb, INT8U prio)
     ptcb->OSTCBBitY         = (INT16U)(1 << ptcb->OSTCBY);
     ptcb->OSTCBBitX         = (INT16U)(1 << ptcb->OSTCBX);
 #endif
+#if OS_RR_EN > 0
+    OS_RdyListInsert(ptcb);                                /* Make task ready at original priority     */
+#else
     OSRdyGrp               |= ptcb->OSTCBBitY;             /* Make task ready at original priority     */
     OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
     OSTCBPrioTbl[prio]      = ptcb;
+#endif
 }
 
 
@@ -0,0 +1,452 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                         RING CHANNEL MANAGEMENT
+*
+* File    : OS_RING.C
+* Version : V2.86
+*
+* A ring channel carries fixed-size entries from ONE producer to ONE consumer.  The entries are copied
+* into storage given by the application.  Their number and their size are powers of 2, so that entry N
+* is found at byte (N & OSRingMask) << OSRingShift, without a multiply.  The producer only
+* writes OSRingIn and the consumer only writes OSRingOut, both free-running counts of entries, so that
+* neither side needs a critical section: a 32-bit store is atomic on the Nios II and OS_CPU_BARRIER()
+* keeps the copy of an entry on the right side of the store that publishes or releases it.
+*
+* The producer may be a task or an ISR, the consumer a task (or an ISR polling with OSRingAccept()).
+* Several producers, or several consumers, must serialize among themselves.
+*
+* A ring created with OS_RING_OPT_PEND has a semaphore on which its consumer sleeps in OSRingPend().
+* The consumer raises OSRingWait before it looks at the ring a last time and sleeps; the producer posts
+* the semaphore only when it finds OSRingWait raised after publishing an entry, that is only when the
+* ring went from empty to non-empty under a sleeping consumer.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+/*
+*********************************************************************************************************
+*                                         CREATE A RING CHANNEL
+*
+* Description: This function creates a ring channel over storage provided by the application.
+*
+* Arguments  : pstorage    is the storage of the entries, 'entries' * 'entry_size' bytes.  It should be word
+*                          aligned for entries to be copied by words.
+*
+*              entries     is the number of entries the ring can hold, a power of 2.
+*
+*              entry_size  is the size of an entry, in bytes, a power of 2.
+*
+*              opt         OS_RING_OPT_NONE  the consumer polls with OSRingAccept()
+*                          OS_RING_OPT_PEND  the consumer may also wait in OSRingPend(), which takes an
+*                                            OS_EVENT for the semaphore it sleeps on
+*
+*              perr        is a pointer to an error code and can be:
+*                          OS_ERR_NONE           the ring was created
+*                          OS_ERR_CREATE_ISR     if called from an ISR
+*                          OS_ERR_PDATA_NULL     if 'pstorage' is a NULL pointer
+*                          OS_ERR_RING_SIZE      if 'entries' or 'entry_size' is not a power of 2
+*                          OS_ERR_INVALID_OPT    if 'opt' is invalid, or OS_RING_OPT_PEND without OS_SEM_EN
+*                          OS_ERR_RING_DEPLETED  if there is no free ring, or no OS_EVENT for OS_RING_OPT_PEND
+*
+* Returns    : A pointer to the ring, or NULL on error.
+*********************************************************************************************************
+*/
+
+OS_RING  *OSRingCreate (void *pstorage, INT32U entries, INT16U entry_size, INT8U opt, INT8U *perr)
+{
+    OS_RING   *pring;
+    INT8U      shift;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((OS_RING *)0);
+    }
+    if (pstorage == (void *)0) {                           /* Validate 'pstorage'                      */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((OS_RING *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE from an ISR             */
+        return ((OS_RING *)0);
+    }
+    if ((entries == 0) || ((entries & (entries - 1)) != 0) ||
+        (entry_size == 0) || ((entry_size & (entry_size - 1)) != 0)) {
+        *perr = OS_ERR_RING_SIZE;                          /* Need powers of 2 for the mask and shift  */
+        return ((OS_RING *)0);
+    }
+    shift = 0;
+    while ((entry_size >> shift) > 1) {                    /* shift = log2(entry_size)                 */
+        shift++;
+    }
+#if OS_SEM_EN > 0
+    if ((opt != OS_RING_OPT_NONE) && (opt != OS_RING_OPT_PEND)) {
+#else
+    if (opt != OS_RING_OPT_NONE) {
+#endif
+        *perr = OS_ERR_INVALID_OPT;
+        return ((OS_RING *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pring = OSRingFreeList;                                /* Get next free ring                       */
+    if (pring != (OS_RING *)0) {
+        OSRingFreeList = pring->OSRingPtr;
+    }
+    OS_EXIT_CRITICAL();
+    if (pring == (OS_RING *)0) {
+        *perr = OS_ERR_RING_DEPLETED;
+        return ((OS_RING *)0);
+    }
+    pring->OSRingSem = (OS_EVENT *)0;
+#if OS_SEM_EN > 0
+    if (opt == OS_RING_OPT_PEND) {
+        pring->OSRingSem = OSSemCreate(0);
+        if (pring->OSRingSem == (OS_EVENT *)0) {           /* No OS_EVENT left, give the ring back     */
+            OS_ENTER_CRITICAL();
+            pring->OSRingPtr = OSRingFreeList;
+            OSRingFreeList   = pring;
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_RING_DEPLETED;
+            return ((OS_RING *)0);
+        }
+    }
+#endif
+    pring->OSRingPtr       = (OS_RING *)0;
+    pring->OSRingBuf       = (INT8U *)pstorage;
+    pring->OSRingMask      = entries - 1;
+    pring->OSRingEntrySize = entry_size;
+    pring->OSRingShift     = shift;
+    pring->OSRingIn        = 0;
+    pring->OSRingOut       = 0;
+    pring->OSRingWait      = OS_FALSE;
+    pring->OSRingOvfCtr    = 0;
+    *perr                  = OS_ERR_NONE;
+    return (pring);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         DELETE A RING CHANNEL
+*
+* Description: This function deletes a ring channel.  The entries still in it are dropped.  Neither the
+*              producer nor the consumer may use the ring any more.
+*
+* Arguments  : pring  is a pointer to the ring.
+*
+*              perr   is a pointer to an error code and can be:
+*                     OS_ERR_NONE            the ring was deleted
+*                     OS_ERR_DEL_ISR         if called from an ISR
+*                     OS_ERR_RING_INVALID    if 'pring' is not a ring in use
+*                     OS_ERR_TASK_WAITING    if the consumer waits in OSRingPend()
+*
+* Returns    : NULL if the ring was deleted, else 'pring'.
+*
+* Note(s)    : Not available when the semaphore of OS_RING_OPT_PEND could not be deleted (OS_SEM_EN with
+*              OS_SEM_DEL_EN 0).
+*********************************************************************************************************
+*/
+
+#if (OS_SEM_EN == 0) || (OS_SEM_DEL_EN > 0)
+OS_RING  *OSRingDel (OS_RING *pring, INT8U *perr)
+{
+#if OS_SEM_EN > 0
+    INT8U      err;
+#endif
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (pring);
+    }
+    if (pring == (OS_RING *)0) {                           /* Validate 'pring'                         */
+        *perr = OS_ERR_RING_INVALID;
+        return (pring);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (pring);
+    }
+    if (pring->OSRingBuf == (INT8U *)0) {                  /* Ring already deleted or never created    */
+        *perr = OS_ERR_RING_INVALID;
+        return (pring);
+    }
+#if OS_SEM_EN > 0
+    if (pring->OSRingSem != (OS_EVENT *)0) {
+        (void)OSSemDel(pring->OSRingSem, OS_DEL_NO_PEND, &err);
+        if (err != OS_ERR_NONE) {                          /* The consumer sleeps on the semaphore     */
+            *perr = err;
+            return (pring);
+        }
+        pring->OSRingSem = (OS_EVENT *)0;
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    pring->OSRingBuf = (INT8U *)0;                         /* Return the ring to the free list         */
+    pring->OSRingPtr = OSRingFreeList;
+    OSRingFreeList   = pring;
+    OS_EXIT_CRITICAL();
+    *perr            = OS_ERR_NONE;
+    return ((OS_RING *)0);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      POST AN ENTRY TO A RING CHANNEL
+*
+* Description: This function copies an entry into the ring.  It does not disable interrupts unless it
+*              has to wake the consumer, and can be called from an ISR.
+*
+* Arguments  : pring  is a pointer to the ring.
+*
+*              pmsg   is a pointer to the entry, 'entry_size' bytes.
+*
+* Returns    : OS_ERR_NONE           the entry was copied
+*              OS_ERR_RING_FULL      the ring is full, the entry was dropped and counted in OSRingOvfCtr
+*              OS_ERR_RING_INVALID   if 'pring' is a NULL pointer
+*              OS_ERR_POST_NULL_PTR  if 'pmsg' is a NULL pointer
+*********************************************************************************************************
+*/
+
+INT8U  OSRingPost (OS_RING *pring, void *pmsg)
+{
+    INT32U  in;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pring == (OS_RING *)0) {                           /* Validate 'pring'                         */
+        return (OS_ERR_RING_INVALID);
+    }
+    if (pmsg == (void *)0) {                               /* Validate 'pmsg'                          */
+        return (OS_ERR_POST_NULL_PTR);
+    }
+#endif
+    in = pring->OSRingIn;
+    if ((in - pring->OSRingOut) > pring->OSRingMask) {     /* All entries are in use                   */
+        pring->OSRingOvfCtr++;
+        return (OS_ERR_RING_FULL);
+    }
+    OS_MemCopy(pring->OSRingBuf + ((in & pring->OSRingMask) << pring->OSRingShift),
+               (INT8U *)pmsg,
+               pring->OSRingEntrySize);
+    OS_CPU_BARRIER();                                      /* Entry written before it is published     */
+    pring->OSRingIn = in + 1;
+#if OS_SEM_EN > 0
+    OS_CPU_BARRIER();                                      /* Published before OSRingWait is read      */
+    if (pring->OSRingWait == OS_TRUE) {                    /* Consumer may be asleep on an empty ring  */
+        pring->OSRingWait = OS_FALSE;
+        (void)OSSemPost(pring->OSRingSem);
+    }
+#endif
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  TAKE AN ENTRY FROM A RING CHANNEL
+*
+* Description: This function copies the oldest entry out of the ring, without waiting.  It does not
+*              disable interrupts.
+*
+* Arguments  : pring  is a pointer to the ring.
+*
+*              pmsg   is a pointer to where the entry is copied, 'entry_size' bytes.
+*
+* Returns    : OS_ERR_NONE           an entry was copied
+*              OS_ERR_RING_EMPTY     the ring is empty
+*              OS_ERR_RING_INVALID   if 'pring' is a NULL pointer
+*              OS_ERR_PDATA_NULL     if 'pmsg' is a NULL pointer
+*********************************************************************************************************
+*/
+
+INT8U  OSRingAccept (OS_RING *pring, void *pmsg)
+{
+    INT32U  out;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pring == (OS_RING *)0) {                           /* Validate 'pring'                         */
+        return (OS_ERR_RING_INVALID);
+    }
+    if (pmsg == (void *)0) {                               /* Validate 'pmsg'                          */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    out = pring->OSRingOut;
+    if (pring->OSRingIn == out) {
+        return (OS_ERR_RING_EMPTY);
+    }
+    OS_CPU_BARRIER();                                      /* Entry read after it was published        */
+    OS_MemCopy((INT8U *)pmsg,
+               pring->OSRingBuf + ((out & pring->OSRingMask) << pring->OSRingShift),
+               pring->OSRingEntrySize);
+    OS_CPU_BARRIER();                                      /* Entry read before its slot is released   */
+    pring->OSRingOut = out + 1;
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  WAIT FOR AN ENTRY FROM A RING CHANNEL
+*
+* Description: This function copies the oldest entry out of the ring, waiting for one if the ring is
+*              empty.  The ring must have been created with OS_RING_OPT_PEND.
+*
+* Arguments  : pring    is a pointer to the ring.
+*
+*              pmsg     is a pointer to where the entry is copied, 'entry_size' bytes.
+*
+*              timeout  is an optional timeout period (in clock ticks).  If non-zero, your task will wait
+*                       for an entry up to the amount of time specified by this argument.  If you specify
+*                       0, however, your task will wait forever.
+*
+*              perr     is a pointer to an error code and can be:
+*                       OS_ERR_NONE          an entry was copied
+*                       OS_ERR_TIMEOUT       no entry was posted within 'timeout'
+*                       OS_ERR_PEND_ISR      if called from an ISR
+*                       OS_ERR_PEND_LOCKED   if called with the scheduler locked and the ring empty
+*                       OS_ERR_PEND_ABORT    the wait was aborted with OSSemPendAbort()
+*                       OS_ERR_RING_INVALID  if 'pring' is a NULL pointer
+*                       OS_ERR_RING_NO_PEND  if the ring was created without OS_RING_OPT_PEND
+*                       OS_ERR_PDATA_NULL    if 'pmsg' is a NULL pointer
+*
+* Returns    : none
+*
+* Note(s)    : 1) A post that finds OSRingWait raised just as the consumer found an entry by itself leaves
+*                 a stale count in the semaphore.  The count is drained after OSRingWait is raised and
+*                 before the ring is looked at a last time: an entry posted before the drain is found in
+*                 the ring, and one posted after it wakes the consumer.  A wait thus never returns on a
+*                 stale count and ends within 'timeout'.
+*********************************************************************************************************
+*/
+
+#if OS_SEM_EN > 0
+void  OSRingPend (OS_RING *pring, void *pmsg, INT16U timeout, INT8U *perr)
+{
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return;
+    }
+    if (pring == (OS_RING *)0) {                           /* Validate 'pring'                         */
+        *perr = OS_ERR_RING_INVALID;
+        return;
+    }
+    if (pmsg == (void *)0) {                               /* Validate 'pmsg'                          */
+        *perr = OS_ERR_PDATA_NULL;
+        return;
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_PEND_ISR;                           /* ... can't PEND from an ISR               */
+        return;
+    }
+    if (pring->OSRingSem == (OS_EVENT *)0) {
+        *perr = OS_ERR_RING_NO_PEND;
+        return;
+    }
+    for (;;) {
+        *perr = OSRingAccept(pring, pmsg);                 /* Fast path, no kernel call                */
+        if (*perr == OS_ERR_NONE) {
+            return;
+        }
+        pring->OSRingWait = OS_TRUE;                       /* From now on the producer wakes us ...    */
+        OS_CPU_BARRIER();
+        OS_ENTER_CRITICAL();                               /* ... drop a stale post (see Note #1) ...  */
+        pring->OSRingSem->OSEventCnt = 0;
+        OS_EXIT_CRITICAL();
+        OS_CPU_BARRIER();
+        if (pring->OSRingIn != pring->OSRingOut) {         /* ... but it may have posted just before   */
+            pring->OSRingWait = OS_FALSE;
+            continue;
+        }
+        OSSemPend(pring->OSRingSem, timeout, perr);
+        pring->OSRingWait = OS_FALSE;
+        if (*perr != OS_ERR_NONE) {                        /* Timed out, aborted or scheduler locked   */
+            if (OSRingAccept(pring, pmsg) == OS_ERR_NONE) {/* An entry may have come with the timeout  */
+                *perr = OS_ERR_NONE;
+            }
+            return;
+        }
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 NUMBER OF ENTRIES IN A RING CHANNEL
+*
+* Description: This function returns the number of entries posted and not yet taken.  Called by either
+*              side, it is a lower bound of what the consumer can take and of what the producer has
+*              posted.
+*
+* Arguments  : pring  is a pointer to the ring.
+*
+* Returns    : The number of entries, 0 if 'pring' is a NULL pointer.
+*********************************************************************************************************
+*/
+
+INT32U  OSRingEntries (OS_RING *pring)
+{
+#if OS_ARG_CHK_EN > 0
+    if (pring == (OS_RING *)0) {                           /* Validate 'pring'                         */
+        return (0);
+    }
+#endif
+    return (pring->OSRingIn - pring->OSRingOut);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    INITIALIZE THE RING CHANNELS
+*
+* Description: This function is called by OSInit() to chain the ring control blocks into the free list.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_RingInit (void)
+{
+    INT16U  i;
+
+
+    OS_MemClr((INT8U *)&OSRingTbl[0], sizeof(OSRingTbl));  /* Clear the ring table                     */
+    for (i = 0; i < (OS_MAX_RINGS - 1); i++) {             /* Init. list of free rings                 */
+        OSRingTbl[i].OSRingPtr = &OSRingTbl[i + 1];
+    }
+    OSRingTbl[OS_MAX_RINGS - 1].OSRingPtr = (OS_RING *)0;
+    OSRingFreeList = &OSRingTbl[0];
+}
+#endif                                                     /* OS_RING_EN                               */
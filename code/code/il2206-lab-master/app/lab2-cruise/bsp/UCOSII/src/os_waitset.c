@@ -0,0 +1,665 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                          WAIT-SET MANAGEMENT
+*
+* File    : OS_WAITSET.C
+* Version : V2.86
+*
+* A wait-set lets a task wait on several semaphores, mailboxes and queues at once, like OSEventPendMulti(),
+* but the events are registered with the set once instead of on every call.  Each member has a slot in
+* OSWaitSetTbl[] and a bit in the OSWaitSetRdy bitmap.  A post that leaves a message (or a count) in a
+* member, because no task waits on the member itself, sets the bit of the member and readies the tasks
+* waiting on the set.  OSWaitSetPend() then only visits the members whose bit is set, lowest slot first,
+* takes one message from each and clears the bit of the members it finds empty.  Neither the post nor the
+* wait links or unlinks the task in the wait lists of the members.
+*
+* A bit may be set for a member that is empty, when its message was taken with OSxxxAccept() or OSxxxPend()
+* instead of through the set.  OSWaitSetPend() clears such bits as it meets them.
+*
+* A member that is deleted with OSSemDel(), OSMboxDel() or OSQDel() leaves its set, as with
+* OSWaitSetRemove().
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  INT8U   OS_WaitSetBit  (INT32U bits);
+static  void    OS_WaitSetDrop (OS_WAITSET *pset, INT8U bit);
+static  INT16U  OS_WaitSetTake (OS_WAITSET *pset, OS_EVENT **pevents_rdy, void **pmsgs_rdy, INT16U max);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            CREATE A WAIT-SET
+*
+* Description: This function creates an empty wait-set.
+*
+* Arguments  : perr  is a pointer to an error code and can be:
+*                    OS_ERR_NONE              the wait-set was created
+*                    OS_ERR_CREATE_ISR        if called from an ISR
+*                    OS_ERR_WAITSET_DEPLETED  if there is no free wait-set or no free OS_EVENT
+*
+* Returns    : A pointer to the wait-set, or NULL on error.
+*********************************************************************************************************
+*/
+
+OS_WAITSET  *OSWaitSetCreate (INT8U *perr)
+{
+    OS_WAITSET  *pset;
+    OS_EVENT    *pevent;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR    cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((OS_WAITSET *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE from an ISR             */
+        return ((OS_WAITSET *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pset   = OSWaitSetFreeList;                            /* Get next free wait-set ...               */
+    pevent = OSEventFreeList;                              /* ... and an ECB for its waiting tasks     */
+    if ((pset == (OS_WAITSET *)0) || (pevent == (OS_EVENT *)0)) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_WAITSET_DEPLETED;
+        return ((OS_WAITSET *)0);
+    }
+    OSWaitSetFreeList = pset->OSWaitSetPtr;
+    OSEventFreeList   = (OS_EVENT *)pevent->OSEventPtr;
+    OS_EXIT_CRITICAL();
+    pevent->OSEventType    = OS_EVENT_TYPE_WAITSET;
+    pevent->OSEventCnt     = 0;
+    pevent->OSEventPtr     = (void *)pset;                 /* Back link to the wait-set                */
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                          /* Unknown name                             */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);                          /* No task waiting                          */
+    OS_MemClr((INT8U *)&pset->OSWaitSetTbl[0], sizeof(pset->OSWaitSetTbl));
+    pset->OSWaitSetPtr   = (OS_WAITSET *)0;
+    pset->OSWaitSetEvent = pevent;
+    pset->OSWaitSetRdy   = 0;
+    pset->OSWaitSetUsed  = 0;
+    *perr                = OS_ERR_NONE;
+    return (pset);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            DELETE A WAIT-SET
+*
+* Description: This function deletes a wait-set.  Its members are removed from it, they are not deleted.
+*
+* Arguments  : pset  is a pointer to the wait-set.
+*
+*              perr  is a pointer to an error code and can be:
+*                    OS_ERR_NONE              the wait-set was deleted
+*                    OS_ERR_DEL_ISR           if called from an ISR
+*                    OS_ERR_WAITSET_INVALID   if 'pset' is not a wait-set in use
+*                    OS_ERR_TASK_WAITING      if tasks wait in OSWaitSetPend()
+*
+* Returns    : NULL if the wait-set was deleted, else 'pset'.
+*********************************************************************************************************
+*/
+
+OS_WAITSET  *OSWaitSetDel (OS_WAITSET *pset, INT8U *perr)
+{
+    OS_EVENT    *pevent;
+    INT8U        bit;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR    cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (pset);
+    }
+    if (pset == (OS_WAITSET *)0) {                         /* Validate 'pset'                          */
+        *perr = OS_ERR_WAITSET_INVALID;
+        return (pset);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (pset);
+    }
+    OS_ENTER_CRITICAL();
+    pevent = pset->OSWaitSetEvent;
+    if (pevent == (OS_EVENT *)0) {                         /* Wait-set already deleted or never created */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_WAITSET_INVALID;
+        return (pset);
+    }
+    if (pevent->OSEventGrp != 0) {                         /* See if any task waits on the set         */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TASK_WAITING;
+        return (pset);
+    }
+    while (pset->OSWaitSetUsed != 0) {                     /* Remove every member                      */
+        bit = OS_WaitSetBit(pset->OSWaitSetUsed);
+        OS_WaitSetUnlink(pset->OSWaitSetTbl[bit]);
+    }
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                          /* Unknown name                             */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+    pevent->OSEventPtr     = OSEventFreeList;              /* Return Event Control Block to free list  */
+    OSEventFreeList        = pevent;
+    pset->OSWaitSetEvent   = (OS_EVENT *)0;                /* Return the wait-set to the free list     */
+    pset->OSWaitSetPtr     = OSWaitSetFreeList;
+    OSWaitSetFreeList      = pset;
+    OS_EXIT_CRITICAL();
+    *perr                  = OS_ERR_NONE;
+    return ((OS_WAITSET *)0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        ADD AN EVENT TO A WAIT-SET
+*
+* Description: This function makes a semaphore, mailbox or queue a member of the wait-set.  The member
+*              takes the lowest free slot; lower slots are served first by OSWaitSetPend().  A member that
+*              already holds a message is seen by the next OSWaitSetPend().
+*
+* Arguments  : pset    is a pointer to the wait-set.
+*
+*              pevent  is a pointer to the semaphore, mailbox or queue.
+*
+*              perr    is a pointer to an error code and can be:
+*                      OS_ERR_NONE              the event is a member of the set
+*                      OS_ERR_WAITSET_INVALID   if 'pset' is not a wait-set in use
+*                      OS_ERR_PEVENT_NULL       if 'pevent' is a NULL pointer
+*                      OS_ERR_EVENT_TYPE        if 'pevent' is not a semaphore, mailbox or queue
+*                      OS_ERR_WAITSET_MEMBER    if 'pevent' is already a member of a wait-set
+*                      OS_ERR_WAITSET_FULL      if the set has OS_WAITSET_SIZE members already
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OSWaitSetAdd (OS_WAITSET *pset, OS_EVENT *pevent, INT8U *perr)
+{
+    INT32U     avail;
+    INT8U      bit;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return;
+    }
+    if (pset == (OS_WAITSET *)0) {                         /* Validate 'pset'                          */
+        *perr = OS_ERR_WAITSET_INVALID;
+        return;
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return;
+    }
+#endif
+    switch (pevent->OSEventType) {                         /* Only what OS_WaitSetTake() can take      */
+#if OS_SEM_EN > 0
+        case OS_EVENT_TYPE_SEM:
+#endif
+#if OS_MBOX_EN > 0
+        case OS_EVENT_TYPE_MBOX:
+#endif
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+        case OS_EVENT_TYPE_Q:
+#endif
+             break;
+
+        default:
+             *perr = OS_ERR_EVENT_TYPE;
+             return;
+    }
+    OS_ENTER_CRITICAL();
+    if (pset->OSWaitSetEvent == (OS_EVENT *)0) {           /* Wait-set deleted or never created        */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_WAITSET_INVALID;
+        return;
+    }
+    if (pevent->OSEventWaitSet != (OS_WAITSET *)0) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_WAITSET_MEMBER;
+        return;
+    }
+    avail = ~pset->OSWaitSetUsed;
+#if OS_WAITSET_SIZE < 32
+    avail &= ((INT32U)1 << OS_WAITSET_SIZE) - 1;
+#endif
+    if (avail == 0) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_WAITSET_FULL;
+        return;
+    }
+    bit                       = OS_WaitSetBit(avail);      /* Lowest free slot                         */
+    pset->OSWaitSetTbl[bit]   = pevent;
+    pset->OSWaitSetUsed      |= (INT32U)1 << bit;
+    pset->OSWaitSetRdy       |= (INT32U)1 << bit;          /* Have the next wait look at it            */
+    pevent->OSEventWaitSet    = pset;
+    pevent->OSEventWaitSetBit = bit;
+    OS_EXIT_CRITICAL();
+    *perr                     = OS_ERR_NONE;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     REMOVE AN EVENT FROM A WAIT-SET
+*
+* Description: This function removes a member from its wait-set.  Messages it holds stay in it.
+*
+* Arguments  : pset    is a pointer to the wait-set.
+*
+*              pevent  is a pointer to the member.
+*
+*              perr    is a pointer to an error code and can be:
+*                      OS_ERR_NONE              the event is no longer a member
+*                      OS_ERR_WAITSET_INVALID   if 'pset' is a NULL pointer
+*                      OS_ERR_PEVENT_NULL       if 'pevent' is a NULL pointer
+*                      OS_ERR_WAITSET_MEMBER    if 'pevent' is not a member of 'pset'
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OSWaitSetRemove (OS_WAITSET *pset, OS_EVENT *pevent, INT8U *perr)
+{
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return;
+    }
+    if (pset == (OS_WAITSET *)0) {                         /* Validate 'pset'                          */
+        *perr = OS_ERR_WAITSET_INVALID;
+        return;
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return;
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventWaitSet != pset) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_WAITSET_MEMBER;
+        return;
+    }
+    OS_WaitSetUnlink(pevent);
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           WAIT ON A WAIT-SET
+*
+* Description: This function takes one message from each member of the wait-set that has one, up to 'max'
+*              members, lowest slot first.  If no member has a message, it waits for one to be posted.
+*
+* Arguments  : pset         is a pointer to the wait-set.
+*
+*              pevents_rdy  is a pointer to an array of at least 'max' entries, where the members that had a
+*                           message are returned.
+*
+*              pmsgs_rdy    is a pointer to an array of at least 'max' entries, where the message taken
+*                           from each of them is returned: a NULL pointer for a semaphore, the message of a
+*                           mailbox or queue.
+*
+*              max          is the largest number of members to take a message from.
+*
+*              timeout      is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                           wait for a message up to the amount of time specified by this argument.  If you
+*                           specify 0, however, your task will wait forever.
+*
+*              perr         is a pointer to an error code and can be:
+*                           OS_ERR_NONE              messages were taken
+*                           OS_ERR_TIMEOUT           no message was posted within 'timeout'
+*                           OS_ERR_PEND_ISR          if called from an ISR
+*                           OS_ERR_PEND_LOCKED       if called with the scheduler locked and no message
+*                           OS_ERR_WAITSET_INVALID   if 'pset' is a NULL pointer
+*                           OS_ERR_PDATA_NULL        if 'pevents_rdy' or 'pmsgs_rdy' is a NULL pointer
+*
+* Returns    : The number of messages taken, 0 on error.
+*
+* Note(s)    : 1) The cost does not depend on the number of members: one bit scan per member that has a
+*                 message (or had one), and a single wait on the OS_EVENT of the set.
+*
+*              2) A wait-set should have a single task waiting on it.  Should several tasks wait, they are
+*                 all readied by a post and those that find nothing left return OS_ERR_TIMEOUT.
+*********************************************************************************************************
+*/
+
+INT16U  OSWaitSetPend (OS_WAITSET *pset, OS_EVENT **pevents_rdy, void **pmsgs_rdy, INT16U max,
+                       INT16U timeout, INT8U *perr)
+{
+    OS_EVENT  *pevent;
+    INT16U     n;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (0);
+    }
+    if (pset == (OS_WAITSET *)0) {                         /* Validate 'pset'                          */
+        *perr = OS_ERR_WAITSET_INVALID;
+        return (0);
+    }
+    if ((pevents_rdy == (OS_EVENT **)0) || (pmsgs_rdy == (void **)0)) {
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_PEND_ISR;                           /* ... can't PEND from an ISR               */
+        return (0);
+    }
+    *perr  = OS_ERR_NONE;
+    pevent = pset->OSWaitSetEvent;
+    OS_ENTER_CRITICAL();
+    n = OS_WaitSetTake(pset, pevents_rdy, pmsgs_rdy, max);
+    if ((n == 0) && (max > 0)) {                           /* Nothing posted, must wait                */
+        if (OSLockNesting > 0) {                           /* See if called with scheduler locked ...  */
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_PEND_LOCKED;                    /* ... can't PEND when locked               */
+            return (0);
+        }
+        OSTCBCur->OSTCBStat     |= OS_STAT_WAITSET;        /* Pend on the wait-set                     */
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+        OSTCBCur->OSTCBDly       = timeout;                /* Store pend timeout in TCB                */
+#if OS_TICK_LIST_EN > 0
+        OS_TickListInsert(OSTCBCur);                       /* Link TCB into the tick list              */
+#endif
+        OS_EventTaskWait(pevent);                          /* Suspend task until posted or timeout     */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                        /* Find next highest priority task ready    */
+        OS_ENTER_CRITICAL();
+        if (OSTCBCur->OSTCBStatPend != OS_STAT_PEND_OK) {  /* See if we timed-out or aborted           */
+            OS_EventTaskRemove(OSTCBCur, pevent);
+        }
+        OSTCBCur->OSTCBStat          =  OS_STAT_RDY;       /* Set   task  status to ready              */
+        OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;   /* Clear pend  status                       */
+        OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;     /* Clear event pointers                     */
+#if (OS_EVENT_MULTI_EN > 0)
+        OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+        n = OS_WaitSetTake(pset, pevents_rdy, pmsgs_rdy, max);  /* A post at the timeout counts too  */
+        if (n == 0) {
+            *perr = OS_ERR_TIMEOUT;                        /* Indicate that nothing came within TO     */
+        }
+    }
+    OS_EXIT_CRITICAL();
+    return (n);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     SIGNAL A MESSAGE TO A WAIT-SET
+*
+* Description: This function is called by the post functions when they leave a message (or a count) in a
+*              member of a wait-set.  It marks the member ready and readies the tasks waiting on the set.
+*
+* Arguments  : pevent  is a pointer to the member.
+*
+* Returns    : OS_TRUE   if tasks were made ready; the caller should call OS_Sched() once interrupts are
+*                        enabled again
+*              OS_FALSE  otherwise
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+BOOLEAN  OS_WaitSetSignal (OS_EVENT *pevent)
+{
+    OS_WAITSET  *pset;
+    OS_EVENT    *pwait;
+
+
+    pset                = pevent->OSEventWaitSet;
+    pset->OSWaitSetRdy |= (INT32U)1 << pevent->OSEventWaitSetBit;
+    pwait               = pset->OSWaitSetEvent;
+    if (pwait->OSEventGrp == 0) {                          /* Nobody waits on the set                  */
+        return (OS_FALSE);
+    }
+    while (pwait->OSEventGrp != 0) {                       /* Ready ALL tasks waiting on the set       */
+        (void)OS_EventTaskRdy(pwait, (void *)0, OS_STAT_WAITSET, OS_STAT_PEND_OK);
+    }
+    return (OS_TRUE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    REMOVE AN EVENT FROM ITS WAIT-SET
+*
+* Description: This function is called by OSWaitSetRemove(), OSWaitSetDel() and when a member is deleted,
+*              by OSSemDel(), OSMboxDel() and OSQDel(), to free the slot of the member in its wait-set.
+*
+* Arguments  : pevent  is a pointer to the member.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_WaitSetUnlink (OS_EVENT *pevent)
+{
+    OS_WaitSetDrop(pevent->OSEventWaitSet, pevent->OSEventWaitSetBit);
+    pevent->OSEventWaitSet = (OS_WAITSET *)0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  TAKE MESSAGES FROM THE READY MEMBERS
+*
+* Description: This function takes one message from each member whose bit is set in OSWaitSetRdy, lowest
+*              slot first, up to 'max' members.  The bit of a member is cleared once it is empty.
+*
+* Arguments  : pset         is a pointer to the wait-set.
+*
+*              pevents_rdy  is where the members that had a message are returned.
+*
+*              pmsgs_rdy    is where their messages are returned.
+*
+*              max          is the largest number of members to take a message from.
+*
+* Returns    : The number of messages taken.
+*
+* Note(s)    : Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  INT16U  OS_WaitSetTake (OS_WAITSET *pset, OS_EVENT **pevents_rdy, void **pmsgs_rdy, INT16U max)
+{
+    OS_EVENT  *pevent;
+    INT32U     bits;
+    INT16U     n;
+    INT8U      bit;
+    void      *pmsg;
+    BOOLEAN    taken;
+    BOOLEAN    more;
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+    OS_Q      *pq;
+#endif
+
+
+    n    = 0;
+    bits = pset->OSWaitSetRdy;
+    while ((bits != 0) && (n < max)) {
+        bit     = OS_WaitSetBit(bits);
+        bits   &= bits - 1;                                /* Next member, in slot order               */
+        pevent  = pset->OSWaitSetTbl[bit];
+        pmsg    = (void *)0;
+        taken   = OS_FALSE;
+        more    = OS_FALSE;
+        switch (pevent->OSEventType) {
+#if OS_SEM_EN > 0
+            case OS_EVENT_TYPE_SEM:
+                 if (pevent->OSEventCnt > 0) {
+                     pevent->OSEventCnt--;
+                     taken = OS_TRUE;
+                 }
+                 more = (BOOLEAN)(pevent->OSEventCnt > 0);
+                 break;
+#endif
+
+#if OS_MBOX_EN > 0
+            case OS_EVENT_TYPE_MBOX:
+                 pmsg               = pevent->OSEventPtr;
+                 pevent->OSEventPtr = (void *)0;
+                 taken              = (BOOLEAN)(pmsg != (void *)0);
+                 break;
+#endif
+
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+            case OS_EVENT_TYPE_Q:
+                 pq = (OS_Q *)pevent->OSEventPtr;
+                 if (pq->OSQEntries > 0) {
+                     pmsg = *pq->OSQOut++;                 /* Extract oldest message from the queue    */
+                     pq->OSQEntries--;
+                     if (pq->OSQOut == pq->OSQEnd) {       /* Wrap OUT pointer if we are at the end    */
+                         pq->OSQOut = pq->OSQStart;
+                     }
+                     taken = OS_TRUE;
+                 }
+                 more = (BOOLEAN)(pq->OSQEntries > 0);
+                 break;
+#endif
+
+            default:
+                 break;
+        }
+        if (more == OS_FALSE) {                            /* Member empty, forget it until posted to  */
+            pset->OSWaitSetRdy &= ~((INT32U)1 << bit);
+        }
+        if (taken == OS_TRUE) {
+            pevents_rdy[n] = pevent;
+            pmsgs_rdy[n]   = pmsg;
+            n++;
+        }
+    }
+    return (n);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        FREE A SLOT OF A WAIT-SET
+*
+* Description: This function frees slot 'bit' of the wait-set.  Interrupts are assumed to be disabled.
+*
+* Arguments  : pset  is a pointer to the wait-set.
+*
+*              bit   is the slot.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_WaitSetDrop (OS_WAITSET *pset, INT8U bit)
+{
+    pset->OSWaitSetUsed     &= ~((INT32U)1 << bit);
+    pset->OSWaitSetRdy      &= ~((INT32U)1 << bit);
+    pset->OSWaitSetTbl[bit]  = (OS_EVENT *)0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     FIND LOWEST BIT SET IN A BITMAP
+*
+* Description: This function returns the position of the lowest bit set in 'bits', which must not be 0.
+*
+* Arguments  : bits  is a bitmap of slots.
+*
+* Returns    : the position of the lowest bit set (0..31).
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_WaitSetBit (INT32U bits)
+{
+#if OS_SCHED_BITMAP_EN > 0
+    return (OS_BitScan(bits));
+#else
+    if ((bits & 0x0000FFFFuL) != 0) {
+        if ((bits & 0x000000FFuL) != 0) {
+            return (OSUnMapTbl[bits & 0xFF]);
+        }
+        return ((INT8U)(OSUnMapTbl[(bits >> 8) & 0xFF] + 8));
+    }
+    if ((bits & 0x00FF0000uL) != 0) {
+        return ((INT8U)(OSUnMapTbl[(bits >> 16) & 0xFF] + 16));
+    }
+    return ((INT8U)(OSUnMapTbl[(bits >> 24) & 0xFF] + 24));
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        INITIALIZE THE WAIT-SETS
+*
+* Description: This function is called by OSInit() to chain the wait-set control blocks into the free list.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_WaitSetInit (void)
+{
+    INT16U  i;
+
+
+    OS_MemClr((INT8U *)&OSWaitSetTbl[0], sizeof(OSWaitSetTbl));   /* Clear the wait-set table        */
+    for (i = 0; i < (OS_MAX_WAITSETS - 1); i++) {                  /* Init. list of free wait-sets    */
+        OSWaitSetTbl[i].OSWaitSetPtr = &OSWaitSetTbl[i + 1];
+    }
+    OSWaitSetTbl[OS_MAX_WAITSETS - 1].OSWaitSetPtr = (OS_WAITSET *)0;
+    OSWaitSetFreeList = &OSWaitSetTbl[0];
+}
+#endif                                                     /* OS_WAITSET_EN                            */
@@ -33,7 +33,9 @@
 #include <string.h>
 
 #include "system.h"
+#include "sys/alt_irq.h"
 #include "sys/alt_timestamp.h"
+#include "sys/alt_hrtimer.h"
 
 #include "altera_avalon_timer.h"
 #include "altera_avalon_timer_regs.h"
@@ -47,6 +49,25 @@
 
 #if (ALT_TIMESTAMP_CLK_BASE != none_BASE) 
 
+#if defined(ALT_HRTIMER) && (ALT_TIMESTAMP_CLK_BASE == ALT_HRTIMER_TIMER_BASE)
+#error "The timestamp timer is used by alt_hrtimer, take the time from alt_hrtimer_now()"
+#endif
+
+/*
+ * A 32-bit timer with its interrupt connected is run in continuous mode, and
+ * its ISR counts the roll-overs in "altera_avalon_timer_ts_hi", the upper half
+ * of alt_timestamp64(). This costs one interrupt every 2^32 timer cycles.
+ */
+
+static volatile alt_u32 altera_avalon_timer_ts_hi;
+static alt_u8           altera_avalon_timer_ts_extended;
+
+static void altera_avalon_timer_ts_irq_handler (void* context)
+{
+  IOWR_ALTERA_AVALON_TIMER_STATUS (altera_avalon_timer_ts_base, 0);
+  altera_avalon_timer_ts_hi++;
+}
+
 /*
  * The function alt_timestamp_start() can be called at application level to
  * initialise the timestamp facility. In this case the period register is
@@ -54,8 +75,9 @@
  * the period register may not be writable, depending on the hardware 
  * configuration, in which case this function does not reset the period.
  *
- * The timer is not run in continuous mode, so that the user can detect timer
- * roll-over, i.e. alt_timestamp() returns 0.
+ * Unless its roll-overs are counted (see above), the timer is not run in
+ * continuous mode, so that the user can detect timer roll-over, i.e.
+ * alt_timestamp() returns 0.
  *
  * The return value of this function is 0 upon sucess and -1 if in timestamp
  * device has not been registered. 
@@ -64,11 +86,33 @@
 int alt_timestamp_start(void)
 {
   void* base = altera_avalon_timer_ts_base;
+  alt_irq_context context;
 
   if (!altera_avalon_timer_ts_freq)
   {
     return -1;
   }
+  else if ((ALT_TIMESTAMP_COUNTER_SIZE != 64) &&
+           (altera_avalon_timer_ts_irq != ALT_IRQ_NOT_CONNECTED))
+  {
+    context = alt_irq_disable_all ();
+    IOWR_ALTERA_AVALON_TIMER_CONTROL (base,ALTERA_AVALON_TIMER_CONTROL_STOP_MSK);
+    IOWR_ALTERA_AVALON_TIMER_PERIODL (base, 0xFFFF);
+    IOWR_ALTERA_AVALON_TIMER_PERIODH (base, 0xFFFF);
+    IOWR_ALTERA_AVALON_TIMER_STATUS (base, 0);
+    altera_avalon_timer_ts_hi = 0;
+    if (!altera_avalon_timer_ts_extended)
+    {
+      alt_ic_isr_register (altera_avalon_timer_ts_irq_controller_id,
+                           altera_avalon_timer_ts_irq,
+                           altera_avalon_timer_ts_irq_handler, NULL, NULL);
+      altera_avalon_timer_ts_extended = 1;
+    }
+    IOWR_ALTERA_AVALON_TIMER_CONTROL (base, ALTERA_AVALON_TIMER_CONTROL_ITO_MSK  |
+                                            ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+                                            ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+    alt_irq_enable_all (context);
+  }
   else
   {
     if(ALT_TIMESTAMP_COUNTER_SIZE == 64) {
@@ -91,7 +135,7 @@ int alt_timestamp_start(void)
 /*
  * alt_timestamp() returns the current timestamp count. In the event that
  * the timer has run full period, or there is no timestamp available, this
- * function return -1.
+ * function return -1. A timer in continuous mode wraps to 0 instead.
  *
  * The returned timestamp counts up from the last time the period register
  * was reset. 
@@ -130,6 +174,59 @@ alt_timestamp_type alt_timestamp(void)
   }
 }
 
+/*
+ * alt_timestamp64() adds the upper half counted by the ISR to alt_timestamp().
+ * The interrupts are disabled so that the ISR cannot run between the two
+ * reads; a roll-over which it has yet to count is counted here.
+ */
+
+alt_u64 alt_timestamp64(void)
+{
+  void* base = altera_avalon_timer_ts_base;
+  alt_irq_context context;
+  alt_u32 hi;
+  alt_u32 lo;
+
+  if (!altera_avalon_timer_ts_extended)
+  {
+    return alt_timestamp ();
+  }
+
+  context = alt_irq_disable_all ();
+  hi = altera_avalon_timer_ts_hi;
+  lo = alt_timestamp ();
+  if (IORD_ALTERA_AVALON_TIMER_STATUS (base) & ALTERA_AVALON_TIMER_STATUS_TO_MSK)
+  {
+    hi++;
+    lo = alt_timestamp ();
+  }
+  alt_irq_enable_all (context);
+
+  return ((alt_u64) hi << 32) | lo;
+}
+
+/*
+ * alt_timestamp_ns() converts alt_timestamp64() to nanoseconds. When the
+ * timer period is a whole number of nanoseconds, as 20 ns at 50 MHz, this is
+ * a single multiplication; otherwise it takes two 64-bit divisions.
+ */
+
+alt_u64 alt_timestamp_ns(void)
+{
+#if (1000000000 % ALT_TIMESTAMP_CLK_FREQ) == 0
+  return alt_timestamp64 () * (1000000000 / ALT_TIMESTAMP_CLK_FREQ);
+#else
+  alt_u64 cycles = alt_timestamp64 ();
+  alt_u32 freq   = altera_avalon_timer_ts_freq;
+
+  if (!freq)
+  {
+    return 0;
+  }
+  return (cycles / freq) * 1000000000 + (cycles % freq) * 1000000000 / freq;
+#endif
+}
+
 /*
  * Return the number of timestamp ticks per second. This will be 0 if no
  * timestamp device has been registered.
@@ -37,6 +37,15 @@
 
 #define HW_TIMER_PERIOD 100 /* 100ms */
 
+/* The periodic tasks are released by one timer group that only posts
+ * semaphores, so it can run straight from alarm_handler() instead of from
+ * the timer task */
+#if OS_TMR_ISR_CALLBACK_EN > 0
+#define TMR_GRP_OPT OS_TMR_OPT_ISR_CALLBACK
+#else
+#define TMR_GRP_OPT OS_TMR_OPT_NONE
+#endif
+
 #define TURN_OFF 0x00
 /* Button Patterns */
 
@@ -117,20 +126,36 @@ OS_STK Watchdog_Stack[TASK_STACKSIZE];
 #define BUTTONIO_PERIOD 300
 #define OVERLOAD_PERIOD 300
 
+#if VEHICLE_PERIOD != CONTROL_PERIOD || SWITCHIO_PERIOD != CONTROL_PERIOD || \
+    BUTTONIO_PERIOD != CONTROL_PERIOD || OVERLOAD_PERIOD != CONTROL_PERIOD
+#error "The periodic tasks are released by one timer group and need the same period"
+#endif
+
+// Release times in the period, in ms, multiples of HW_TIMER_PERIOD.
+// The inputs are sampled first, the vehicle is simulated on them 100 ms
+// later and the throttle is computed from its new velocity after another
+// 100 ms, so the three are not all released in the same tick. The overload
+// tasks run from the start, the extra load spanning part of the period.
+
+#define SWITCHIO_PHASE 0
+#define BUTTONIO_PHASE 0
+#define VEHICLE_PHASE  100
+#define CONTROL_PHASE  200
+#define OVERLOAD_PHASE 0
+
 /*
  * Definition of Kernel Objects 
  */
 
-// Mailboxes
-OS_EVENT *Mbox_Throttle;  //control task -> vehicle task
-OS_EVENT *Mbox_Velocity;  //vehicle task -> control task; control task -> button task
-OS_EVENT *Mbox_Brake;     //button task -> vehicle task
-OS_EVENT *Mbox_Engine_to_vehicle;    //switch task -> vehicle task; 
-OS_EVENT *Mbox_Engine_to_control;    //switch task -> control task
-OS_EVENT *Mbox_Cruise;    //button task -> control task
-OS_EVENT *Mbox_Top_gear;  //switch task -> control task
-OS_EVENT *Mbox_Gas_pedel; //button task -> control task
-OS_EVENT *Mbox_WatchDog; // overloadDetection Task -> WatchDog Task
+// State ports: each holds the latest value of a signal, readers sample it
+OS_PORT *Port_Throttle;  //control task -> vehicle task
+OS_PORT *Port_Velocity;  //vehicle task -> control task (control task waits on it)
+OS_PORT *Port_Brake;     //button task -> vehicle task
+OS_PORT *Port_Engine;    //switch task -> vehicle task, control task
+OS_PORT *Port_Cruise;    //button task -> control task
+OS_PORT *Port_Top_gear;  //switch task -> control task
+OS_PORT *Port_Gas_pedel; //button task -> control task
+OS_PORT *Port_WatchDog;  // overloadDetection Task -> WatchDog Task
 
 // Semaphores
 OS_EVENT *CONTROLTmrSem;
@@ -142,12 +167,8 @@ OS_EVENT *OverloadDetectionSem;
 OS_EVENT *WatchdogSem;
 OS_EVENT *ExtraLoadSem;
 
-// SW-Timer
-OS_TMR *CONTROLTmr;
-OS_TMR *VEHICLETmr;
-OS_TMR *SWITCHIOTmr;
-OS_TMR *BUTTONIOTmr;
-OS_TMR *OverloadTmr;
+// SW-Timer group releasing all the periodic tasks
+OS_TMR_GRP *PeriodicGrp;
 
 // pid controller init
 void PID_init(PID_t* pid){
@@ -179,41 +200,6 @@ pid->error[0] = pid->cur_error;
 if(pid->output > pid->output_max) pid->output = pid->output_max;
 if(pid->output < -pid->output_max) pid->output = -pid->output_max;
 }
-/* Timer Callback Functions*/
-void CONTROLTmrCallback(void *ptmr, void *callback_arg){
-  OSSemPost(CONTROLTmrSem);
-  if(DEBUG){
-  printf("OSSemPost(CONTROLSem);\n");
-  }
-}
-
-void VEHICLETmrCallback(void *ptmr, void *callback_arg){
-  OSSemPost(VEHICLETmrSem);
-  if(DEBUG){
-  printf("OSSemPost(VEHICLESem);\n");
-  }
-}
-
-void SWITCHIOTmrCallback(void *ptmr, void *callback_arg){
-  OSSemPost(SwitchIOSem);
-  if(DEBUG){
-  printf("OSSemPost(SWITCHIOSem);\n");
-  }
-}
-
-void BUTTONIOTmrCallback(void *ptmr, void *callback_arg){
-  OSSemPost(ButtonIOSem);
-  if(DEBUG){
-  printf("OSSemPost(BUTTONIOSem);\n");
-  }
-}
-
-void OverloadTmrCallbask(void *ptmr, void *callback_arg){
-
-OSSemPost(WatchdogSem);
-OSSemPost(ExtraLoadSem);
-OSSemPost(OverloadDetectionSem);
-}
 /*
  * Types
  */
@@ -248,7 +234,11 @@ int switches_pressed(void)
  */
 alt_u32 alarm_handler(void* context)
 {
+#if OS_ISR_DEFER_EN > 0
+  OSIntDefer(OS_DEFER_TMR_SIGNAL, (void *)0, 1); /* Signal made by the defer task */
+#else
   OSTmrSignal(); /* Signals a 'tick' to the SW timers */
+#endif
 
   return delay;
 }
@@ -372,8 +362,7 @@ void VehicleTask(void* pdata)
   const unsigned int gravity_factor = 2;
   // variables relevant to the model and its simulation on top of the RTOS
   INT8U err;  
-  void* msg;
-  INT8U* throttle; 
+  INT8U throttle = 0; 
   INT16S acceleration;  
   INT16U position = 0; 
   INT16S velocity = 0; 
@@ -384,46 +373,27 @@ void VehicleTask(void* pdata)
 
   while(1)
   {
-    err = OSMboxPost(Mbox_Velocity, (void *) &velocity);
+    OSPortWrite(Port_Velocity, &velocity);
 
     OSSemPend(VEHICLETmrSem, 0, &err);
 
-    /* Non-blocking read of mailbox: 
-       - message in mailbox: update throttle
-       - no message:         use old throttle
-       */
+    /* Non-blocking read of the latest values:
+       the port keeps the last one written, so there is nothing to drain
+       and the old value stays until the writer replaces it */
 
     // from: control task
-    msg = OSMboxPend(Mbox_Throttle, 1, &err); 
-    if (err == OS_NO_ERR) {
-      throttle = (INT8U*) msg;
-      if(MBOX_DEBUG){
-        printf("Throttle_msg recieve! \n");
-    }
-    }
+    OSPortRead(Port_Throttle, &throttle);
 
     /* Same for the brake signal that bypass the control law
     from buttonIOtask */
-    msg = OSMboxPend(Mbox_Brake, 1, &err); 
-    if (err == OS_NO_ERR) {
-      if(MBOX_DEBUG){
-        printf("brake_msg recieve! \n");
-    }
-      brake_pedal = *(enum active*) msg;
-    }
+    OSPortRead(Port_Brake, &brake_pedal);
 
     /* Same for the engine signal that bypass the control law 
     from switchIOtask*/
-    msg = OSMboxPend(Mbox_Engine_to_vehicle, 1, &err); 
-    if (err == OS_NO_ERR) {
-      if(MBOX_DEBUG){
-        printf("engine_msg recieve! \n");
-    }
-      engine = *(enum active*)msg;
-    }
+    OSPortRead(Port_Engine, &engine);
 
     // vehichle cannot effort more than 80 units of throttle
-    if (*throttle > 80) *throttle = 80;
+    if (throttle > 80) throttle = 80;
 
     // brakes + wind
     if (brake_pedal == off)
@@ -432,7 +402,7 @@ void VehicleTask(void* pdata)
       acceleration = - wind_factor*velocity;
       // actuate with engines
       if (engine == on)
-        acceleration += (*throttle);
+        acceleration += throttle;
 
       // gravity effects
       if (400 <= position && position < 800)
@@ -454,7 +424,7 @@ void VehicleTask(void* pdata)
     printf("Position: %d m\n", position);
     printf("Velocity: %d m/s\n", velocity);
     printf("Accell: %d m/s2\n", acceleration);
-    printf("Throttle: %d V\n", *throttle);
+    printf("Throttle: %d V\n", throttle);
     printf("\n");
     }
     if(STATUS_DEBUG)
@@ -478,8 +448,7 @@ void ControlTask(void* pdata)
 {
   INT8U err;
   INT8U throttle = 0; /* Value between 0 and 80, which is interpreted as between 0.0V and 8.0V */
-  void* msg;
-  INT16S* velocity_recv;
+  INT32U velocity_ver = 0;
   INT16S current_velocity;
   INT16S target_velocity;
   PID_t PID;
@@ -495,9 +464,8 @@ void ControlTask(void* pdata)
 
   while(1)
   {
-  //   // get current_velocity from Mbox_Velocity
-    velocity_recv = (INT16S*)OSMboxPend(Mbox_Velocity, 0, &err);
-    current_velocity =  *velocity_recv;
+  //   // wait for a current_velocity newer than the last one from Port_Velocity
+    velocity_ver = OSPortPend(Port_Velocity, &current_velocity, velocity_ver, 0, &err);
 
   //   // Here you can use whatever technique or algorithm that you prefer to control
   //   // the velocity via the throttle. There are no right and wrong answer to this controller, so
@@ -510,43 +478,19 @@ void ControlTask(void* pdata)
   //   //
   //   // If your control algorithm/technique needs them in order to function. 
     
-     /* Non-blocking read of mailbox: */
+     /* Non-blocking read of the latest values: */
 
     /* engine signal from switchIOtask */
-    msg = OSMboxPend(Mbox_Engine_to_control, 1, &err); 
-    if (err == OS_NO_ERR) {
-      if(MBOX_DEBUG){
-        printf("engine_msg recieve! \n");
-    }
-      ENGINE_status = *(enum active*)msg;
-    }
+    OSPortRead(Port_Engine, &ENGINE_status);
 
     //* cruise signal from buttonIOtask */
-    msg = OSMboxPend(Mbox_Cruise, 1, &err); 
-    if (err == OS_NO_ERR) {
-      if(MBOX_DEBUG){
-        printf("cruise_msg recieve! \n");
-    }
-      CRUISE_CONTROL_status = *(enum active*)msg;
-    }
+    OSPortRead(Port_Cruise, &CRUISE_CONTROL_status);
     
     //* gas_pedel signal from buttonIOtask */
-    msg = OSMboxPend(Mbox_Gas_pedel, 1, &err); 
-    if (err == OS_NO_ERR) {
-      if(MBOX_DEBUG){
-        printf("gas_pedel_msg recieve! \n");
-    }
-      GAS_PEDAL_status = *(enum active*)msg;
-    }
+    OSPortRead(Port_Gas_pedel, &GAS_PEDAL_status);
 
     //* top_gear signal from switchIOtask */
-    msg = OSMboxPend(Mbox_Top_gear, 1, &err); 
-    if (err == OS_NO_ERR){
-      if(MBOX_DEBUG){
-        printf("Top_gear_msg recieve! \n");
-    }
-      TOP_GEAR_status = *(enum active*)msg;
-    }
+    OSPortRead(Port_Top_gear, &TOP_GEAR_status);
 
     // debug for mbox
     if(STATUS_DEBUG){
@@ -610,8 +554,8 @@ void ControlTask(void* pdata)
     }
 
     // printf("current velocity: %d \t throttle value: %d \n",current_velocity, throttle);
-    err = OSMboxPost(Mbox_Throttle, (void *) &throttle);
-    OSSemPend(CONTROLTmr, 0, &err); 
+    OSPortWrite(Port_Throttle, &throttle);
+    OSSemPend(CONTROLTmrSem, 0, &err);
   }
 }
 
@@ -673,22 +617,15 @@ void SwitchIOTask(void* pdata){
 /*-----------------------------------------------------------------------------------------------------------*/
 /*-----------------------------------------------------------------------------------------------------------*/
 
-    // put engine signal into Mbox_engine_vehicle
-    err = OSMboxPost(Mbox_Engine_to_vehicle, (void*)&ENGINE_status);
+    // put engine signal into Port_Engine, for the vehicle and the control task
+    err = OSPortWrite(Port_Engine, &ENGINE_status);
     if(MBOX_DEBUG){
-      if(err == OS_NO_ERR){ // successfully
-        printf("engine_to_vehicle_msg post! \n");
+      if(err == OS_ERR_NONE){ // successfully
+        printf("engine_msg post! \n");
     }
     }
-    // put engine signal into Mbox_engine_control
-    err = OSMboxPost(Mbox_Engine_to_control, (void*)&ENGINE_status);
-    if(MBOX_DEBUG){
-      if(err == OS_NO_ERR){ // successfully
-        printf("engine__to_control_msg post! \n");
-    }
-    }
-    // put TOP_gear signal into Mbox_top_gear
-    err = OSMboxPost(Mbox_Top_gear, (void*)&TOP_GEAR_status);
+    // put TOP_gear signal into Port_Top_gear
+    err = OSPortWrite(Port_Top_gear, &TOP_GEAR_status);
     if(MBOX_DEBUG){
       if(err == OS_NO_ERR){ // successfully
         printf("TOP_gear_msg post! \n");
@@ -767,22 +704,22 @@ void ButtonIOTask(void* pdata){
 /*-----------------------------------------------------------------------------------------------------------*/
 /*-----------------------------------------------------------------------------------------------------------*/
 
-     // put cruise control signal into Mbox_Cruise
-    err = OSMboxPost(Mbox_Cruise, (void*)&CRUISE_CONTROL_status);
+     // put cruise control signal into Port_Cruise
+    err = OSPortWrite(Port_Cruise, &CRUISE_CONTROL_status);
     if(MBOX_DEBUG){
       if(err == OS_NO_ERR){ // successfully
         printf("cruise_msg post! \n");
     }
     }
-    // put TOP_gear signal into Mbox_Brake
-    err = OSMboxPost(Mbox_Brake, (void*)&BRAKE_PEDAL_status);
+    // put brake signal into Port_Brake
+    err = OSPortWrite(Port_Brake, &BRAKE_PEDAL_status);
     if(MBOX_DEBUG){
       if(err == OS_NO_ERR){ // successfully
         printf("brake_msg post! \n");
     }
     }
-    // put gas_padel signal into Mbox_Brake
-    err = OSMboxPost(Mbox_Gas_pedel, (void*)&GAS_PEDAL_status);
+    // put gas_padel signal into Port_Gas_pedel
+    err = OSPortWrite(Port_Gas_pedel, &GAS_PEDAL_status);
     if(MBOX_DEBUG){
       if(err == OS_NO_ERR){ // successfully
         printf("gas_pedel_msg post! \n");
@@ -795,7 +732,8 @@ void ButtonIOTask(void* pdata){
 
 void WatchDogTask(void* pdata){
 INT8U err;
-void* msg;
+INT32U ver;
+INT32U last_ver = 0;
 enum watchdog Watchdog_status = feeddog;
 
   printf("Watchdog created \n");
@@ -803,12 +741,14 @@ enum watchdog Watchdog_status = feeddog;
   while (1)
   {
    
-     /* Non-blocking read of mailbox: */
-    msg = OSMboxPend(Mbox_WatchDog, 1, &err); 
-    if (err == OS_NO_ERR) {
-      // if(WATCHDOH_DEBUG) printf("watch_dog_msg recieve! \n");
-      Watchdog_status = *(enum active*)msg;
+     /* Non-blocking read of the port: the dog was fed if its version
+        moved since the last check */
+    ver = OSPortRead(Port_WatchDog, &Watchdog_status);
+    if (ver == last_ver) {
+      // if(WATCHDOH_DEBUG) printf("watch_dog_msg missing! \n");
+      Watchdog_status = wait;
     }
+    last_ver = ver;
 
 /*-----------------------------------------------------------------------------------------------------------*/
 /*-----------------------------------------------------------------------------------------------------------*/
@@ -837,7 +777,7 @@ enum watchdog Watchdog_status = wait;
   while (1)
   {
     Watchdog_status = feeddog;
-    err = OSMboxPost(Mbox_WatchDog, (void*)&Watchdog_status);
+    err = OSPortWrite(Port_WatchDog, &Watchdog_status);
     // if(WATCHDOH_DEBUG) printf("watch_dog_msg send! \n");
 
     OSSemPend(OverloadDetectionSem, 0, &err);
@@ -896,6 +836,7 @@ void StartTask(void* pdata)
 {
   INT8U err;
   void* context;
+  enum active signal_off = off;
 
   static alt_alarm alarm;     /* Is needed for timer ISR function */
 
@@ -914,113 +855,6 @@ void StartTask(void* pdata)
     printf("No system clock available!n");
   }
 
-  /* 
-   * Create and start Software Timer 
-   */
-
-  CONTROLTmr = OSTmrCreate(0, //initial delay
-                        CONTROL_PERIOD/HW_TIMER_PERIOD, // period
-                        OS_TMR_OPT_PERIODIC, // automatically reload itself
-                        CONTROLTmrCallback, // callback function
-                        (void *)0,
-                        "CONTROLTmr",
-                        &err);
-  if(DEBUG){
-    if(err == OS_ERR_NONE){ // create successfully
-        printf("CONTROLTmr created \n");
-    }
-  }
-  
-  VEHICLETmr = OSTmrCreate(0, //initial delay
-                        VEHICLE_PERIOD/HW_TIMER_PERIOD, // period
-                        OS_TMR_OPT_PERIODIC, // automatically reload itself
-                        VEHICLETmrCallback, // callback function
-                        (void *)0,
-                        "VEHICLETmr",
-                        &err);
-  if(DEBUG){
-    if(err == OS_ERR_NONE){ // create successfully
-        printf("VEHICLETmr created \n");
-    }
-  }
-
-   SWITCHIOTmr = OSTmrCreate(0, //initial delay
-                        SWITCHIO_PERIOD/HW_TIMER_PERIOD, // period
-                        OS_TMR_OPT_PERIODIC, // automatically reload itself
-                        SWITCHIOTmrCallback, // callback function
-                        (void *)0,
-                        "SWITCHIOTmr",
-                        &err);
-  if(DEBUG){
-    if(err == OS_ERR_NONE){ // create successfully
-        printf("CONTROLTmr created \n");
-    }
-  }
-  
-  BUTTONIOTmr = OSTmrCreate(0, //initial delay
-                        BUTTONIO_PERIOD/HW_TIMER_PERIOD, // period
-                        OS_TMR_OPT_PERIODIC, // automatically reload itself
-                        BUTTONIOTmrCallback, // callback function
-                        (void *)0,
-                        "BUTTONIOTmr",
-                        &err);
-  if(DEBUG){
-    if(err == OS_ERR_NONE){ // create successfully
-        printf("BUTTONIOTmr created \n");
-    }
-  }
-
-  OverloadTmr = OSTmrCreate(0, //initial delay
-                        OVERLOAD_PERIOD/HW_TIMER_PERIOD, // period
-                        OS_TMR_OPT_PERIODIC, // automatically reload itself
-                        OverloadTmrCallbask, // callback function
-                        (void *)0,
-                        "OverloadTmr",
-                        &err);
-  if(DEBUG){
-    if(err == OS_ERR_NONE){ // create successfully
-        printf("OverloadTmr created \n");
-    }
-  }
-
-
-  // Start timers
-  OSTmrStart(CONTROLTmr, &err);
-  if (DEBUG) {
-    if (err == OS_ERR_NONE) { //start successful
-      printf("CONTROLTmr started\n");
-    }
-   }
-
-  OSTmrStart(VEHICLETmr, &err);
-  if (DEBUG) {
-    if (err == OS_ERR_NONE) { //start successful
-      printf("VEHICLETmr started\n");
-    }
-   }
-
-  OSTmrStart(SWITCHIOTmr, &err);
-  if (DEBUG) {
-    if (err == OS_ERR_NONE) { //start successful
-      printf("SWITCHIOTmr started\n");
-    }
-   }
-
-  OSTmrStart(BUTTONIOTmr, &err);
-  if (DEBUG) {
-    if (err == OS_ERR_NONE) { //start successful
-      printf("BUTTONIOTmr started\n");
-    }
-   }
-  
-  OSTmrStart(OverloadTmr, &err);
-  if (DEBUG) {
-    if (err == OS_ERR_NONE) { //start successful
-      printf("OverloadTmr started\n");
-    }
-   }
-
-
   /*
    * Creation of Kernel Objects
    */
@@ -1034,16 +868,39 @@ void StartTask(void* pdata)
   OverloadDetectionSem = OSSemCreate(0);
   ExtraLoadSem = OSSemCreate(0);
 
-  // Mailboxes
-  Mbox_Throttle = OSMboxCreate((void*) 0); /* Empty Mailbox - Throttle */
-  Mbox_Velocity = OSMboxCreate((void*) 0); /* Empty Mailbox - Velocity */
-  Mbox_Brake = OSMboxCreate((void*) 0); /* Empty Mailbox - Velocity */
-  Mbox_Engine_to_vehicle = OSMboxCreate((void*) 0); /* Empty Mailbox - Engine */
-  Mbox_Engine_to_control = OSMboxCreate((void*) 0);
-  Mbox_Cruise = OSMboxCreate((void*) 0); /* Empty Mailbox - Cruise */
-  Mbox_Gas_pedel = OSMboxCreate((void*) 0); /* Empty Mailbox - gas_pedel */
-  Mbox_Top_gear = OSMboxCreate((void*) 0); /* Empty Mailbox - top_gear */
-  Mbox_WatchDog = OSMboxCreate((void*) 0); /* Empty Mailbox - watch dog */
+  // State ports, the signals start as off until their writer runs
+  Port_Throttle = OSPortCreate(sizeof(INT8U), (void*) 0, OS_PORT_OPT_NONE, &err); /* Throttle 0 */
+  Port_Velocity = OSPortCreate(sizeof(INT16S), (void*) 0, OS_PORT_OPT_PEND, &err); /* Velocity 0 */
+  Port_Brake = OSPortCreate(sizeof(enum active), &signal_off, OS_PORT_OPT_NONE, &err);
+  Port_Engine = OSPortCreate(sizeof(enum active), &signal_off, OS_PORT_OPT_NONE, &err);
+  Port_Cruise = OSPortCreate(sizeof(enum active), &signal_off, OS_PORT_OPT_NONE, &err);
+  Port_Gas_pedel = OSPortCreate(sizeof(enum active), &signal_off, OS_PORT_OPT_NONE, &err);
+  Port_Top_gear = OSPortCreate(sizeof(enum active), &signal_off, OS_PORT_OPT_NONE, &err);
+  Port_WatchDog = OSPortCreate(sizeof(enum watchdog), (void*) 0, OS_PORT_OPT_NONE, &err);
+
+  /* 
+   * Create and start the Software Timer group: every period, each member
+   * posts its semaphore at its phase, in the order they are added here.
+   * All the tasks share the same period.
+   */
+
+  PeriodicGrp = OSTmrGrpCreate(CONTROL_PERIOD/HW_TIMER_PERIOD, // period
+                               TMR_GRP_OPT,
+                               (INT8U *)"PeriodicGrp",
+                               &err);
+  OSTmrGrpAdd(PeriodicGrp, SWITCHIO_PHASE/HW_TIMER_PERIOD, NULL, SwitchIOSem, &err);
+  OSTmrGrpAdd(PeriodicGrp, BUTTONIO_PHASE/HW_TIMER_PERIOD, NULL, ButtonIOSem, &err);
+  OSTmrGrpAdd(PeriodicGrp, VEHICLE_PHASE/HW_TIMER_PERIOD, NULL, VEHICLETmrSem, &err);
+  OSTmrGrpAdd(PeriodicGrp, CONTROL_PHASE/HW_TIMER_PERIOD, NULL, CONTROLTmrSem, &err);
+  OSTmrGrpAdd(PeriodicGrp, OVERLOAD_PHASE/HW_TIMER_PERIOD, NULL, WatchdogSem, &err);
+  OSTmrGrpAdd(PeriodicGrp, OVERLOAD_PHASE/HW_TIMER_PERIOD, NULL, ExtraLoadSem, &err);
+  OSTmrGrpAdd(PeriodicGrp, OVERLOAD_PHASE/HW_TIMER_PERIOD, NULL, OverloadDetectionSem, &err);
+  OSTmrGrpStart(PeriodicGrp, &err);
+  if (DEBUG) {
+    if (err == OS_ERR_NONE) { //start successful
+      printf("PeriodicGrp started\n");
+    }
+  }
 
   /*
    * Create statistics task
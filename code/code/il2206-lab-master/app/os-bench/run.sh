@@ -0,0 +1,84 @@
+#!/bin/bash
+# @file: run.sh
+# @authors: Rodolfo Jordao, KTH/EECS/ELE
+#           George Ungureanu, KTH/EECS/ELE
+# @date: 20-08-2019
+# @version: 0.2
+#
+# This is a bash script for automating the compilation and deployment
+# of the Nios II project in the current folder. It is a more readable
+# (albeit less powerful) version of the 'Makefile' one folder
+# above. It is recommended for beginner students to understand what is
+# happening during the compilation process.
+
+# Paths for DE2-35 sources
+CORE_FILE=../../hardware/DE2-pre-built/DE2_Nios2System.sopcinfo
+SOF_FILE=../../hardware/DE2-pre-built/IL2206_DE2_Nios2.sof
+JDI_FILE=../../hardware/DE2-pre-built/IL2206_DE2_Nios2.jdi
+
+# Paths for DE2-115 sources
+# CORE_FILE=../../hardware/DE2-115-pre-built/DE2_115_Nios2System.sopcinfo
+# SOF_FILE=../../hardware/DE2-115-pre-built/IL2206_DE2_115_Nios2.sof
+# JDI_FILE=../../hardware/DE2-115-pre-built/IL2206_DE2_115_Nios2.jdi
+
+APP_NAME=os-bench
+CPU_NAME=nios2
+BSP_PATH=../lab2-cruise/bsp
+SRC_PATH=./src
+
+# The benchmarks measure the kernel sources kept in the lab2-cruise BSP,
+# so that BSP is copied as it is. Running nios2-bsp on it would put the
+# stock uC/OS-II sources back. Kernel options are set below, and any
+# NAME=VALUE argument overrides a '#define NAME' of os_cfg.h or system.h,
+# e.g. './run.sh OS_EDF_EN=1' for the EDF side of bench_edf.
+BSP_SETTINGS="OS_MAX_TASKS=64 OS_LOWEST_PRIO=63 OS_TMR_CFG_MAX=256 $*"
+
+# Project internal folders
+mkdir -p gen
+mkdir -p bin
+
+echo -e "\n******************************************"
+echo -e   "Building the BSP and compiling the program"
+echo -e   "******************************************\n"
+
+rm -rf bsp
+cp -r $BSP_PATH bsp
+rm -rf bsp/obj bsp/libucosii_bsp.a
+
+for setting in $BSP_SETTINGS; do
+    name=${setting%%=*}
+    value=${setting#*=}
+    if ! grep -q "^#define $name " bsp/UCOSII/inc/os_cfg.h bsp/system.h; then
+        echo "Unknown kernel setting $name"
+        exit 1
+    fi
+    sed -i "s/^\(#define $name \+\)[^ ]\+/\1$value/" bsp/UCOSII/inc/os_cfg.h bsp/system.h
+done
+
+cd gen
+
+nios2-app-generate-makefile \
+    --bsp-dir ../bsp \
+    --elf-name ../bin/$APP_NAME.elf \
+    --src-dir ../$SRC_PATH \
+    --set APP_CFLAGS_OPTIMIZATION -O0
+
+make | tee -a log.txt 
+
+cd ..
+
+echo -e "\n**************************"
+echo -e  "Download hardware to board"
+echo -e  "**************************\n"
+
+nios2-configure-sof $SOF_FILE
+
+echo -e "\n**************************"
+echo -e   "Download software to board"
+echo -e   "**************************\n"
+
+xterm -e "nios2-terminal -i 0" &
+nios2-download -g bin/$APP_NAME.elf --cpu_name $CPU_NAME --jdi $JDI_FILE
+
+echo ""
+echo "Code compilation errors are logged in 'log.txt'"
@@ -0,0 +1,54 @@
+/* alt_tick() cost against the number of registered HAL alarms
+ *
+ * ALARM_MAX alarms are started far into the future, in decreasing order
+ * so that each one is inserted at the head of the sorted list, and the
+ * ticks are emulated by calling alt_tick() as the system clock ISR does.
+ * No alarm is due, so what is measured is the tick with the OSTimeTick()
+ * it calls and the look at the first alarm. The cost stays flat with the
+ * number of alarms, where the original unsorted list was walked in full
+ * at every tick.
+ */
+#include "os_bench.h"
+#include "sys/alt_alarm.h"
+
+#define ALARM_MAX     64
+#define ALARM_SAMPLES 100
+
+static alt_alarm Alarm[ALARM_MAX];
+
+static alt_u32 Callback(void *context)
+{
+  return 0;
+}
+
+void bench_alarm(void)
+{
+  static const int counts[] = {0, 1, 4, 16, 64};
+  OS_CPU_SR cpu_sr;
+  unsigned int k;
+  int n = 0;
+  int i;
+
+  printf("\nalt_tick against the number of alarms\n");
+  printf(" alarms  cycles/tick\n");
+  for (k = 0; k < sizeof(counts) / sizeof(counts[0]); k++) {
+    for (; n < counts[k]; n++) {
+      alt_alarm_start(&Alarm[n], 1000000 - 13 * n, Callback, (void *)0);
+    }
+
+    OSSchedLock();              /* OSTmrSignal() must not switch to OSTmr_Task */
+    bench_start();
+    for (i = 0; i < ALARM_SAMPLES; i++) {
+      cpu_sr = alt_irq_disable_all();
+      BENCH_BEGIN(BENCH_SECTION_A);
+      alt_tick();
+      BENCH_END(BENCH_SECTION_A);
+      alt_irq_enable_all(cpu_sr);
+    }
+    printf(" %6d  %11lu\n", n, bench_cycles(BENCH_SECTION_A));
+    OSSchedUnlock();
+  }
+  for (i = 0; i < n; i++) {
+    alt_alarm_stop(&Alarm[i]);
+  }
+}
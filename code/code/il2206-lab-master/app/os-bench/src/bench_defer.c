@@ -0,0 +1,94 @@
+/* Time spent with interrupts disabled by an ISR post
+ *
+ * An ISR is emulated by disabling interrupts and raising OSIntNesting,
+ * which is what the post functions see when called from alt_irq
+ * handlers. Each sample readies a task: a helper pending on a semaphore
+ * for OSSemPost(), the defer task for OSIntDefer(). Both the average and
+ * the worst sample are printed, the worst being what an interrupt of a
+ * higher level has to wait for.
+ *
+ * With OS_ISR_DEFER_EN 1 the line for OSIntDefer() is added; OSSemPost()
+ * itself is then made later by the defer task, with interrupts enabled.
+ */
+#include "os_bench.h"
+
+#define DEFER_SAMPLES 100
+
+static OS_EVENT *DeferSem;
+
+static void Waiter(void *pdata)
+{
+  INT8U err;
+
+  while (1) {
+    OSSemPend(DeferSem, 0, &err);
+  }
+}
+
+/* Time 'post' as if from an ISR, once per tick; returns the worst sample */
+static alt_u32 isr_post(int section, INT8U (*post)(void), alt_u32 *avg)
+{
+  OS_CPU_SR cpu_sr;
+  alt_u32 sum = 0;
+  alt_u32 max = 0;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < DEFER_SAMPLES; i++) {
+    OSTimeDly(1);               /* the waiter pends again */
+    bench_start();
+    cpu_sr = alt_irq_disable_all();
+    OSIntNesting++;
+    BENCH_BEGIN(section);
+    post();
+    BENCH_END(section);
+    OSIntNesting--;
+    alt_irq_enable_all(cpu_sr);
+    t = bench_cycles(section);
+    sum += t;
+    if (t > max) {
+      max = t;
+    }
+  }
+  *avg = sum / DEFER_SAMPLES;
+  return max;
+}
+
+static INT8U post_sem(void)
+{
+  return OSSemPost(DeferSem);
+}
+
+#if OS_ISR_DEFER_EN > 0
+static INT8U post_defer(void)
+{
+  return OSIntDefer(OS_DEFER_SEM_POST, DeferSem, 0);
+}
+#endif
+
+void bench_defer(void)
+{
+  alt_u32 avg;
+  alt_u32 max;
+  INT8U err;
+  INT8U n;
+
+  printf("\nISR post, interrupts disabled (OS_ISR_DEFER_EN %d)\n", OS_ISR_DEFER_EN);
+  printf("                      avg     max\n");
+
+  DeferSem = OSSemCreate(0);
+  n = bench_spawn(Waiter, 1);
+  if (n > 0) {
+    max = isr_post(BENCH_SECTION_A, post_sem, &avg);
+    printf(" OSSemPost()        %5lu   %5lu cycles\n", avg, max);
+#if OS_ISR_DEFER_EN > 0
+    max = isr_post(BENCH_SECTION_B, post_defer, &avg);
+    printf(" OSIntDefer()       %5lu   %5lu cycles\n", avg, max);
+    printf(" ring peak %d of %d, %lu lost\n",
+           OSDeferEntriesMax, OS_ISR_DEFER_SIZE, OSDeferOvfCtr);
+#endif
+    OSTimeDly(1);               /* last post replayed */
+  }
+  bench_reap(n);
+  OSSemDel(DeferSem, OS_DEL_ALWAYS, &err);
+}
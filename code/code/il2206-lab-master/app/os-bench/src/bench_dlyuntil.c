@@ -0,0 +1,84 @@
+/* Drift of a periodic loop: OSTimeDly() against OSTimeDlyUntil()
+ *
+ * A helper runs DLYUNTIL_LOOPS jobs of 0 to 1.5 ticks of work, each
+ * followed by a wait for the next period. With the relative OSTimeDly()
+ * every job pushes the following releases back by its own length; with
+ * OSTimeDlyUntil() the loop takes exactly DLYUNTIL_LOOPS periods.
+ */
+#include "os_bench.h"
+
+#define DLYUNTIL_LOOPS  50
+#define DLYUNTIL_PERIOD ((INT16U)OS_TIME_HMSM_TICKS(0, 0, 0, 10))
+
+static OS_EVENT *DoneSem;
+static INT32U SpinPerTick;
+static INT32U Elapsed;
+static INT16U Missed;
+
+static void Job(int k)
+{
+  bench_spin(SpinPerTick * (k & 3) / 2);
+}
+
+static void RelLoop(void *pdata)
+{
+  INT32U start = OSTimeGet();
+  int k;
+
+  for (k = 0; k < DLYUNTIL_LOOPS; k++) {
+    Job(k);
+    OSTimeDly(DLYUNTIL_PERIOD);
+  }
+  Elapsed = OSTimeGet() - start;
+  OSSemPost(DoneSem);
+  OSTaskSuspend(OS_PRIO_SELF);
+}
+
+#if OS_TIME_DLY_UNTIL_EN > 0
+static void AbsLoop(void *pdata)
+{
+  INT32U start = OSTimeGet();
+  INT32U last  = start;
+  int k;
+
+  for (k = 0; k < DLYUNTIL_LOOPS; k++) {
+    Job(k);
+    Missed += OSTimeDlyUntil(&last, DLYUNTIL_PERIOD);
+  }
+  Elapsed = OSTimeGet() - start;
+  OSSemPost(DoneSem);
+  OSTaskSuspend(OS_PRIO_SELF);
+}
+#endif
+
+static void run(const char *name, void (*loop)(void *))
+{
+  INT8U err;
+
+  OSTimeDly(1);
+  if (bench_spawn(loop, 1) > 0) {
+    OSSemPend(DoneSem, 0, &err);
+    printf(" %-16s %6lu %6ld\n", name, Elapsed,
+           (long)(Elapsed - (INT32U)DLYUNTIL_LOOPS * DLYUNTIL_PERIOD));
+    bench_reap(1);
+  }
+}
+
+void bench_dlyuntil(void)
+{
+  INT8U err;
+
+  printf("\n%d periods of %d ticks (OS_TIME_DLY_UNTIL_EN %d)\n",
+         DLYUNTIL_LOOPS, DLYUNTIL_PERIOD, OS_TIME_DLY_UNTIL_EN);
+  printf("                   ticks  drift\n");
+
+  SpinPerTick = bench_spin_per_tick();
+  DoneSem = OSSemCreate(0);
+  run("OSTimeDly()", RelLoop);
+#if OS_TIME_DLY_UNTIL_EN > 0
+  Missed = 0;
+  run("OSTimeDlyUntil()", AbsLoop);
+  printf(" %u periods missed\n", Missed);
+#endif
+  OSSemDel(DoneSem, OS_DEL_ALWAYS, &err);
+}
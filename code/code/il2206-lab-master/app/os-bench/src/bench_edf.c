@@ -0,0 +1,115 @@
+/* Earliest deadline first against fixed priorities
+ *
+ * Two periodic tasks load the CPU to about 93%:
+ *
+ *   task 0: period 10 ticks, 4 ticks of work
+ *   task 1: period 15 ticks, 8 ticks of work
+ *
+ * With fixed, rate monotonic priorities (OS_EDF_EN 0) task 1 misses
+ * deadlines: at every common release it only gets 6 of its 8 ticks
+ * before task 0 comes back. With OS_EDF_EN 1 the same set is created
+ * by OSTaskCreateEDF() and meets all its deadlines. The work is done
+ * with the harness' bench_spin(), calibrated by bench_spin_per_tick()
+ * before the tasks start.
+ *
+ * The helpers must lie within the EDF band (OS_EDF_PRIO_HI to
+ * OS_EDF_PRIO_LO) when OS_EDF_EN is 1.
+ */
+#include "os_bench.h"
+
+#define EDF_TASKS    2
+#define EDF_TICKS 3000
+
+static const INT16U EDFPeriod[EDF_TASKS] = {10, 15};
+static const INT16U EDFWork[EDF_TASKS]   = { 4,  8};
+
+static INT32U SpinPerTick;
+static volatile INT32U EDFJobs[EDF_TASKS];
+static volatile INT32U EDFMisses[EDF_TASKS];
+
+static void EDFTask(void *pdata)
+{
+  INT32U i = (INT32U)pdata;
+#if OS_EDF_EN == 0
+  INT32U release = OSTimeGet();
+  INT32U now;
+#endif
+
+  while (1) {
+    bench_spin(EDFWork[i] * SpinPerTick);
+    EDFJobs[i]++;
+#if OS_EDF_EN > 0
+    if (OSTaskEDFWait() == OS_ERR_TASK_EDF_MISS) {
+      EDFMisses[i]++;
+    }
+#else
+    now = OSTimeGet();
+    if (now > release + EDFPeriod[i]) {     /* deadline = period */
+      EDFMisses[i]++;
+    }
+    release += EDFPeriod[i];
+    if (release > now) {
+      OSTimeDly((INT16U)(release - now));
+    }
+#endif
+  }
+}
+
+void bench_edf(void)
+{
+  INT32U ctx_ctr;
+  INT8U err;
+  INT8U n;
+  INT8U i;
+
+  printf("\nEDF vs fixed priorities (OS_EDF_EN %d, %d ticks)\n",
+         OS_EDF_EN, EDF_TICKS);
+
+  SpinPerTick = bench_spin_per_tick();
+  for (i = 0; i < EDF_TASKS; i++) {
+    EDFJobs[i]   = 0;
+    EDFMisses[i] = 0;
+  }
+  OSTimeDly(1);                 /* start both tasks within the same tick */
+  ctx_ctr = OSCtxSwCtr;
+  for (n = 0; n < EDF_TASKS && n < BENCH_MAX_HELPERS; n++) {
+#if OS_EDF_EN > 0
+    err = OSTaskCreateEDF(EDFTask,
+                          (void *)(INT32U)n,
+                          &bench_stk[n][BENCH_STACKSIZE - 1],
+                          BENCH_HELPER_PRIO + n,
+                          BENCH_HELPER_PRIO + n,
+                          &bench_stk[n][0],
+                          BENCH_STACKSIZE,
+                          (void *)0,
+                          OS_TASK_OPT_STK_CHK,
+                          EDFPeriod[n],
+                          EDFPeriod[n]);
+#else
+    err = OSTaskCreateExt(EDFTask,  /* shorter period, higher priority */
+                          (void *)(INT32U)n,
+                          &bench_stk[n][BENCH_STACKSIZE - 1],
+                          BENCH_HELPER_PRIO + n,
+                          BENCH_HELPER_PRIO + n,
+                          &bench_stk[n][0],
+                          BENCH_STACKSIZE,
+                          (void *)0,
+                          OS_TASK_OPT_STK_CHK);
+#endif
+    if (err != OS_NO_ERR) {
+      printf("bench: EDF task %d not created (%d)\n", n, err);
+      break;
+    }
+  }
+  OSTimeDly(EDF_TICKS);
+  bench_reap(n);
+  ctx_ctr = OSCtxSwCtr - ctx_ctr;
+
+  printf(" %lu spin loops per tick\n", SpinPerTick);
+  printf(" task  period  work  jobs  misses\n");
+  for (i = 0; i < n; i++) {
+    printf(" %4d  %6d  %4d  %4lu  %6lu\n",
+           i, EDFPeriod[i], EDFWork[i], EDFJobs[i], EDFMisses[i]);
+  }
+  printf(" task switches %lu\n", ctx_ctr);
+}
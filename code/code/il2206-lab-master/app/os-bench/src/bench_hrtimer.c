@@ -0,0 +1,104 @@
+/* Accuracy and jitter of the high-resolution timers
+ *
+ * A periodic alt_hrtimer of HRTIMER_PERIOD_US runs for HRTIMER_SAMPLES
+ * periods. Each callback reads alt_hrtimer_now() and keeps the lateness
+ * from its deadline: the minimum is the fixed cost of the path to the
+ * callback, the spread up to the maximum is the jitter. The ISR path is
+ * measured always, the deferred path with OS_ISR_DEFER_EN 1.
+ *
+ * The time base itself is compared with the global performance counter,
+ * which counts the same 50 MHz clock without ever being stopped; the
+ * difference is what the reloads of the timer period lost.
+ *
+ * Needs a BSP and application built with -DALT_HRTIMER.
+ */
+#include "os_bench.h"
+
+#ifdef ALT_HRTIMER
+
+#include "sys/alt_hrtimer.h"
+
+#define HRTIMER_SAMPLES   400
+#define HRTIMER_PERIOD_US 250
+
+static alt_hrtimer Timer;
+static OS_EVENT *DoneSem;
+static alt_u64 Expected;
+static alt_u32 LateMin;
+static alt_u32 LateMax;
+static alt_u32 LateSum;
+static int Count;
+
+static void Callback(void *context)
+{
+  alt_u32 late;
+
+  late = (alt_u32)(alt_hrtimer_now() - Expected);
+  Expected += HRTIMER_PERIOD_US * ALT_HRTIMER_CYCLES_PER_US;
+  if (late < LateMin) {
+    LateMin = late;
+  }
+  if (late > LateMax) {
+    LateMax = late;
+  }
+  LateSum += late;
+  if (++Count == HRTIMER_SAMPLES) {
+    alt_hrtimer_stop(&Timer);
+    OSSemPost(DoneSem);
+  }
+}
+
+static void run(const char *name, alt_u8 opt)
+{
+  alt_u64 t0;
+  alt_u64 hr;
+  alt_u64 perf;
+  INT8U err;
+
+  LateMin = 0xFFFFFFFF;
+  LateMax = 0;
+  LateSum = 0;
+  Count = 0;
+  OSTimeDly(1);
+  bench_start();
+  t0 = alt_hrtimer_now();
+  if (alt_hrtimer_start(&Timer, HRTIMER_PERIOD_US, HRTIMER_PERIOD_US,
+                        Callback, (void *)0, opt) != 0) {
+    printf(" %-9s not started\n", name);
+    return;
+  }
+  Expected = Timer.expires;
+  OSSemPend(DoneSem, 0, &err);
+  hr = alt_hrtimer_now() - t0;
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  perf = perf_get_total_time((void *)PERFORMANCE_COUNTER_BASE);
+  printf(" %-9s %6lu %6lu %6lu   %6ld ppm\n", name, LateMin,
+         LateSum / HRTIMER_SAMPLES, LateMax,
+         (long)((alt_64)(hr - perf) * 1000000 / (alt_64)perf));
+}
+
+void bench_hrtimer(void)
+{
+  INT8U err;
+
+  printf("\nHigh-resolution timer, %d periods of %d us\n",
+         HRTIMER_SAMPLES, HRTIMER_PERIOD_US);
+  printf("            lateness, cycles        time base\n");
+  printf("              min    avg    max       error\n");
+
+  DoneSem = OSSemCreate(0);
+  run("ISR", 0);
+#if OS_ISR_DEFER_EN > 0
+  run("deferred", ALT_HRTIMER_DEFERRED);
+#endif
+  OSSemDel(DoneSem, OS_DEL_ALWAYS, &err);
+}
+
+#else
+
+void bench_hrtimer(void)
+{
+  printf("\nHigh-resolution timer: build with -DALT_HRTIMER\n");
+}
+
+#endif
@@ -0,0 +1,64 @@
+/* Post-to-run latency: semaphore against task notification
+ *
+ * BenchTask waits, a helper at a lower priority posts. The time runs
+ * from just before the post, in the helper, to the return of the pend
+ * in BenchTask, so it includes the context switch. The same loop is
+ * run with OSSemPost()/OSSemPend() and with OSTaskNotify()/
+ * OSTaskNotifyPend() used as a counting semaphore.
+ */
+#include "os_bench.h"
+
+#define NOTIFY_SAMPLES 100
+
+static OS_EVENT *NotifySem;
+
+static void SemPoster(void *pdata)
+{
+  while (1) {
+    BENCH_BEGIN(BENCH_SECTION_A);
+    OSSemPost(NotifySem);
+  }
+}
+
+#if OS_TASK_NOTIFY_EN > 0
+static void NotifyPoster(void *pdata)
+{
+  while (1) {
+    BENCH_BEGIN(BENCH_SECTION_B);
+    OSTaskNotify(BENCH_TASK_PRIO, 0, OS_NOTIFY_INC);
+  }
+}
+#endif
+
+void bench_notify(void)
+{
+  INT8U err;
+  INT8U n;
+  int i;
+
+  printf("\nPost to run latency (OS_TASK_NOTIFY_EN %d)\n", OS_TASK_NOTIFY_EN);
+
+  NotifySem = OSSemCreate(0);
+  bench_start();
+  n = bench_spawn(SemPoster, 1);
+  for (i = 0; i < NOTIFY_SAMPLES && n > 0; i++) {
+    OSSemPend(NotifySem, 0, &err);
+    BENCH_END(BENCH_SECTION_A);
+  }
+  bench_reap(n);
+  printf(" OSSemPost -> OSSemPend              %5lu cycles\n",
+         bench_cycles(BENCH_SECTION_A));
+  OSSemDel(NotifySem, OS_DEL_ALWAYS, &err);
+
+#if OS_TASK_NOTIFY_EN > 0
+  bench_start();
+  n = bench_spawn(NotifyPoster, 1);
+  for (i = 0; i < NOTIFY_SAMPLES && n > 0; i++) {
+    OSTaskNotifyPend(0, OS_NOTIFY_TAKE_ONE, &err);
+    BENCH_END(BENCH_SECTION_B);
+  }
+  bench_reap(n);
+  printf(" OSTaskNotify -> OSTaskNotifyPend    %5lu cycles\n",
+         bench_cycles(BENCH_SECTION_B));
+#endif
+}
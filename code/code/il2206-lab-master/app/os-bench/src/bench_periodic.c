@@ -0,0 +1,104 @@
+/* Periodic release: timer + semaphore against OSTaskCreatePeriodic()
+ *
+ * The same helper is released PERIODIC_RELEASES times, once per timer
+ * tick, first the way lab2-cruise does it (a periodic OS_TMR whose
+ * callback posts the semaphore the task pends on), then, with
+ * OS_TASK_PERIODIC_EN 1, as a task created by OSTaskCreatePeriodic().
+ * The context switches of the whole run are counted per release; they
+ * include the idle and statistic tasks, the same in both runs.
+ */
+#include "os_bench.h"
+
+#define PERIODIC_RELEASES 20
+#define PERIODIC_TICKS    ((INT16U)(OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC))
+
+static OS_EVENT *RelSem;
+static OS_EVENT *DoneSem;
+
+static void Callback(void *ptmr, void *parg)
+{
+  OSSemPost(RelSem);
+}
+
+static void TmrWorker(void *pdata)
+{
+  INT8U err;
+  int k;
+
+  for (k = 0; k < PERIODIC_RELEASES; k++) {
+    OSSemPend(RelSem, 0, &err);
+  }
+  OSSemPost(DoneSem);
+  OSTaskSuspend(OS_PRIO_SELF);
+}
+
+#if OS_TASK_PERIODIC_EN > 0
+static void PeriodicWorker(void *pdata)
+{
+  int k;
+
+  for (k = 0; k < PERIODIC_RELEASES; k++) {
+    OSTaskWaitNextPeriod();
+  }
+  OSSemPost(DoneSem);
+  OSTaskSuspend(OS_PRIO_SELF);
+}
+#endif
+
+static void report(const char *name, INT32U ctx_ctr)
+{
+  ctx_ctr = (OSCtxSwCtr - ctx_ctr) * 10 / PERIODIC_RELEASES;
+  printf(" %-24s %3lu.%lu switches/release\n", name, ctx_ctr / 10, ctx_ctr % 10);
+}
+
+void bench_periodic(void)
+{
+  OS_TMR *tmr;
+  INT32U ctx_ctr;
+  INT8U err;
+
+  printf("\nPeriodic release every %d ticks (OS_TASK_PERIODIC_EN %d)\n",
+         (int)PERIODIC_TICKS, OS_TASK_PERIODIC_EN);
+
+  RelSem  = OSSemCreate(0);
+  DoneSem = OSSemCreate(0);
+
+  tmr = OSTmrCreate(0, 1, OS_TMR_OPT_PERIODIC, Callback, (void *)0,
+                    (INT8U *)"bench", &err);
+  if (tmr != (OS_TMR *)0 && bench_spawn(TmrWorker, 1) > 0) {
+    ctx_ctr = OSCtxSwCtr;
+    OSTmrStart(tmr, &err);
+    OSSemPend(DoneSem, 0, &err);
+    OSTmrStop(tmr, OS_TMR_OPT_NONE, (void *)0, &err);
+    report("OS_TMR + semaphore", ctx_ctr);
+    bench_reap(1);
+  }
+  if (tmr != (OS_TMR *)0) {
+    OSTmrDel(tmr, &err);
+  }
+  printf(" %-24s %5d bytes/task\n", "  of which OS_TMR+OS_EVENT",
+         (int)(sizeof(OS_TMR) + sizeof(OS_EVENT)));
+
+#if OS_TASK_PERIODIC_EN > 0
+  OSTimeDly(1);
+  ctx_ctr = OSCtxSwCtr;
+  err = OSTaskCreatePeriodic(PeriodicWorker,
+                             (void *)0,
+                             &bench_stk[0][BENCH_STACKSIZE - 1],
+                             BENCH_HELPER_PRIO,
+                             BENCH_HELPER_PRIO,
+                             &bench_stk[0][0],
+                             BENCH_STACKSIZE,
+                             (void *)0,
+                             OS_TASK_OPT_STK_CHK,
+                             PERIODIC_TICKS);
+  if (err == OS_ERR_NONE) {
+    OSSemPend(DoneSem, 0, &err);
+    report("OSTaskWaitNextPeriod()", ctx_ctr);
+    bench_reap(1);
+  }
+#endif
+
+  OSSemDel(DoneSem, OS_DEL_ALWAYS, &err);
+  OSSemDel(RelSem, OS_DEL_ALWAYS, &err);
+}
@@ -0,0 +1,148 @@
+/* Sampling the latest value: polled mailbox against state port
+ *
+ * Sample: the cost of one non-blocking read, the way lab2-cruise reads
+ * its inputs. OSMboxPend() with a timeout of 1 returns at once when a
+ * message is waiting, but sleeps for a whole tick when the writer has
+ * not posted since the last read. OSMboxAccept() does not sleep but
+ * leaves the reader without a value. OSPortRead() always returns the
+ * latest value, for a 2 and an OS_PORT_DATA_SIZE byte port.
+ *
+ * Latency: BenchTask waits for a new value, a helper at a lower priority
+ * posts it, like bench_notify.c.
+ */
+#include "os_bench.h"
+
+#if (OS_PORT_EN > 0) && (OS_MAX_PORTS > 0)
+
+#define PORT_SAMPLES 100
+
+static OS_EVENT *Mbox;
+static OS_PORT  *Port;
+static OS_PORT  *WidePort;
+static INT16S    Value;
+static INT32U    Wide[(OS_PORT_DATA_SIZE + 3) / 4];
+
+static void MboxWriter(void *pdata)
+{
+  while (1) {
+    BENCH_BEGIN(BENCH_SECTION_B);
+    OSMboxPost(Mbox, &Value);
+  }
+}
+
+static void PortWriter(void *pdata)
+{
+  while (1) {
+    Value++;
+    BENCH_BEGIN(BENCH_SECTION_B);
+    OSPortWrite(Port, &Value);
+  }
+}
+
+static void sample(void)
+{
+  INT16S val;
+  INT8U err;
+  int i;
+
+  bench_start();
+  for (i = 0; i < PORT_SAMPLES; i++) {
+    OSMboxPost(Mbox, &Value);
+    BENCH_BEGIN(BENCH_SECTION_A);
+    val = *(INT16S *)OSMboxPend(Mbox, 1, &err);
+    BENCH_END(BENCH_SECTION_A);
+  }
+  printf(" OSMboxPend(1), posted      %7lu cycles\n", bench_cycles(BENCH_SECTION_A));
+
+  OSTimeDly(1);
+  bench_start();
+  for (i = 0; i < 4; i++) {
+    BENCH_BEGIN(BENCH_SECTION_A);
+    (void)OSMboxPend(Mbox, 1, &err);
+    BENCH_END(BENCH_SECTION_A);
+  }
+  printf(" OSMboxPend(1), not posted  %7lu cycles\n", bench_cycles(BENCH_SECTION_A));
+
+  bench_start();
+  for (i = 0; i < PORT_SAMPLES; i++) {
+    BENCH_BEGIN(BENCH_SECTION_A);
+    (void)OSMboxAccept(Mbox);
+    BENCH_END(BENCH_SECTION_A);
+  }
+  printf(" OSMboxAccept, not posted   %7lu cycles\n", bench_cycles(BENCH_SECTION_A));
+
+  bench_start();
+  for (i = 0; i < PORT_SAMPLES; i++) {
+    BENCH_BEGIN(BENCH_SECTION_A);
+    (void)OSPortRead(Port, &val);
+    BENCH_END(BENCH_SECTION_A);
+  }
+  printf(" OSPortRead, %2d bytes       %7lu cycles\n", (int)sizeof(val),
+         bench_cycles(BENCH_SECTION_A));
+
+  bench_start();
+  for (i = 0; i < PORT_SAMPLES; i++) {
+    BENCH_BEGIN(BENCH_SECTION_A);
+    (void)OSPortRead(WidePort, Wide);
+    BENCH_END(BENCH_SECTION_A);
+  }
+  printf(" OSPortRead, %2d bytes       %7lu cycles\n", OS_PORT_DATA_SIZE,
+         bench_cycles(BENCH_SECTION_A));
+  (void)val;
+}
+
+static void latency(void)
+{
+  INT32U ver = 0;
+  INT16S val;
+  INT8U err;
+  INT8U n;
+  int i;
+
+  bench_start();
+  n = bench_spawn(MboxWriter, 1);
+  for (i = 0; i < PORT_SAMPLES && n > 0; i++) {
+    (void)OSMboxPend(Mbox, 0, &err);
+    BENCH_END(BENCH_SECTION_B);
+  }
+  bench_reap(n);
+  printf(" OSMboxPost -> OSMboxPend   %7lu cycles\n", bench_cycles(BENCH_SECTION_B));
+
+  bench_start();
+  n = bench_spawn(PortWriter, 1);
+  for (i = 0; i < PORT_SAMPLES && n > 0; i++) {
+    ver = OSPortPend(Port, &val, ver, 0, &err);
+    BENCH_END(BENCH_SECTION_B);
+  }
+  bench_reap(n);
+  printf(" OSPortWrite -> OSPortPend  %7lu cycles\n", bench_cycles(BENCH_SECTION_B));
+}
+
+void bench_port(void)
+{
+  INT8U err;
+
+  printf("\nLatest value of a signal (OS_PORT_EN %d)\n", OS_PORT_EN);
+
+  Mbox = OSMboxCreate((void *)0);
+  Port = OSPortCreate(sizeof(Value), (void *)0, OS_PORT_OPT_PEND, &err);
+  WidePort = OSPortCreate(OS_PORT_DATA_SIZE, (void *)0, OS_PORT_OPT_NONE, &err);
+  if (Mbox == (OS_EVENT *)0 || Port == (OS_PORT *)0 || WidePort == (OS_PORT *)0) {
+    printf(" ports not created\n");
+  } else {
+    sample();
+    latency();
+  }
+  OSPortDel(WidePort, &err);
+  OSPortDel(Port, &err);
+  OSMboxDel(Mbox, OS_DEL_ALWAYS, &err);
+}
+
+#else
+
+void bench_port(void)
+{
+  printf("\nLatest value of a signal: build with OS_PORT_EN 1\n");
+}
+
+#endif
@@ -0,0 +1,129 @@
+/* Bursts through a message queue: one message per call against batches
+ *
+ * BenchTask posts QMULTI_MSGS values in bursts to a helper at a lower
+ * priority, which takes them and posts DoneSem after each burst, like
+ * the throughput part of bench_ring.c. One message per call is
+ * OSQPost() and OSQPend() in a loop, a critical section and a scheduler
+ * call for each value. A batch is one OSQPostMulti() and as many
+ * OSQPendMulti() as it takes the helper to collect the burst, normally
+ * one, since the whole burst is queued before the helper runs.
+ */
+#include "os_bench.h"
+
+#if OS_Q_MULTI_EN > 0
+
+#define QMULTI_MSGS  1024
+#define QMULTI_SIZE  64
+
+#define QMULTI_ONE   0
+#define QMULTI_BATCH 1
+
+static OS_EVENT *Queue;
+static OS_EVENT *DoneSem;
+static void     *QueueTbl[QMULTI_SIZE];
+static void     *Msgs[QMULTI_SIZE];
+static int       Kind;
+static int       Burst;
+static INT32U    Sum;
+
+static void Consumer(void *pdata)
+{
+  void *out[QMULTI_SIZE];
+  INT8U err;
+  INT16U n;
+  INT16U k;
+  int got = 0;
+
+  while (1) {
+    if (Kind == QMULTI_ONE) {
+      out[0] = OSQPend(Queue, 0, &err);
+      n = 1;
+    } else {
+      n = OSQPendMulti(Queue, out, Burst - got, 0, &err);
+    }
+    for (k = 0; k < n; k++) {
+      Sum += (INT32U)out[k];
+    }
+    got += n;
+    if (got == Burst) {
+      got = 0;
+      OSSemPost(DoneSem);
+    }
+  }
+}
+
+/* Cycles per value */
+static alt_u32 stream(int kind, int burst)
+{
+  INT8U err;
+  INT8U n;
+  INT32U i;
+  int k;
+
+  Kind = kind;
+  Burst = burst;
+  Sum = 0;
+  n = bench_spawn(Consumer, 1);
+  if (n == 0) {
+    return 0;
+  }
+  bench_start();
+  BENCH_BEGIN(BENCH_SECTION_A);
+  for (i = 0; i < QMULTI_MSGS; i += burst) {
+    for (k = 0; k < burst; k++) {
+      Msgs[k] = (void *)(i + k);
+    }
+    if (kind == QMULTI_ONE) {
+      for (k = 0; k < burst; k++) {
+        OSQPost(Queue, Msgs[k]);
+      }
+    } else {
+      (void)OSQPostMulti(Queue, Msgs, burst, &err);
+    }
+    OSSemPend(DoneSem, 0, &err);
+  }
+  BENCH_END(BENCH_SECTION_A);
+  bench_reap(n);
+  if (Sum != (INT32U)QMULTI_MSGS * (QMULTI_MSGS - 1) / 2) {
+    printf(" burst of %d lost values\n", burst);
+  }
+  return bench_cycles(BENCH_SECTION_A) / QMULTI_MSGS;
+}
+
+void bench_qmulti(void)
+{
+  static const int bursts[] = { 1, 2, 4, 8, 16, 32, 64 };
+  alt_u32 one;
+  alt_u32 batch;
+  INT8U err;
+  int i;
+
+  printf("\nQueue bursts, %d values (OS_Q_MULTI_EN %d)\n", QMULTI_MSGS, OS_Q_MULTI_EN);
+  printf("         OSQPost/OSQPend    OSQPostMulti/PendMulti\n");
+  printf(" burst   cycles  msgs/s     cycles  msgs/s\n");
+
+  DoneSem = OSSemCreate(0);
+  Queue = OSQCreate(QueueTbl, QMULTI_SIZE);
+  if (Queue == (OS_EVENT *)0) {
+    printf(" queue not created\n");
+  } else {
+    for (i = 0; i < (int)(sizeof(bursts) / sizeof(bursts[0])); i++) {
+      one = stream(QMULTI_ONE, bursts[i]);
+      batch = stream(QMULTI_BATCH, bursts[i]);
+      printf(" %5d   %6lu %7lu     %6lu %7lu\n", bursts[i],
+             one, one ? ALT_CPU_FREQ / one : 0,
+             batch, batch ? ALT_CPU_FREQ / batch : 0);
+    }
+    OSQDel(Queue, OS_DEL_ALWAYS, &err);
+  }
+  OSSemDel(DoneSem, OS_DEL_ALWAYS, &err);
+}
+
+#else
+
+void bench_qmulti(void)
+{
+  printf("\nQueue bursts: build with OS_Q_MULTI_EN 1\n");
+}
+
+#endif
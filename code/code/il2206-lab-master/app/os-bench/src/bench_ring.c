@@ -0,0 +1,191 @@
+/* Streaming INT32U values: mailbox, message queue and ring channel
+ *
+ * Latency: BenchTask waits, a helper at a lower priority posts, like
+ * bench_notify.c. The time runs from just before the post to the return
+ * of the pend, context switch included.
+ *
+ * Throughput: BenchTask posts RING_MSGS values in bursts to a helper at
+ * a lower priority, which takes them and posts DoneSem after each burst.
+ * With bursts of 1, every value wakes the helper; with bursts of
+ * RING_BURST, it takes a whole burst per wake-up. A mailbox only holds
+ * one value, so it is only run with bursts of 1. The semaphore round
+ * trip per burst is the same for every channel.
+ */
+#include "os_bench.h"
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+
+#define RING_SAMPLES 100
+#define RING_MSGS    1024
+#define RING_BURST   8
+#define RING_SIZE    16
+
+#define RING_MBOX    0
+#define RING_Q       1
+#define RING_RING    2
+
+static const char *Names[] = { "OSMbox", "OSQ", "OSRing" };
+
+static OS_EVENT *Mbox;
+static OS_EVENT *Queue;
+static OS_RING  *Ring;
+static OS_EVENT *DoneSem;
+static void     *QueueTbl[RING_SIZE];
+static INT32U    RingTbl[RING_SIZE];
+static int       Kind;
+static int       Burst;
+static INT32U    Sum;
+
+static void post(INT32U val)
+{
+  switch (Kind) {
+  case RING_MBOX:
+    OSMboxPost(Mbox, (void *)val);
+    break;
+  case RING_Q:
+    OSQPost(Queue, (void *)val);
+    break;
+  default:
+    OSRingPost(Ring, &val);
+    break;
+  }
+}
+
+static INT32U pend(void)
+{
+  INT32U val = 0;
+  INT8U err;
+
+  switch (Kind) {
+  case RING_MBOX:
+    val = (INT32U)OSMboxPend(Mbox, 0, &err);
+    break;
+  case RING_Q:
+    val = (INT32U)OSQPend(Queue, 0, &err);
+    break;
+  default:
+    OSRingPend(Ring, &val, 0, &err);
+    break;
+  }
+  return val;
+}
+
+static void Producer(void *pdata)
+{
+  INT32U i;
+
+  for (i = 1; ; i++) {
+    BENCH_BEGIN(BENCH_SECTION_B);
+    post(i);
+  }
+}
+
+static void Consumer(void *pdata)
+{
+  int got = 0;
+
+  while (1) {
+    Sum += pend();
+    if (++got == Burst) {
+      got = 0;
+      OSSemPost(DoneSem);
+    }
+  }
+}
+
+static alt_u32 latency(int kind)
+{
+  INT8U n;
+  int i;
+
+  Kind = kind;
+  bench_start();
+  n = bench_spawn(Producer, 1);
+  for (i = 0; i < RING_SAMPLES && n > 0; i++) {
+    (void)pend();
+    BENCH_END(BENCH_SECTION_B);
+  }
+  bench_reap(n);
+  return bench_cycles(BENCH_SECTION_B);
+}
+
+/* Cycles per value */
+static alt_u32 stream(int kind, int burst)
+{
+  INT8U err;
+  INT8U n;
+  INT32U i;
+  int k;
+
+  Kind = kind;
+  Burst = burst;
+  Sum = 0;
+  n = bench_spawn(Consumer, 1);
+  if (n == 0) {
+    return 0;
+  }
+  bench_start();
+  BENCH_BEGIN(BENCH_SECTION_A);
+  for (i = 0; i < RING_MSGS; i += burst) {
+    for (k = 0; k < burst; k++) {
+      post(i + k);
+    }
+    OSSemPend(DoneSem, 0, &err);
+  }
+  BENCH_END(BENCH_SECTION_A);
+  bench_reap(n);
+  if (Sum != (INT32U)RING_MSGS * (RING_MSGS - 1) / 2) {
+    printf(" %-7s lost values\n", Names[kind]);
+  }
+  return bench_cycles(BENCH_SECTION_A) / RING_MSGS;
+}
+
+static void row(int kind)
+{
+  alt_u32 lat;
+  alt_u32 one;
+  alt_u32 many = 0;
+
+  lat = latency(kind);
+  one = stream(kind, 1);
+  if (kind != RING_MBOX) {
+    many = stream(kind, RING_BURST);
+  }
+  printf(" %-7s %6lu   %6lu %7lu   %6lu %7lu\n", Names[kind], lat,
+         one, one ? ALT_CPU_FREQ / one : 0,
+         many, many ? ALT_CPU_FREQ / many : 0);
+}
+
+void bench_ring(void)
+{
+  INT8U err;
+
+  printf("\nINT32U stream, %d values (OS_RING_EN %d)\n", RING_MSGS, OS_RING_EN);
+  printf("          post to    burst of 1       burst of %d\n", RING_BURST);
+  printf("          pend     cycles  msgs/s   cycles  msgs/s\n");
+
+  DoneSem = OSSemCreate(0);
+  Mbox = OSMboxCreate((void *)0);
+  Queue = OSQCreate(QueueTbl, RING_SIZE);
+  Ring = OSRingCreate(RingTbl, RING_SIZE, sizeof(INT32U), OS_RING_OPT_PEND, &err);
+  if (Mbox == (OS_EVENT *)0 || Queue == (OS_EVENT *)0 || Ring == (OS_RING *)0) {
+    printf(" channels not created\n");
+  } else {
+    row(RING_MBOX);
+    row(RING_Q);
+    row(RING_RING);
+  }
+  OSRingDel(Ring, &err);
+  OSQDel(Queue, OS_DEL_ALWAYS, &err);
+  OSMboxDel(Mbox, OS_DEL_ALWAYS, &err);
+  OSSemDel(DoneSem, OS_DEL_ALWAYS, &err);
+}
+
+#else
+
+void bench_ring(void)
+{
+  printf("\nINT32U stream: build with OS_RING_EN 1\n");
+}
+
+#endif
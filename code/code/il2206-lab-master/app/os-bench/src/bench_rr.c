@@ -0,0 +1,86 @@
+/* Round-robin time slicing
+ *
+ * RR_WORKERS helpers are created at the same priority and spin, each
+ * counting its own iterations, while BenchTask sleeps for RR_TICKS
+ * ticks. The printout gives the context switches added by slicing
+ * (OSRRCtxSwCtr), all context switches over the same period and the
+ * share of the CPU every worker got, which should be even.
+ *
+ * Needs OS_RR_EN 1 in os_cfg.h; otherwise only a note is printed.
+ */
+#include "os_bench.h"
+
+#define RR_WORKERS  4
+#define RR_TICKS  200
+
+#if OS_RR_EN > 0
+static volatile INT32U RRCount[RR_WORKERS];
+
+static void Worker(void *pdata)
+{
+  INT32U i = (INT32U)pdata;
+
+  while (1) {
+    RRCount[i]++;
+  }
+}
+#endif
+
+void bench_rr(void)
+{
+#if OS_RR_EN > 0
+  OS_CPU_SR cpu_sr;
+  INT32U rr_ctr;
+  INT32U ctx_ctr;
+  INT32U total;
+  INT8U err;
+  INT8U n;
+  INT8U i;
+
+  printf("\nRound-robin (OS_RR_QUANTA %d, %d workers, %d ticks)\n",
+         OS_RR_QUANTA, RR_WORKERS, RR_TICKS);
+
+  for (n = 0; n < RR_WORKERS && n < BENCH_MAX_HELPERS; n++) {
+    RRCount[n] = 0;
+    err = OSTaskCreateExt(Worker,
+                          (void *)(INT32U)n,
+                          &bench_stk[n][BENCH_STACKSIZE - 1],
+                          BENCH_HELPER_PRIO,          /* all at one priority */
+                          BENCH_HELPER_PRIO + n,
+                          &bench_stk[n][0],
+                          BENCH_STACKSIZE,
+                          (void *)0,
+                          OS_TASK_OPT_STK_CHK);
+    if (err != OS_NO_ERR) {
+      printf("bench: worker %d not created (%d)\n", n, err);
+      break;
+    }
+  }
+
+  cpu_sr  = alt_irq_disable_all();
+  rr_ctr  = OSRRCtxSwCtr;
+  ctx_ctr = OSCtxSwCtr;
+  alt_irq_enable_all(cpu_sr);
+  OSTimeDly(RR_TICKS);
+  cpu_sr  = alt_irq_disable_all();
+  rr_ctr  = OSRRCtxSwCtr - rr_ctr;
+  ctx_ctr = OSCtxSwCtr - ctx_ctr;
+  alt_irq_enable_all(cpu_sr);
+
+  for (i = 0; i < n; i++) {
+    OSTaskDel(BENCH_HELPER_PRIO);   /* removes the tasks at that priority one by one */
+  }
+
+  printf(" time slice switches  %5lu\n", rr_ctr);
+  printf(" all task switches    %5lu\n", ctx_ctr);
+  total = 0;
+  for (i = 0; i < n; i++) {
+    total += RRCount[i];
+  }
+  for (i = 0; i < n && total >= 100; i++) {
+    printf(" worker %d             %5lu %%\n", i, RRCount[i] / (total / 100));
+  }
+#else
+  printf("\nRound-robin: build the BSP with OS_RR_EN 1\n");
+#endif
+}
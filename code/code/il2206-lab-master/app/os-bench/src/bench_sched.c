@@ -0,0 +1,134 @@
+/* Cost of finding the highest priority task
+ *
+ * The first two figures go through the kernel as built: OSSchedUnlock()
+ * runs OS_SchedNew(), and an OSSemPost() to a lower priority waiter runs
+ * OS_EventTaskRdy() without switching tasks. Compare them between builds
+ * with OS_SCHED_BITMAP_EN 0 and 1.
+ *
+ * With OS_SCHED_BITMAP_EN 1 the two lookups are also timed side by side
+ * on the same 64-priority ready set: the original two OSUnMapTbl[] loads
+ * against two OS_BitScan() calls.
+ */
+#include "os_bench.h"
+
+#define SCHED_SAMPLES 100
+
+static OS_EVENT *SchedSem;
+
+static void Waiter(void *pdata)
+{
+  INT8U err;
+
+  while (1) {
+    OSSemPend(SchedSem, 0, &err);
+  }
+}
+
+#if OS_SCHED_BITMAP_EN > 0
+static INT8U  UnMapGrp;
+static INT8U  UnMapTbl[8];
+static INT8U  ScanGrp;
+static INT32U ScanTbl[2];
+
+/* OS_SchedNew() with OS_LOWEST_PRIO <= 63 and the original ready list */
+static INT8U __attribute__((noinline)) sched_unmap(void)
+{
+  INT8U y;
+
+  y = OSUnMapTbl[UnMapGrp];
+  return (INT8U)((y << 3) + OSUnMapTbl[UnMapTbl[y]]);
+}
+
+/* OS_SchedNew() with OS_SCHED_BITMAP_EN 1 and OS_LOWEST_PRIO <= 63 */
+static INT8U __attribute__((noinline)) sched_scan(void)
+{
+  INT8U y;
+
+  y = OS_BitScan(ScanGrp);
+  return (INT8U)((y << 5) + OS_BitScan(ScanTbl[y]));
+}
+
+static void bench_lookup(void)
+{
+  static const INT8U prios[] = {0, 7, 8, 31, 32, 63};
+  OS_CPU_SR cpu_sr;
+  unsigned int k;
+  alt_u32 unmap;
+  alt_u32 scan;
+  INT8U p;
+  int i;
+
+  printf(" highest  OSUnMapTbl  OS_BitScan\n");
+  for (k = 0; k < sizeof(prios); k++) {
+    p = prios[k];
+    UnMapGrp         = (INT8U)(1 << (p >> 3)) | 0x80;   /* idle task at 63 */
+    UnMapTbl[p >> 3] = (INT8U)(1 << (p & 7));
+    UnMapTbl[7]     |= 0x80;
+    ScanGrp          = (INT8U)(1 << (p >> 5)) | 0x02;
+    ScanTbl[p >> 5]  = (INT32U)1 << (p & 31);
+    ScanTbl[1]      |= 0x80000000uL;
+
+    bench_start();
+    for (i = 0; i < SCHED_SAMPLES; i++) {
+      cpu_sr = alt_irq_disable_all();
+      BENCH_BEGIN(BENCH_SECTION_A);
+      if (sched_unmap() != p) {
+        printf("bench: OSUnMapTbl lookup failed\n");
+      }
+      BENCH_END(BENCH_SECTION_A);
+      BENCH_BEGIN(BENCH_SECTION_B);
+      if (sched_scan() != p) {
+        printf("bench: OS_BitScan lookup failed\n");
+      }
+      BENCH_END(BENCH_SECTION_B);
+      alt_irq_enable_all(cpu_sr);
+    }
+    unmap = bench_cycles(BENCH_SECTION_A);
+    scan  = bench_cycles(BENCH_SECTION_B);
+    printf(" %7d  %10lu  %10lu\n", p, unmap, scan);
+
+    UnMapTbl[p >> 3] = 0;
+    ScanTbl[p >> 5]  = 0;
+  }
+}
+#endif
+
+void bench_sched(void)
+{
+  OS_CPU_SR cpu_sr;
+  INT8U err;
+  INT8U n;
+  int i;
+
+  printf("\nScheduler lookups (OS_SCHED_BITMAP_EN %d, OS_LOWEST_PRIO %d)\n",
+         OS_SCHED_BITMAP_EN, OS_LOWEST_PRIO);
+
+  bench_start();
+  for (i = 0; i < SCHED_SAMPLES; i++) {
+    cpu_sr = alt_irq_disable_all();
+    OSSchedLock();
+    BENCH_BEGIN(BENCH_SECTION_A);
+    OSSchedUnlock();
+    BENCH_END(BENCH_SECTION_A);
+    alt_irq_enable_all(cpu_sr);
+  }
+  printf(" OSSchedUnlock()         %5lu cycles\n", bench_cycles(BENCH_SECTION_A));
+
+  SchedSem = OSSemCreate(0);
+  n = bench_spawn(Waiter, 1);
+  OSTimeDly(1);                 /* let the waiter pend */
+  bench_start();
+  for (i = 0; i < SCHED_SAMPLES && n > 0; i++) {
+    BENCH_BEGIN(BENCH_SECTION_A);
+    OSSemPost(SchedSem);        /* readies the waiter, no task switch */
+    BENCH_END(BENCH_SECTION_A);
+    OSTimeDly(1);               /* the waiter pends again */
+  }
+  printf(" OSSemPost() to waiter   %5lu cycles\n", bench_cycles(BENCH_SECTION_A));
+  bench_reap(n);
+  OSSemDel(SchedSem, OS_DEL_ALWAYS, &err);
+
+#if OS_SCHED_BITMAP_EN > 0
+  bench_lookup();
+#endif
+}
@@ -0,0 +1,95 @@
+/* Preemption thresholds
+ *
+ * Three workers are released one tick apart, the lowest priority one
+ * first, the way the cruise control tasks are released by their timers
+ * around the same period boundary. Each needs about 1.5 ticks of work,
+ * so without thresholds every release preempts the worker released
+ * before it.
+ *
+ * The set runs twice: with no thresholds, then with every worker's
+ * threshold set to the priority of the highest one, so that they no
+ * longer preempt each other. BenchTask, above that threshold, still
+ * releases them on time. The printout gives the task switches and the
+ * cycles from the first release to the completion of the last worker,
+ * per period.
+ *
+ * The second run needs OS_PREEMPT_THRESH_EN 1 in os_cfg.h.
+ */
+#include "os_bench.h"
+
+#define THRESH_WORKERS  3
+#define THRESH_PERIODS 50
+
+static OS_EVENT *ThreshGo[THRESH_WORKERS];
+static OS_EVENT *ThreshDone;
+static INT32U    ThreshWork;
+
+static void Worker(void *pdata)
+{
+  INT32U i = (INT32U)pdata;
+  INT8U err;
+
+  while (1) {
+    OSSemPend(ThreshGo[i], 0, &err);
+    bench_spin(ThreshWork);
+    OSSemPost(ThreshDone);
+  }
+}
+
+static void thresh_run(const char *name)
+{
+  INT32U ctx_ctr;
+  INT8U err;
+  INT8U i;
+  int k;
+
+  ctx_ctr = OSCtxSwCtr;
+  bench_start();
+  for (k = 0; k < THRESH_PERIODS; k++) {
+    OSTimeDly(1);
+    BENCH_BEGIN(BENCH_SECTION_A);
+    for (i = THRESH_WORKERS; i > 0; i--) {   /* lowest priority first */
+      OSSemPost(ThreshGo[i - 1]);
+      if (i > 1) {
+        OSTimeDly(1);
+      }
+    }
+    for (i = 0; i < THRESH_WORKERS; i++) {
+      OSSemPend(ThreshDone, 0, &err);
+    }
+    BENCH_END(BENCH_SECTION_A);
+  }
+  printf(" %-16s %5lu switches/period  %8lu cycles/period\n", name,
+         (OSCtxSwCtr - ctx_ctr) / THRESH_PERIODS, bench_cycles(BENCH_SECTION_A));
+}
+
+void bench_thresh(void)
+{
+  INT8U err;
+  INT8U n;
+  INT8U i;
+
+  printf("\nPreemption thresholds (OS_PREEMPT_THRESH_EN %d, %d workers)\n",
+         OS_PREEMPT_THRESH_EN, THRESH_WORKERS);
+
+  ThreshWork = bench_spin_per_tick() * 3 / 2;
+  ThreshDone = OSSemCreate(0);
+  for (i = 0; i < THRESH_WORKERS; i++) {
+    ThreshGo[i] = OSSemCreate(0);
+  }
+  n = bench_spawn(Worker, THRESH_WORKERS);
+  if (n == THRESH_WORKERS) {
+    thresh_run("no threshold");
+#if OS_PREEMPT_THRESH_EN > 0
+    for (i = 0; i < n; i++) {
+      OSTaskThreshSet(BENCH_HELPER_PRIO + i, BENCH_HELPER_PRIO);
+    }
+    thresh_run("shared threshold");
+#endif
+  }
+  bench_reap(n);
+  for (i = 0; i < THRESH_WORKERS; i++) {
+    OSSemDel(ThreshGo[i], OS_DEL_ALWAYS, &err);
+  }
+  OSSemDel(ThreshDone, OS_DEL_ALWAYS, &err);
+}
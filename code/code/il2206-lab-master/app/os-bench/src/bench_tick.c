@@ -0,0 +1,52 @@
+/* OSTimeTick() cost against the number of delayed tasks
+ *
+ * Every helper delays itself far into the future, so the measured ticks
+ * only count delays down and never ready a task. With OS_TICK_LIST_EN 1
+ * the cost stays flat; with 0 (the original walk over OSTCBList) it grows
+ * with every task created.
+ */
+#include "os_bench.h"
+
+#define TICK_SAMPLES 100
+
+static void Sleeper(void *pdata)
+{
+  INT16U i = (INT16U)(INT32U)pdata;
+
+  while (1) {
+    OSTimeDly(60000 - 13 * i); /* distinct expiries, inserted out of order */
+  }
+}
+
+void bench_tick(void)
+{
+  static const INT8U counts[] = {2, 4, 8, 16, 32, 48, 60};
+  OS_CPU_SR cpu_sr;
+  unsigned int k;
+  INT8U n;
+  int i;
+
+  printf("\nOSTimeTick (OS_TICK_LIST_EN %d)\n", OS_TICK_LIST_EN);
+  printf(" tasks  cycles/tick\n");
+  for (k = 0; k < sizeof(counts); k++) {
+    if (counts[k] > BENCH_MAX_HELPERS) {
+      break;
+    }
+    n = bench_spawn(Sleeper, counts[k]);
+    OSTimeDly(2);               /* let every helper run and delay itself */
+
+    OSSchedLock();              /* OSTmrSignal() must not switch to OSTmr_Task */
+    bench_start();
+    for (i = 0; i < TICK_SAMPLES; i++) {
+      cpu_sr = alt_irq_disable_all();
+      BENCH_BEGIN(BENCH_SECTION_A);
+      OSTimeTick();
+      BENCH_END(BENCH_SECTION_A);
+      alt_irq_enable_all(cpu_sr);
+    }
+    printf(" %5d  %11lu\n", n, bench_cycles(BENCH_SECTION_A));
+    OSSchedUnlock();
+
+    bench_reap(n);
+  }
+}
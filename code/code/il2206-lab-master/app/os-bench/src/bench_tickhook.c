@@ -0,0 +1,42 @@
+/* Cost of the tick ISR path and of OSTimeTickHook() alone
+ *
+ * The system clock ISR calls alt_tick(), which calls OSTimeTick(), which
+ * calls OSTimeTickHook() to count down to the next OSTmrSignal(). Both
+ * are averaged over TICKHOOK_PERIODS timer periods, so that the signal
+ * made once per period is included at its share. With no task delayed
+ * and no alarm or timer running, what is left is the fixed cost of a
+ * tick. Build the BSP before and after a change of the tick path and
+ * compare the two printouts.
+ */
+#include "os_bench.h"
+
+#define TICKHOOK_PERIODS 4
+
+static alt_u32 measure(void (*tick)(void))
+{
+  OS_CPU_SR cpu_sr;
+  INT32U n;
+  INT32U i;
+
+  n = TICKHOOK_PERIODS * (INT32U)(OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC);
+  OSSchedLock();                /* OSTmrSignal() must not switch to OSTmr_Task */
+  bench_start();
+  for (i = 0; i < n; i++) {
+    cpu_sr = alt_irq_disable_all();
+    BENCH_BEGIN(BENCH_SECTION_A);
+    tick();
+    BENCH_END(BENCH_SECTION_A);
+    alt_irq_enable_all(cpu_sr);
+  }
+  OSSchedUnlock();
+  return bench_cycles(BENCH_SECTION_A);
+}
+
+void bench_tickhook(void)
+{
+  printf("\nTick path, averaged over %d timer periods of %lu ticks\n",
+         TICKHOOK_PERIODS,
+         (INT32U)(OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC));
+  printf(" OSTimeTickHook  %6lu cycles/tick\n", measure(OSTimeTickHook));
+  printf(" alt_tick        %6lu cycles/tick\n", measure(alt_tick));
+}
@@ -0,0 +1,59 @@
+/* OSTmr_Task() cost per timer tick against the number of running timers
+ *
+ * Every timer is started far into the future, so the measured ticks
+ * only move timers around the wheel and never call back. A sample is
+ * one OSTmrSignal() followed by the switch to the timer task and back;
+ * the line with no timer gives that fixed overhead.
+ *
+ * With OS_TMR_HWHEEL_EN 1 the cost stays flat, the cascades of the upper
+ * levels being spread over the samples. With 0 every tick walks the
+ * timers of one of the OS_TMR_CFG_WHEEL_SIZE spokes.
+ */
+#include "os_bench.h"
+
+#define TMR_SAMPLES 256
+
+static OS_TMR *Tmrs[OS_TMR_CFG_MAX];
+
+void bench_tmr(void)
+{
+  static const INT16U counts[] = {0, 1, 4, 16, 64, 128, 256};
+  unsigned int k;
+  alt_u32 sum;
+  INT16U n;
+  INT16U i;
+  INT8U err;
+
+  printf("\nOSTmr_Task per timer tick (OS_TMR_HWHEEL_EN %d)\n", OS_TMR_HWHEEL_EN);
+  printf(" timers  cycles/tick\n");
+  for (k = 0; k < sizeof(counts) / sizeof(counts[0]); k++) {
+    if (counts[k] > OS_TMR_CFG_MAX) {
+      break;
+    }
+    for (n = 0; n < counts[k]; n++) {
+      Tmrs[n] = OSTmrCreate(5000 + 37 * n, 0, OS_TMR_OPT_ONE_SHOT,
+                            (OS_TMR_CALLBACK)0, (void *)0, (INT8U *)"bench", &err);
+      if (Tmrs[n] == (OS_TMR *)0) {
+        break;
+      }
+      OSTmrStart(Tmrs[n], &err);
+    }
+
+    sum = 0;
+    for (i = 0; i < TMR_SAMPLES; i++) {
+      OSTimeDly(1);             /* stay clear of the signal from the tick hook */
+      bench_start();
+      OSSchedLock();
+      OSTmrSignal();
+      BENCH_BEGIN(BENCH_SECTION_A);
+      OSSchedUnlock();          /* OSTmr_Task runs here */
+      BENCH_END(BENCH_SECTION_A);
+      sum += bench_cycles(BENCH_SECTION_A);
+    }
+    printf(" %6d  %11lu\n", n, sum / TMR_SAMPLES);
+
+    for (i = 0; i < n; i++) {
+      OSTmrDel(Tmrs[i], &err);
+    }
+  }
+}
@@ -0,0 +1,87 @@
+/* Latency from a timer tick to the task released by a timer callback
+ *
+ * The tick ISR is emulated as in bench_defer.c and calls OSTmrSignal().
+ * The one-shot timer expiring on that tick posts a semaphore, and the
+ * time is taken until the task pending on it runs. BenchTask then pends
+ * itself, so the scheduler picks whatever the tick readied.
+ *
+ * A plain timer goes through OSTmr_Task(): one switch to the timer task,
+ * the callback, and a second switch to the waiter once it pends again.
+ * With OS_TMR_ISR_CALLBACK_EN 1 the line for OS_TMR_OPT_ISR_CALLBACK is
+ * added; its callback runs within OSTmrSignal() and the waiter is the
+ * first task to run.
+ */
+#include "os_bench.h"
+
+#define TMRCB_SAMPLES 100
+
+static OS_EVENT *TmrSem;
+static OS_EVENT *BackSem;
+
+static void Waiter(void *pdata)
+{
+  INT8U err;
+
+  while (1) {
+    OSSemPend(TmrSem, 0, &err);
+    BENCH_END(BENCH_SECTION_A);
+    OSSemPost(BackSem);
+  }
+}
+
+static void Callback(void *ptmr, void *parg)
+{
+  OSSemPost(TmrSem);
+}
+
+/* Average cycles from the tick to the waiter, for a timer created with 'opt' */
+static alt_u32 release(INT8U opt)
+{
+  OS_CPU_SR cpu_sr;
+  OS_TMR *tmr;
+  alt_u32 sum = 0;
+  INT8U err;
+  int i;
+
+  tmr = OSTmrCreate(1, 0, opt, Callback, (void *)0, (INT8U *)"bench", &err);
+  if (tmr == (OS_TMR *)0) {
+    return 0;
+  }
+  for (i = 0; i < TMRCB_SAMPLES; i++) {
+    OSTmrStart(tmr, &err);
+    OSTimeDly(1);               /* stay clear of the signal from the tick hook */
+    bench_start();
+    cpu_sr = alt_irq_disable_all();
+    OSIntNesting++;
+    BENCH_BEGIN(BENCH_SECTION_A);
+    OSTmrSignal();
+    OSIntNesting--;
+    alt_irq_enable_all(cpu_sr);
+    OSSemPend(BackSem, 0, &err);
+    sum += bench_cycles(BENCH_SECTION_A);
+  }
+  OSTmrDel(tmr, &err);
+  return sum / TMRCB_SAMPLES;
+}
+
+void bench_tmrcb(void)
+{
+  INT8U err;
+  INT8U n;
+
+  printf("\nTimer callback release (OS_TMR_ISR_CALLBACK_EN %d)\n", OS_TMR_ISR_CALLBACK_EN);
+
+  TmrSem  = OSSemCreate(0);
+  BackSem = OSSemCreate(0);
+  n = bench_spawn(Waiter, 1);
+  if (n > 0) {
+    printf(" OSTmr_Task() callback   %6lu cycles\n", release(OS_TMR_OPT_ONE_SHOT));
+#if OS_TMR_ISR_CALLBACK_EN > 0
+    printf(" OSTmrSignal() callback  %6lu cycles\n",
+           release(OS_TMR_OPT_ONE_SHOT | OS_TMR_OPT_ISR_CALLBACK));
+#endif
+  }
+  bench_reap(n);
+  OSSemDel(BackSem, OS_DEL_ALWAYS, &err);
+  OSSemDel(TmrSem, OS_DEL_ALWAYS, &err);
+}
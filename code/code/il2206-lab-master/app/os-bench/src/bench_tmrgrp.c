@@ -0,0 +1,145 @@
+/* Releasing TMRGRP_TASKS tasks: one timer each against one timer group
+ *
+ * TMRGRP_TASKS helpers pend on a semaphore each, the way the periodic
+ * tasks of lab2-cruise do. They are released from one timer tick,
+ * emulated as in bench_tmrcb.c, first by as many timers as tasks, then,
+ * with OS_TMR_GRP_EN 1, by a group holding one member per task. The time
+ * is taken until every helper has run and reported back. The timers are
+ * created with OS_TMR_OPT_ISR_CALLBACK when available, like in
+ * lab2-cruise.
+ */
+#include "os_bench.h"
+
+#define TMRGRP_TASKS   5
+#define TMRGRP_SAMPLES 50
+
+#if OS_TMR_ISR_CALLBACK_EN > 0
+#define TMRGRP_OPT OS_TMR_OPT_ISR_CALLBACK
+#else
+#define TMRGRP_OPT OS_TMR_OPT_NONE
+#endif
+
+static OS_EVENT *RelSem[TMRGRP_TASKS];
+static OS_EVENT *BackSem;
+
+static void Waiter(void *pdata)
+{
+  INT8U err;
+  INT32U i = (INT32U)pdata;
+
+  while (1) {
+    OSSemPend(RelSem[i], 0, &err);
+    OSSemPost(BackSem);
+  }
+}
+
+static void Callback(void *ptmr, void *parg)
+{
+  OSSemPost((OS_EVENT *)parg);
+}
+
+/* Emulated timer tick, then wait for every helper */
+static alt_u32 release(void)
+{
+  OS_CPU_SR cpu_sr;
+  INT8U err;
+  int i;
+
+  bench_start();
+  cpu_sr = alt_irq_disable_all();
+  OSIntNesting++;
+  BENCH_BEGIN(BENCH_SECTION_A);
+  OSTmrSignal();
+  OSIntNesting--;
+  alt_irq_enable_all(cpu_sr);
+  for (i = 0; i < TMRGRP_TASKS; i++) {
+    OSSemPend(BackSem, 0, &err);
+  }
+  BENCH_END(BENCH_SECTION_A);
+  return bench_cycles(BENCH_SECTION_A);
+}
+
+static alt_u32 timers(void)
+{
+  OS_TMR *tmr[TMRGRP_TASKS];
+  alt_u32 sum = 0;
+  INT8U err;
+  int i;
+  int k;
+
+  for (i = 0; i < TMRGRP_TASKS; i++) {
+    tmr[i] = OSTmrCreate(1, 1, OS_TMR_OPT_PERIODIC | TMRGRP_OPT, Callback,
+                         RelSem[i], (INT8U *)"bench", &err);
+    if (tmr[i] == (OS_TMR *)0) {
+      return 0;
+    }
+  }
+  for (k = 0; k < TMRGRP_SAMPLES; k++) {
+    OSTimeDly(1);               /* stay clear of the signal from the tick hook */
+    for (i = 0; i < TMRGRP_TASKS; i++) {
+      OSTmrStart(tmr[i], &err);
+    }
+    sum += release();
+    for (i = 0; i < TMRGRP_TASKS; i++) {
+      OSTmrStop(tmr[i], OS_TMR_OPT_NONE, (void *)0, &err);
+    }
+  }
+  for (i = 0; i < TMRGRP_TASKS; i++) {
+    OSTmrDel(tmr[i], &err);
+  }
+  return sum / TMRGRP_SAMPLES;
+}
+
+#if OS_TMR_GRP_EN > 0
+static alt_u32 group(void)
+{
+  OS_TMR_GRP *grp;
+  alt_u32 sum = 0;
+  INT8U err;
+  int i;
+  int k;
+
+  grp = OSTmrGrpCreate(1, TMRGRP_OPT, (INT8U *)"bench", &err);
+  if (grp == (OS_TMR_GRP *)0) {
+    return 0;
+  }
+  for (i = 0; i < TMRGRP_TASKS; i++) {
+    OSTmrGrpAdd(grp, 0, (OS_TMR_CALLBACK)0, RelSem[i], &err);
+  }
+  for (k = 0; k < TMRGRP_SAMPLES; k++) {
+    OSTimeDly(1);
+    OSTmrGrpStart(grp, &err);
+    sum += release();
+    OSTmrGrpStop(grp, &err);
+  }
+  OSTmrGrpDel(grp, &err);
+  return sum / TMRGRP_SAMPLES;
+}
+#endif
+
+void bench_tmrgrp(void)
+{
+  INT8U err;
+  INT8U n;
+  int i;
+
+  printf("\nRelease of %d tasks from one timer tick (OS_TMR_GRP_EN %d)\n",
+         TMRGRP_TASKS, OS_TMR_GRP_EN);
+
+  for (i = 0; i < TMRGRP_TASKS; i++) {
+    RelSem[i] = OSSemCreate(0);
+  }
+  BackSem = OSSemCreate(0);
+  n = bench_spawn(Waiter, TMRGRP_TASKS);
+  if (n == TMRGRP_TASKS) {
+    printf(" %d timers          %6lu cycles\n", TMRGRP_TASKS, timers());
+#if OS_TMR_GRP_EN > 0
+    printf(" 1 group            %6lu cycles\n", group());
+#endif
+  }
+  bench_reap(n);
+  OSSemDel(BackSem, OS_DEL_ALWAYS, &err);
+  for (i = 0; i < TMRGRP_TASKS; i++) {
+    OSSemDel(RelSem[i], OS_DEL_ALWAYS, &err);
+  }
+}
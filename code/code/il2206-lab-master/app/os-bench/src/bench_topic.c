@@ -0,0 +1,130 @@
+/* Fan-out of one value to TOPIC_SUBS subscribers: mailboxes against a topic
+ *
+ * Each of TOPIC_SUBS subscribers either waits, in a helper at a lower
+ * priority, or is idle and never reads. BenchTask times the producer side
+ * only: one OSMboxPost() per subscriber, which is what the producer of
+ * lab2-cruise did for every consumer of the engine state, against one
+ * OSTopicPublish(). The idle mailboxes are emptied between samples, as a
+ * polling reader would, so that every post does its full work. Between
+ * samples BenchTask sleeps one tick so that the helpers take the value
+ * and wait again.
+ */
+#include "os_bench.h"
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+
+#define TOPIC_SUBS    8
+#define TOPIC_SAMPLES 50
+#define TOPIC_DEPTH   4
+
+static OS_EVENT     *Mbox[TOPIC_SUBS];
+static OS_TOPIC     *Topic;
+static OS_TOPIC_SUB  Subs[TOPIC_SUBS];
+static INT32U        TopicTbl[TOPIC_DEPTH];
+static INT32U        Value;
+
+static void MboxReader(void *pdata)
+{
+  INT8U err;
+  INT32U i = (INT32U)pdata;
+
+  while (1) {
+    (void)OSMboxPend(Mbox[i], 0, &err);
+  }
+}
+
+static void TopicReader(void *pdata)
+{
+  INT32U val;
+  INT8U err;
+  INT32U i = (INT32U)pdata;
+
+  while (1) {
+    OSTopicPend(&Subs[i], &val, 0, &err);
+  }
+}
+
+static alt_u32 mbox(int waiting)
+{
+  INT8U n;
+  int i;
+  int k;
+
+  n = bench_spawn(MboxReader, waiting);
+  bench_start();
+  for (k = 0; k < TOPIC_SAMPLES; k++) {
+    OSTimeDly(1);
+    for (i = waiting; i < TOPIC_SUBS; i++) {
+      (void)OSMboxAccept(Mbox[i]);
+    }
+    Value++;
+    BENCH_BEGIN(BENCH_SECTION_A);
+    for (i = 0; i < TOPIC_SUBS; i++) {
+      OSMboxPost(Mbox[i], &Value);
+    }
+    BENCH_END(BENCH_SECTION_A);
+  }
+  bench_reap(n);
+  return bench_cycles(BENCH_SECTION_A);
+}
+
+static alt_u32 topic(int waiting)
+{
+  INT8U n;
+  int k;
+
+  n = bench_spawn(TopicReader, waiting);
+  bench_start();
+  for (k = 0; k < TOPIC_SAMPLES; k++) {
+    OSTimeDly(1);
+    Value++;
+    BENCH_BEGIN(BENCH_SECTION_A);
+    OSTopicPublish(Topic, &Value);
+    BENCH_END(BENCH_SECTION_A);
+  }
+  bench_reap(n);
+  return bench_cycles(BENCH_SECTION_A);
+}
+
+void bench_topic(void)
+{
+  static const int waiting[] = { 0, 1, 2, 4, 8 };
+  INT8U err;
+  int i;
+
+  printf("\nPublishing to %d subscribers (OS_TOPIC_EN %d)\n", TOPIC_SUBS, OS_TOPIC_EN);
+  printf(" waiting   %d x OSMboxPost   OSTopicPublish\n", TOPIC_SUBS);
+
+  for (i = 0; i < TOPIC_SUBS; i++) {
+    Mbox[i] = OSMboxCreate((void *)0);
+  }
+  Topic = OSTopicCreate(TopicTbl, TOPIC_DEPTH, sizeof(INT32U), &err);
+  if (Topic == (OS_TOPIC *)0) {
+    printf(" topic not created\n");
+  } else {
+    for (i = 0; i < TOPIC_SUBS; i++) {
+      OSTopicSubscribe(Topic, &Subs[i], &err);
+    }
+    for (i = 0; i < (int)(sizeof(waiting) / sizeof(waiting[0])); i++) {
+      if (waiting[i] <= BENCH_MAX_HELPERS) {
+        printf(" %7d   %13lu   %14lu\n", waiting[i], mbox(waiting[i]), topic(waiting[i]));
+      }
+    }
+    for (i = 0; i < TOPIC_SUBS; i++) {
+      OSTopicUnsubscribe(&Subs[i], &err);
+    }
+    OSTopicDel(Topic, &err);
+  }
+  for (i = 0; i < TOPIC_SUBS; i++) {
+    OSMboxDel(Mbox[i], OS_DEL_ALWAYS, &err);
+  }
+}
+
+#else
+
+void bench_topic(void)
+{
+  printf("\nPublishing to subscribers: build with OS_TOPIC_EN 1\n");
+}
+
+#endif
@@ -0,0 +1,135 @@
+/* Waiting on WSET_MAX semaphores: OSEventPendMulti() against a wait-set
+ *
+ * BenchTask waits on n semaphores, of which only the last one is posted.
+ *
+ * Ready: BenchTask posts the semaphore itself, then pends; no task
+ * switch, only the cost of looking through the events.
+ *
+ * Post to pend: a helper at a lower priority posts, like bench_notify.c.
+ * OSEventPendMulti() links BenchTask into the wait list of every event
+ * and unlinks it on wake-up; the wait-set has its events registered once.
+ */
+#include "os_bench.h"
+
+#if (OS_WAITSET_EN > 0) && (OS_MAX_WAITSETS > 0)
+
+#define WSET_MAX     16
+#define WSET_SAMPLES 100
+
+#define WSET_MULTI   0
+#define WSET_SET     1
+
+static OS_EVENT   *Sems[WSET_MAX + 1];             /* NULL terminated for OSEventPendMulti() */
+static OS_EVENT   *RdyEvents[WSET_MAX + 1];
+static void       *RdyMsgs[WSET_MAX + 1];
+static OS_WAITSET *Set;
+static int         Count;
+static int         Kind;
+
+static void pend(void)
+{
+  INT8U err;
+
+#if OS_EVENT_MULTI_EN > 0
+  if (Kind == WSET_MULTI) {
+    (void)OSEventPendMulti(Sems + WSET_MAX - Count, RdyEvents, RdyMsgs, 0, &err);
+    return;
+  }
+#endif
+  (void)OSWaitSetPend(Set, RdyEvents, RdyMsgs, WSET_MAX, 0, &err);
+}
+
+static void Poster(void *pdata)
+{
+  while (1) {
+    BENCH_BEGIN(BENCH_SECTION_B);
+    OSSemPost(Sems[WSET_MAX - 1]);
+  }
+}
+
+/* Members are the last 'n' semaphores of Sems[] */
+static void measure(int kind, int n, alt_u32 *ready, alt_u32 *latency)
+{
+  INT8U err;
+  INT8U h;
+  int i;
+
+  Kind = kind;
+  Count = n;
+  if (kind == WSET_SET) {
+    for (i = WSET_MAX - n; i < WSET_MAX; i++) {
+      OSWaitSetAdd(Set, Sems[i], &err);
+    }
+  }
+
+  bench_start();
+  for (i = 0; i < WSET_SAMPLES; i++) {
+    OSSemPost(Sems[WSET_MAX - 1]);
+    BENCH_BEGIN(BENCH_SECTION_A);
+    pend();
+    BENCH_END(BENCH_SECTION_A);
+  }
+  *ready = bench_cycles(BENCH_SECTION_A);
+
+  bench_start();
+  h = bench_spawn(Poster, 1);
+  for (i = 0; i < WSET_SAMPLES && h > 0; i++) {
+    pend();
+    BENCH_END(BENCH_SECTION_B);
+  }
+  bench_reap(h);
+  *latency = bench_cycles(BENCH_SECTION_B);
+
+  if (kind == WSET_SET) {
+    for (i = WSET_MAX - n; i < WSET_MAX; i++) {
+      OSWaitSetRemove(Set, Sems[i], &err);
+    }
+  }
+}
+
+void bench_waitset(void)
+{
+  static const int counts[] = { 1, 4, 8, 16 };
+  alt_u32 multi_rdy = 0;
+  alt_u32 multi_lat = 0;
+  alt_u32 set_rdy;
+  alt_u32 set_lat;
+  INT8U err;
+  int i;
+
+  printf("\nWaiting on n semaphores (OS_EVENT_MULTI_EN %d, OS_WAITSET_EN %d)\n",
+         OS_EVENT_MULTI_EN, OS_WAITSET_EN);
+  printf("       OSEventPendMulti   OSWaitSetPend\n");
+  printf("  n    ready  post->pend  ready  post->pend\n");
+
+  for (i = 0; i < WSET_MAX; i++) {
+    Sems[i] = OSSemCreate(0);
+  }
+  Sems[WSET_MAX] = (OS_EVENT *)0;
+  Set = OSWaitSetCreate(&err);
+  if (Set == (OS_WAITSET *)0) {
+    printf(" wait-set not created\n");
+  } else {
+    for (i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) {
+#if OS_EVENT_MULTI_EN > 0
+      measure(WSET_MULTI, counts[i], &multi_rdy, &multi_lat);
+#endif
+      measure(WSET_SET, counts[i], &set_rdy, &set_lat);
+      printf(" %2d   %6lu  %10lu %6lu  %10lu\n", counts[i],
+             multi_rdy, multi_lat, set_rdy, set_lat);
+    }
+    OSWaitSetDel(Set, &err);
+  }
+  for (i = 0; i < WSET_MAX; i++) {
+    OSSemDel(Sems[i], OS_DEL_ALWAYS, &err);
+  }
+}
+
+#else
+
+void bench_waitset(void)
+{
+  printf("\nWaiting on n semaphores: build with OS_WAITSET_EN 1\n");
+}
+
+#endif
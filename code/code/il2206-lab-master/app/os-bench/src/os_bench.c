@@ -0,0 +1,156 @@
+/* Kernel micro-benchmarks for the IL 2206 uC/OS-II BSP
+ *
+ * Description:
+ *
+ *   BenchTask runs the benchmarks listed in 'benches' one after the
+ *   other and prints the results on the JTAG UART. Most of them compare
+ *   a kernel option against the original uC/OS-II code path; build
+ *   once per setting of the option, e.g. './run.sh OS_EDF_EN=1', and
+ *   compare the two printouts. Results are in CPU cycles of the 50 MHz
+ *   Nios II core.
+ */
+#include "os_bench.h"
+
+OS_STK BenchTask_Stack[BENCH_STACKSIZE];
+OS_STK bench_stk[BENCH_MAX_HELPERS][BENCH_STACKSIZE];
+
+static void (* const benches[])(void) = {
+  bench_tick,
+  bench_sched,
+  bench_rr,
+  bench_edf,
+  bench_thresh,
+  bench_notify,
+  bench_ring,
+  bench_port,
+  bench_topic,
+  bench_waitset,
+  bench_qmulti,
+  bench_defer,
+  bench_tmr,
+  bench_tmrcb,
+  bench_tmrgrp,
+  bench_periodic,
+  bench_dlyuntil,
+  bench_hrtimer,
+  bench_alarm,
+  bench_tickhook,
+};
+
+/*
+ * Create 'n' helper tasks running 'task'; helper i gets priority
+ * BENCH_HELPER_PRIO + i and receives i as its argument. Returns the
+ * number of helpers actually created.
+ */
+INT8U bench_spawn(void (*task)(void *), INT8U n)
+{
+  INT8U i;
+  INT8U err;
+
+  if (n > BENCH_MAX_HELPERS) {
+    n = BENCH_MAX_HELPERS;
+  }
+  for (i = 0; i < n; i++) {
+    err = OSTaskCreateExt(task,
+                          (void *)(INT32U)i,
+                          &bench_stk[i][BENCH_STACKSIZE - 1],
+                          BENCH_HELPER_PRIO + i,
+                          BENCH_HELPER_PRIO + i,
+                          &bench_stk[i][0],
+                          BENCH_STACKSIZE,
+                          (void *)0,
+                          OS_TASK_OPT_STK_CHK);
+    if (err != OS_NO_ERR) {
+      printf("bench: helper %d not created (%d)\n", i, err);
+      break;
+    }
+  }
+  return i;
+}
+
+/* Delete the helpers created by bench_spawn() */
+void bench_reap(INT8U n)
+{
+  INT8U i;
+
+  for (i = 0; i < n; i++) {
+    OSTaskDel(BENCH_HELPER_PRIO + i);
+  }
+}
+
+/* Clear all sections and start the global counter */
+void bench_start(void)
+{
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+}
+
+/* Average number of cycles spent per BENCH_BEGIN/BENCH_END pair */
+alt_u32 bench_cycles(int section)
+{
+  alt_u32 starts;
+
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  starts = perf_get_num_starts((void *)PERFORMANCE_COUNTER_BASE, section);
+  if (starts == 0) {
+    return 0;
+  }
+  return (alt_u32)(perf_get_section_time((void *)PERFORMANCE_COUNTER_BASE, section) / starts);
+}
+
+/* Busy loop of 'n' iterations, the unit of work of the load tasks */
+void bench_spin(INT32U n)
+{
+  volatile INT32U i;
+
+  for (i = 0; i < n; i++) {
+  }
+}
+
+/* bench_spin() iterations per tick, measured while nothing else runs */
+INT32U bench_spin_per_tick(void)
+{
+  INT32U chunks;
+  INT32U t;
+
+  OSTimeDly(1);
+  t = OSTimeGet();
+  for (chunks = 0; OSTimeGet() < t + 10; chunks++) {
+    bench_spin(100);
+  }
+  return chunks * 100 / 10;
+}
+
+void BenchTask(void *pdata)
+{
+  unsigned int i;
+
+  printf("uC/OS-II V%d kernel benchmarks, %d helper tasks max\n",
+         OSVersion(), BENCH_MAX_HELPERS);
+#ifdef ALT_IRQ_TRACE
+  alt_irq_trace_start();
+#endif
+  for (i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+    benches[i]();
+  }
+#ifdef ALT_IRQ_TRACE
+  alt_irq_trace_dump();         /* worst interrupt latency of the whole run */
+#endif
+  printf("done\n");
+  OSTaskSuspend(OS_PRIO_SELF);
+}
+
+int main(void)
+{
+  OSTaskCreateExt(BenchTask,
+                  (void *)0,
+                  &BenchTask_Stack[BENCH_STACKSIZE - 1],
+                  BENCH_TASK_PRIO,
+                  BENCH_TASK_PRIO,
+                  &BenchTask_Stack[0],
+                  BENCH_STACKSIZE,
+                  (void *)0,
+                  OS_TASK_OPT_STK_CHK);
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,72 @@
+/* Kernel micro-benchmarks for the IL 2206 uC/OS-II BSP
+ *
+ * Shared harness for the bench_*.c files. Every benchmark runs from the
+ * single BenchTask, times the code under test with the performance
+ * counter and prints one line per data point on the JTAG UART.
+ *
+ * Helper tasks are created at consecutive priorities starting at
+ * BENCH_HELPER_PRIO, always below BenchTask, so BenchTask keeps the CPU
+ * until it blocks on purpose.
+ */
+#ifndef OS_BENCH_H
+#define OS_BENCH_H
+
+#include <stdio.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+#include "sys/alt_irq.h"
+
+#define BENCH_TASK_PRIO     4
+#define BENCH_HELPER_PRIO   5
+#define BENCH_STACKSIZE   512
+
+/* Timer task and BenchTask use two of the OS_MAX_TASKS user TCBs, the
+ * statistic and idle task sit at the two lowest priorities. */
+#define BENCH_TCB_LIMIT   (OS_MAX_TASKS - 2)
+#define BENCH_PRIO_LIMIT  (OS_LOWEST_PRIO - 1 - BENCH_HELPER_PRIO)
+#if BENCH_TCB_LIMIT < BENCH_PRIO_LIMIT
+#define BENCH_MAX_HELPERS BENCH_TCB_LIMIT
+#else
+#define BENCH_MAX_HELPERS BENCH_PRIO_LIMIT
+#endif
+
+/* Performance counter sections, section 0 is the global counter */
+#define BENCH_SECTION_A     1
+#define BENCH_SECTION_B     2
+
+#define BENCH_BEGIN(section) PERF_BEGIN(PERFORMANCE_COUNTER_BASE, (section))
+#define BENCH_END(section)   PERF_END(PERFORMANCE_COUNTER_BASE, (section))
+
+/* Helper stacks, for benchmarks that create their helpers themselves */
+extern OS_STK bench_stk[BENCH_MAX_HELPERS][BENCH_STACKSIZE];
+
+INT8U   bench_spawn(void (*task)(void *), INT8U n);
+void    bench_reap(INT8U n);
+void    bench_start(void);
+alt_u32 bench_cycles(int section);
+void    bench_spin(INT32U n);
+INT32U  bench_spin_per_tick(void);
+
+void bench_tick(void);
+void bench_sched(void);
+void bench_rr(void);
+void bench_edf(void);
+void bench_thresh(void);
+void bench_notify(void);
+void bench_ring(void);
+void bench_port(void);
+void bench_topic(void);
+void bench_waitset(void);
+void bench_qmulti(void);
+void bench_defer(void);
+void bench_tmr(void);
+void bench_tmrcb(void);
+void bench_tmrgrp(void);
+void bench_periodic(void);
+void bench_dlyuntil(void);
+void bench_hrtimer(void);
+void bench_alarm(void);
+void bench_tickhook(void);
+
+#endif